@@ -0,0 +1,512 @@
+// ECS and transform microbenchmarks.
+// Prints a stable JSON document on stdout (progress goes to stderr) so runs can be diffed against a baseline.
+//
+// Usage: lwlaim_bench [--threads N] [--max-entities N]
+
+#include <entities/ecs.h>
+#include <entities/ecs_commands.h>
+#include <entities/transform.h>
+#include <jobs/thread.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+#define BENCH_MAX_THREADS 64
+#define BENCH_MIN_REPS 3
+#define BENCH_MAX_REPS 25
+#define BENCH_OPS_PER_SIZE 4000000 // Target amount of work per (benchmark, size, threads) point
+
+typedef struct { float x, y, z; } Position;
+typedef struct { float x, y, z; } Velocity;
+
+static size_t POSITION, VELOCITY;
+
+// ----------------------------------------------------------------------------
+// Hardware counters (cache misses), per thread so pool workers are included
+// ----------------------------------------------------------------------------
+
+static bool perf_available = false;
+
+#ifdef __linux__
+static _Thread_local int perf_fd = -2;
+
+static int perf_thread_fd() {
+    if (perf_fd == -2) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        perf_fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+    return perf_fd;
+}
+
+static uint64_t perf_read() {
+    int fd = perf_thread_fd();
+    uint64_t value = 0;
+    if (fd < 0 || read(fd, &value, sizeof(value)) != sizeof(value)) return 0;
+    return value;
+}
+
+static void perf_probe() { perf_available = perf_thread_fd() >= 0; }
+#else
+static uint64_t perf_read() { return 0; }
+static void perf_probe() { perf_available = false; }
+#endif
+
+// ----------------------------------------------------------------------------
+// Persistent worker pool: every worker runs the same task with its own index
+// ----------------------------------------------------------------------------
+
+typedef void (*BenchTask)(void* ctx, uint32_t index, uint32_t count);
+
+typedef struct {
+    Thread threads[BENCH_MAX_THREADS];
+    uint32_t thread_count;     // Workers besides the main thread
+
+    Mutex mutex;
+    CondVar wake;
+    CondVar done;
+    uint64_t generation;
+    uint32_t pending;
+    bool quit;
+
+    BenchTask task;
+    void* ctx;
+    uint32_t task_count;       // Participants in the current task (main thread included)
+    uint64_t misses[BENCH_MAX_THREADS + 1];
+} BenchPool;
+
+static BenchPool pool;
+
+typedef struct { uint32_t index; } WorkerArgs;
+static WorkerArgs worker_args[BENCH_MAX_THREADS];
+
+static void run_task_slot(uint32_t index) {
+    uint64_t before = perf_read();
+    pool.task(pool.ctx, index, pool.task_count);
+    pool.misses[index] = perf_read() - before;
+}
+
+static void worker_main(void* arg) {
+    uint32_t index = ((WorkerArgs*)arg)->index;
+    uint64_t seen = 0;
+
+    mutex_lock(&pool.mutex);
+    for (;;) {
+        while (!pool.quit && pool.generation == seen) cond_wait(&pool.wake, &pool.mutex);
+        if (pool.quit) break;
+        seen = pool.generation;
+
+        bool participates = index < pool.task_count;
+        mutex_unlock(&pool.mutex);
+        if (participates) run_task_slot(index);
+        mutex_lock(&pool.mutex);
+
+        if (--pool.pending == 0) cond_signal(&pool.done);
+    }
+    mutex_unlock(&pool.mutex);
+}
+
+static void pool_init(uint32_t workers) {
+    memset(&pool, 0, sizeof(pool));
+    mutex_init(&pool.mutex);
+    cond_init(&pool.wake);
+    cond_init(&pool.done);
+
+    for (uint32_t i = 0; i < workers; i++) {
+        worker_args[i].index = i + 1; // Slot 0 is the main thread
+        if (!thread_create(&pool.threads[i], worker_main, &worker_args[i])) break;
+        pool.thread_count++;
+    }
+}
+
+static void pool_shutdown() {
+    mutex_lock(&pool.mutex);
+    pool.quit = true;
+    cond_broadcast(&pool.wake);
+    mutex_unlock(&pool.mutex);
+
+    for (uint32_t i = 0; i < pool.thread_count; i++) thread_join(pool.threads[i]);
+    cond_destroy(&pool.wake);
+    cond_destroy(&pool.done);
+    mutex_destroy(&pool.mutex);
+}
+
+// Run `task` on `count` participants (main thread + count-1 workers) and return the summed cache misses
+static uint64_t pool_run(BenchTask task, void* ctx, uint32_t count) {
+    pool.task = task;
+    pool.ctx = ctx;
+    pool.task_count = count;
+
+    if (count > 1) {
+        mutex_lock(&pool.mutex);
+        pool.pending = pool.thread_count;
+        pool.generation++;
+        cond_broadcast(&pool.wake);
+        mutex_unlock(&pool.mutex);
+    }
+
+    run_task_slot(0);
+
+    if (count > 1) {
+        mutex_lock(&pool.mutex);
+        while (pool.pending) cond_wait(&pool.done, &pool.mutex);
+        mutex_unlock(&pool.mutex);
+    }
+
+    uint64_t misses = 0;
+    for (uint32_t i = 0; i < count; i++) misses += pool.misses[i];
+    return misses;
+}
+
+static void split_range(size_t total, uint32_t index, uint32_t count, size_t* begin, size_t* end) {
+    *begin = total * index / count;
+    *end = total * (index + 1) / count;
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark bodies
+// ----------------------------------------------------------------------------
+
+typedef struct {
+    ECS ecs;
+    EcsCommandQueue queue;
+    size_t entities;
+    TransformSystem transforms[BENCH_MAX_THREADS];
+    TransformId* roots[BENCH_MAX_THREADS];
+    uint32_t root_counts[BENCH_MAX_THREADS];
+    float frame;
+} BenchState;
+
+static void setup_ecs(BenchState* state, bool with_entities, bool with_position, bool with_velocity) {
+    ecs_init(&state->ecs);
+    POSITION = ecs_register_component(&state->ecs, sizeof(Position));
+    VELOCITY = ecs_register_component(&state->ecs, sizeof(Velocity));
+    if (!with_entities) return;
+
+    for (size_t i = 0; i < state->entities; i++) {
+        Entity entity = ecs_create_entity(&state->ecs);
+        if (with_position) {
+            Position* position = ecs_add_component(&state->ecs, entity, POSITION);
+            position->x = (float)i;
+        }
+        // Every other entity moves, so the multi-component query has to filter
+        if (with_velocity && (i & 1)) {
+            Velocity* velocity = ecs_add_component(&state->ecs, entity, VELOCITY);
+            velocity->x = 1.0f;
+        }
+    }
+}
+
+static void task_create(void* ctx, uint32_t index, uint32_t count) {
+    (void)index;
+    (void)count;
+    BenchState* state = ctx;
+    for (size_t i = 0; i < state->entities; i++) ecs_create_entity(&state->ecs);
+}
+
+static void task_add(void* ctx, uint32_t index, uint32_t count) {
+    (void)index;
+    (void)count;
+    BenchState* state = ctx;
+    for (size_t i = 0; i < state->entities; i++) ecs_add_component(&state->ecs, (Entity)i, POSITION);
+}
+
+static void task_remove(void* ctx, uint32_t index, uint32_t count) {
+    (void)index;
+    (void)count;
+    BenchState* state = ctx;
+    for (size_t i = 0; i < state->entities; i++) ecs_remove_component(&state->ecs, (Entity)i, POSITION);
+}
+
+static void task_create_deferred(void* ctx, uint32_t index, uint32_t count) {
+    BenchState* state = ctx;
+    size_t begin, end;
+    split_range(state->entities, index, count, &begin, &end);
+
+    EcsCommandBuffer* buffer = ecs_commands_buffer(&state->queue, index);
+    for (size_t i = begin; i < end; i++) ecs_cmd_create(buffer);
+}
+
+static void task_add_deferred(void* ctx, uint32_t index, uint32_t count) {
+    BenchState* state = ctx;
+    size_t begin, end;
+    split_range(state->entities, index, count, &begin, &end);
+
+    EcsCommandBuffer* buffer = ecs_commands_buffer(&state->queue, index);
+    Position position = { 1.0f, 2.0f, 3.0f };
+    for (size_t i = begin; i < end; i++) ecs_cmd_add(buffer, (Entity)i, POSITION, &position, sizeof(position));
+}
+
+static void task_remove_deferred(void* ctx, uint32_t index, uint32_t count) {
+    BenchState* state = ctx;
+    size_t begin, end;
+    split_range(state->entities, index, count, &begin, &end);
+
+    EcsCommandBuffer* buffer = ecs_commands_buffer(&state->queue, index);
+    for (size_t i = begin; i < end; i++) ecs_cmd_remove(buffer, (Entity)i, POSITION);
+}
+
+static void visit_single(Entity entity, void* ctx) {
+    BenchState* state = ctx;
+    Position* position = ecs_get_component(&state->ecs, entity, POSITION);
+    position->y += 1.0f;
+}
+
+static void visit_multi(Entity entity, void* ctx) {
+    BenchState* state = ctx;
+    Position* position = ecs_get_component(&state->ecs, entity, POSITION);
+    const Velocity* velocity = ecs_get_component(&state->ecs, entity, VELOCITY);
+    position->x += velocity->x;
+    position->y += velocity->y;
+    position->z += velocity->z;
+}
+
+static void task_iterate_single(void* ctx, uint32_t index, uint32_t count) {
+    BenchState* state = ctx;
+    size_t begin, end;
+    split_range(state->ecs.entity_count, index, count, &begin, &end);
+    ecs_for_each_mask_range(&state->ecs, ECS_COMPONENT_BIT(POSITION), begin, end, visit_single, state);
+}
+
+static void task_iterate_multi(void* ctx, uint32_t index, uint32_t count) {
+    BenchState* state = ctx;
+    size_t begin, end;
+    split_range(state->ecs.entity_count, index, count, &begin, &end);
+    ecs_for_each_mask_range(&state->ecs, ECS_COMPONENT_BIT(POSITION) | ECS_COMPONENT_BIT(VELOCITY), begin, end, visit_multi, state);
+}
+
+// Each participant owns one partition of the scene: groups of 64 nodes, each a 4-ary tree under a root
+static void setup_transforms(BenchState* state, uint32_t partitions) {
+    for (uint32_t p = 0; p < partitions; p++) {
+        size_t begin, end;
+        split_range(state->entities, p, partitions, &begin, &end);
+
+        TransformSystem* system = &state->transforms[p];
+        transform_system_init(system, (uint32_t)(end - begin));
+        state->roots[p] = malloc(sizeof(TransformId) * ((end - begin) / 64 + 1));
+        state->root_counts[p] = 0;
+
+        TransformId group[64];
+        for (size_t i = begin; i < end; i++) {
+            size_t local = (i - begin) % 64;
+            TransformId parent = local == 0 ? TRANSFORM_NONE : group[(local - 1) / 4];
+            group[local] = transform_create(system, parent);
+            transform_set_position(system, group[local], (vec3){ 1.0f, (float)local, 0.0f });
+
+            if (local == 0) state->roots[p][state->root_counts[p]++] = group[local];
+        }
+        transform_system_update(system);
+    }
+}
+
+static void free_transforms(BenchState* state, uint32_t partitions) {
+    for (uint32_t p = 0; p < partitions; p++) {
+        transform_system_free(&state->transforms[p]);
+        free(state->roots[p]);
+    }
+}
+
+static void task_transform_dirty(void* ctx, uint32_t index, uint32_t count) {
+    (void)count;
+    BenchState* state = ctx;
+    TransformSystem* system = &state->transforms[index];
+
+    // Move every root so the whole partition has to be rebuilt
+    for (uint32_t r = 0; r < state->root_counts[index]; r++) {
+        transform_set_position(system, state->roots[index][r], (vec3){ state->frame, 0.0f, 0.0f });
+    }
+    transform_system_update(system);
+}
+
+static void task_transform_static(void* ctx, uint32_t index, uint32_t count) {
+    (void)count;
+    BenchState* state = ctx;
+    transform_system_update(&state->transforms[index]);
+}
+
+// ----------------------------------------------------------------------------
+// Measurement
+// ----------------------------------------------------------------------------
+
+typedef enum {
+    BENCH_ENTITY_CREATE,
+    BENCH_ENTITY_CREATE_DEFERRED,
+    BENCH_COMPONENT_ADD,
+    BENCH_COMPONENT_ADD_DEFERRED,
+    BENCH_COMPONENT_REMOVE,
+    BENCH_COMPONENT_REMOVE_DEFERRED,
+    BENCH_ITERATE_SINGLE,
+    BENCH_ITERATE_MULTI,
+    BENCH_TRANSFORM_PROPAGATE,
+    BENCH_TRANSFORM_STATIC,
+    BENCH_COUNT
+} BenchKind;
+
+static const char* bench_names[BENCH_COUNT] = {
+    "entity_create",
+    "entity_create_deferred",
+    "component_add",
+    "component_add_deferred",
+    "component_remove",
+    "component_remove_deferred",
+    "iterate_single",
+    "iterate_multi",
+    "transform_propagate",
+    "transform_static",
+};
+
+// Direct structural changes are not thread-safe, they only run single-threaded
+static bool bench_supports_threads(BenchKind kind) {
+    return kind != BENCH_ENTITY_CREATE && kind != BENCH_COMPONENT_ADD && kind != BENCH_COMPONENT_REMOVE;
+}
+
+typedef struct {
+    double ns_per_op;
+    uint64_t cache_misses;
+    size_t ops;
+} BenchResult;
+
+static int compare_doubles(const void* a, const void* b) {
+    double lhs = *(const double*)a, rhs = *(const double*)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static BenchResult run_bench(BenchKind kind, size_t entities, uint32_t threads) {
+    static BenchState state;
+    double samples[BENCH_MAX_REPS];
+    uint64_t miss_samples[BENCH_MAX_REPS];
+    size_t reps = BENCH_OPS_PER_SIZE / entities;
+    if (reps < BENCH_MIN_REPS) reps = BENCH_MIN_REPS;
+    if (reps > BENCH_MAX_REPS) reps = BENCH_MAX_REPS;
+
+    state.entities = entities;
+    bool transforms = kind == BENCH_TRANSFORM_PROPAGATE || kind == BENCH_TRANSFORM_STATIC;
+    if (transforms) setup_transforms(&state, threads);
+
+    for (size_t rep = 0; rep < reps; rep++) {
+        BenchTask task = NULL;
+        bool deferred = false;
+
+        // Per-rep setup is excluded from the timing
+        switch (kind) {
+            case BENCH_ENTITY_CREATE:             setup_ecs(&state, false, false, false); task = task_create; break;
+            case BENCH_ENTITY_CREATE_DEFERRED:    setup_ecs(&state, false, false, false); task = task_create_deferred; deferred = true; break;
+            case BENCH_COMPONENT_ADD:             setup_ecs(&state, true, false, false); task = task_add; break;
+            case BENCH_COMPONENT_ADD_DEFERRED:    setup_ecs(&state, true, false, false); task = task_add_deferred; deferred = true; break;
+            case BENCH_COMPONENT_REMOVE:          setup_ecs(&state, true, true, false); task = task_remove; break;
+            case BENCH_COMPONENT_REMOVE_DEFERRED: setup_ecs(&state, true, true, false); task = task_remove_deferred; deferred = true; break;
+            case BENCH_ITERATE_SINGLE:            if (rep == 0) setup_ecs(&state, true, true, false); task = task_iterate_single; break;
+            case BENCH_ITERATE_MULTI:             if (rep == 0) setup_ecs(&state, true, true, true); task = task_iterate_multi; break;
+            case BENCH_TRANSFORM_PROPAGATE:       task = task_transform_dirty; state.frame = (float)rep; break;
+            case BENCH_TRANSFORM_STATIC:          task = task_transform_static; break;
+            default: break;
+        }
+        if (deferred) ecs_commands_init(&state.queue, threads);
+
+        uint64_t start = clock_now_ns();
+        uint64_t misses = pool_run(task, &state, threads);
+        if (deferred) {
+            // The sync point is part of the cost
+            uint64_t before = perf_read();
+            ecs_commands_playback(&state.queue, &state.ecs);
+            misses += perf_read() - before;
+        }
+        uint64_t elapsed = clock_now_ns() - start;
+
+        samples[rep] = (double)elapsed / (double)entities;
+        miss_samples[rep] = misses;
+
+        if (deferred) ecs_commands_free(&state.queue);
+        bool keep_ecs = (kind == BENCH_ITERATE_SINGLE || kind == BENCH_ITERATE_MULTI) && rep + 1 < reps;
+        if (!transforms && !keep_ecs) ecs_free(&state.ecs);
+    }
+
+    if (transforms) free_transforms(&state, threads);
+
+    // Median of the samples, cache misses averaged per rep
+    qsort(samples, reps, sizeof(double), compare_doubles);
+    uint64_t miss_total = 0;
+    for (size_t rep = 0; rep < reps; rep++) miss_total += miss_samples[rep];
+
+    BenchResult result;
+    result.ns_per_op = samples[reps / 2];
+    result.cache_misses = miss_total / reps;
+    result.ops = entities;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    uint32_t threads = thread_hardware_concurrency();
+    size_t max_entities = 1000000;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--max-entities") == 0 && i + 1 < argc) {
+            max_entities = (size_t)strtoull(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "Usage: %s [--threads N] [--max-entities N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (threads < 1) threads = 1;
+    if (threads > BENCH_MAX_THREADS) threads = BENCH_MAX_THREADS;
+
+    perf_probe();
+    pool_init(threads - 1);
+    threads = pool.thread_count + 1;
+
+    static const size_t sizes[] = { 1000, 10000, 100000, 1000000 };
+    uint32_t thread_counts[2] = { 1, threads };
+    uint32_t thread_variants = threads > 1 ? 2 : 1;
+
+    printf("{\n");
+    printf("  \"schema\": 1,\n");
+    printf("  \"suite\": \"lwlaim-ecs-transform\",\n");
+    printf("  \"hardware_threads\": %u,\n", thread_hardware_concurrency());
+    printf("  \"threads\": %u,\n", threads);
+    printf("  \"perf_counters\": %s,\n", perf_available ? "true" : "false");
+    printf("  \"results\": [");
+
+    bool first = true;
+    for (int kind = 0; kind < BENCH_COUNT; kind++) {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            if (sizes[s] > max_entities) continue;
+
+            for (uint32_t t = 0; t < thread_variants; t++) {
+                uint32_t thread_count = thread_counts[t];
+                if (thread_count > 1 && !bench_supports_threads((BenchKind)kind)) continue;
+
+                fprintf(stderr, "[BENCH] %s entities=%zu threads=%u\n", bench_names[kind], sizes[s], thread_count);
+                BenchResult result = run_bench((BenchKind)kind, sizes[s], thread_count);
+
+                printf("%s\n    {\"benchmark\": \"%s\", \"entities\": %zu, \"threads\": %u, \"ops\": %zu, \"ns_per_op\": %.3f, \"cache_misses\": ",
+                       first ? "" : ",", bench_names[kind], sizes[s], thread_count, result.ops, result.ns_per_op);
+                if (perf_available) {
+                    printf("%llu}", (unsigned long long)result.cache_misses);
+                } else {
+                    printf("null}");
+                }
+                first = false;
+            }
+        }
+    }
+
+    printf("\n  ]\n}\n");
+
+    pool_shutdown();
+    return 0;
+}
@@ -0,0 +1,131 @@
+// Software mixer benchmarks, needs no audio device so it runs on headless CI machines.
+// Prints a stable JSON document on stdout (progress goes to stderr) so runs can be diffed against a baseline:
+// mixing throughput per voice count (null output, offline) and trigger-to-output latency at a steady trigger
+// rate (null output paced like a device, audio thread running).
+//
+// Usage: lwlaim_mixer_bench [--rate HZ] [--seconds N] [--wav path]   (--wav also renders a short mix to a file)
+
+#include <output/mixer.h>
+#include <jobs/thread.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define BENCH_CLIP_SECONDS 4
+#define BENCH_THROUGHPUT_BLOCKS 20000
+#define BENCH_TRIGGER_INTERVAL_MS 1 // About 1000 triggers per second
+
+// Decaying noise burst, roughly what a hit sound looks like to the mixer
+static int16_t* make_clip(uint32_t rate, size_t* frames) {
+    *frames = (size_t)rate * BENCH_CLIP_SECONDS;
+    int16_t* samples = malloc(*frames * sizeof(int16_t));
+    if (!samples) return NULL;
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < *frames; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        float envelope = expf(-(float)i / (float)rate * 2.0f);
+        samples[i] = (int16_t)((int32_t)(seed >> 16) - 32768) / 2 * envelope;
+    }
+    return samples;
+}
+
+static double run_throughput(uint32_t rate, const int16_t* samples, size_t frames, uint32_t voice_count) {
+    mixer_render_begin(mixer_output_null(false), rate);
+    MixerClip clip = mixer_clip_add(samples, frames, rate);
+
+    // Voices restart as they end so the count stays constant
+    uint32_t blocks_per_clip = (uint32_t)(frames / MIXER_BLOCK_FRAMES);
+    for (uint32_t v = 0; v < voice_count; v++) mixer_play(clip, 0.5f, (float)v / voice_count * 2.0f - 1.0f, 1.0f);
+
+    uint64_t start = clock_now_ns();
+    for (uint32_t done = 0; done < BENCH_THROUGHPUT_BLOCKS; done += blocks_per_clip) {
+        uint32_t count = BENCH_THROUGHPUT_BLOCKS - done < blocks_per_clip ? BENCH_THROUGHPUT_BLOCKS - done : blocks_per_clip;
+        mixer_render(count);
+        for (uint32_t v = 0; v < voice_count; v++) mixer_play(clip, 0.5f, 0.0f, 1.0f);
+    }
+    uint64_t elapsed = clock_now_ns() - start;
+
+    mixer_render_end();
+    return (double)elapsed / BENCH_THROUGHPUT_BLOCKS;
+}
+
+int main(int argc, char** argv) {
+    uint32_t rate = 48000;
+    uint32_t seconds = 2;
+    const char* wav_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            rate = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--wav") == 0 && i + 1 < argc) {
+            wav_path = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--rate HZ] [--seconds N] [--wav path]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (rate < 8000) rate = 8000;
+    if (seconds < 1) seconds = 1;
+
+    size_t frames;
+    int16_t* samples = make_clip(rate, &frames);
+    if (!samples) return 1;
+
+    double block_ns = (double)MIXER_BLOCK_FRAMES * 1e9 / rate;
+    static const uint32_t voice_counts[] = { 1, 8, 32, MIXER_MAX_VOICES };
+    enum { VOICE_VARIANTS = sizeof(voice_counts) / sizeof(voice_counts[0]) };
+    double throughput[VOICE_VARIANTS];
+    for (size_t i = 0; i < VOICE_VARIANTS; i++) {
+        fprintf(stderr, "[BENCH] mixer throughput voices=%u\n", voice_counts[i]);
+        throughput[i] = run_throughput(rate, samples, frames, voice_counts[i]);
+    }
+
+    // Steady triggers of a short clip against a device-paced sink, as the game would drive it
+    fprintf(stderr, "[BENCH] mixer latency, %u s\n", seconds);
+    MixerStats stats = { 0 };
+    if (mixer_start(mixer_output_null(true), rate)) {
+        MixerClip clip = mixer_clip_add(samples, rate / 50, rate);
+        uint64_t end = clock_now_ns() + (uint64_t)seconds * 1000000000ull;
+        while (clock_now_ns() < end) {
+            mixer_play(clip, 0.5f, 0.0f, 1.0f);
+            thread_sleep_ms(BENCH_TRIGGER_INTERVAL_MS);
+        }
+        thread_sleep_ms(50); // Let the last triggers reach the output
+        mixer_get_stats(&stats);
+        mixer_stop();
+    }
+
+    if (wav_path && mixer_render_begin(mixer_output_wav(wav_path), rate)) {
+        MixerClip clip = mixer_clip_add(samples, frames, rate);
+        for (int i = 0; i < 8; i++) {
+            mixer_play(clip, 0.8f, i / 3.5f - 1.0f, 1.0f);
+            mixer_render(rate / 4 / MIXER_BLOCK_FRAMES);
+        }
+        mixer_render_end();
+        fprintf(stderr, "[BENCH] wrote %s\n", wav_path);
+    }
+
+    printf("{\n");
+    printf("  \"schema\": 1,\n");
+    printf("  \"suite\": \"lwlaim-mixer\",\n");
+    printf("  \"sample_rate\": %u,\n", rate);
+    printf("  \"block_frames\": %d,\n", MIXER_BLOCK_FRAMES);
+    printf("  \"throughput\": [");
+    for (size_t i = 0; i < VOICE_VARIANTS; i++) {
+        printf("%s\n    {\"voices\": %u, \"ns_per_block\": %.1f, \"realtime_factor\": %.1f}",
+               i ? "," : "", voice_counts[i], throughput[i], block_ns / throughput[i]);
+    }
+    printf("\n  ],\n");
+    printf("  \"latency\": {\"triggers\": %llu, \"dropped\": %llu, \"voices_peak\": %u, \"mean_us\": %.1f, \"max_us\": %.1f, \"mix_load\": %.4f}",
+           (unsigned long long)stats.triggers, (unsigned long long)stats.dropped, stats.voices_peak,
+           stats.triggers ? (double)stats.latency_ns_total / stats.triggers / 1000.0 : 0.0,
+           (double)stats.latency_ns_max / 1000.0,
+           stats.blocks ? (double)stats.mix_ns / ((double)stats.blocks * block_ns) : 0.0);
+    printf("\n}\n");
+    free(samples);
+    return 0;
+}
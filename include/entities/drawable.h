@@ -13,6 +13,7 @@ typedef struct {
     Buffers buffers;
     Mesh *mesh;
     const char *name;  // Name of the mesh
+    GLenum index_type; // GL_UNSIGNED_INT, or GL_UNSIGNED_SHORT for baked meshes with 16-bit indices
 } DrawableMesh;
 
 typedef struct {
@@ -22,6 +23,7 @@ typedef struct {
     vec3 translation;
     vec3 scale;
     vec3 rotation;
+    bool model_dirty;  // Model matrix needs recomposing (set by translate/scale/rotate)
 } Drawable;
 
 // Initializes a drawable object from a mesh
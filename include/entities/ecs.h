@@ -6,8 +6,14 @@
 #include <stdbool.h>
 
 // Max limits
-#define MAX_ENTITIES 1000
-#define MAX_COMPONENTS 32
+#define MAX_ENTITIES 0x7FFFFFFFu   // Top bit is reserved for provisional (deferred) entities
+#define MAX_COMPONENTS 32          // One bit per component in the entity mask
+
+// Initial entity storage, grown on demand
+#define ECS_INITIAL_CAPACITY 1024
+
+// Component mask helper
+#define ECS_COMPONENT_BIT(component_id) (1u << (component_id))
 
 // Entity type (just an ID)
 typedef uint32_t Entity;
@@ -22,27 +28,40 @@ typedef struct {
 
 // ECS Manager
 typedef struct {
-    Entity entities[MAX_ENTITIES];
+    Entity* entities;           // entities[i] == i while alive, UINT32_MAX once destroyed
+    uint32_t* component_masks;  // One ECS_COMPONENT_BIT per attached component
     size_t entity_count;
+    size_t entity_capacity;
+
+    Entity* free_entities;      // Destroyed IDs, reused by ecs_create_entity
+    size_t free_count;
 
     ComponentArray components[MAX_COMPONENTS];
-    bool entity_component_mask[MAX_ENTITIES][MAX_COMPONENTS];
 } ECS;
 
-// Initialize ECS
+// Initialize / free ECS
 void ecs_init(ECS* ecs);
+void ecs_free(ECS* ecs);
 
 // Entity management
 Entity ecs_create_entity(ECS* ecs);
 void ecs_destroy_entity(ECS* ecs, Entity entity);
+bool ecs_is_alive(const ECS* ecs, Entity entity);
 
 // Component management
 size_t ecs_register_component(ECS* ecs, size_t component_size);
 void* ecs_add_component(ECS* ecs, Entity entity, size_t component_id);
 void* ecs_get_component(ECS* ecs, Entity entity, size_t component_id);
 void ecs_remove_component(ECS* ecs, Entity entity, size_t component_id);
+bool ecs_has_component(const ECS* ecs, Entity entity, size_t component_id);
 
 // System management
 void ecs_for_each(ECS* ecs, size_t component_id, void (*callback)(Entity, void*));
+void ecs_for_each_ctx(ECS* ecs, size_t component_id, void (*callback)(Entity, void*, void*), void* ctx);
+
+// Visit every entity owning all components in `mask`, optionally restricted to [begin, end)
+// so disjoint ranges can be processed by different threads
+void ecs_for_each_mask(ECS* ecs, uint32_t mask, void (*callback)(Entity, void*), void* ctx);
+void ecs_for_each_mask_range(ECS* ecs, uint32_t mask, size_t begin, size_t end, void (*callback)(Entity, void*), void* ctx);
 
 #endif // ECS_H
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef ECS_COMMANDS_H
+#define ECS_COMMANDS_H
+
+#include <entities/ecs.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Entities created through a command buffer get a provisional ID until playback:
+// [31] provisional bit | [30..20] buffer index | [19..0] index within the buffer
+#define ECS_PROVISIONAL_BIT      0x80000000u
+#define ECS_PROVISIONAL_BUFFERS  2048
+#define ECS_PROVISIONAL_PER_SYNC (1u << 20)
+
+#define ecs_is_provisional(entity) (((entity) & ECS_PROVISIONAL_BIT) != 0)
+
+typedef enum {
+    ECS_CMD_CREATE,
+    ECS_CMD_DESTROY,
+    ECS_CMD_ADD,
+    ECS_CMD_REMOVE
+} EcsCommandType;
+
+// A single recorded structural change
+typedef struct {
+    uint8_t type;            // EcsCommandType
+    uint8_t component_id;    // For ECS_CMD_ADD / ECS_CMD_REMOVE
+    Entity entity;           // Real or provisional entity
+    uint32_t payload_offset; // Offset of the initial component data (ECS_CMD_ADD)
+    uint32_t payload_size;   // Size of the initial component data, 0 means zero-initialized
+} EcsCommand;
+
+// Command buffer owned by a single thread, recording needs no locks
+typedef struct {
+    EcsCommand* commands;
+    size_t count;
+    size_t capacity;
+
+    unsigned char* payload;  // Arena for initial component data
+    size_t payload_size;
+    size_t payload_capacity;
+
+    uint32_t index;          // Buffer index, encoded into provisional IDs
+    uint32_t created;        // Provisional entities recorded since the last playback
+    Entity* resolved;        // Provisional index -> real entity after the last playback
+    size_t resolved_count;
+    size_t resolved_capacity;
+} EcsCommandBuffer;
+
+// One command buffer per thread, played back together at a sync point
+typedef struct {
+    EcsCommandBuffer* buffers;
+    size_t buffer_count;
+
+    void* scratch;           // Sort scratch reused across playbacks
+    size_t scratch_capacity;
+} EcsCommandQueue;
+
+// Queue lifecycle
+bool ecs_commands_init(EcsCommandQueue* queue, size_t thread_count);
+void ecs_commands_free(EcsCommandQueue* queue);
+
+// Get the buffer a thread records into
+EcsCommandBuffer* ecs_commands_buffer(EcsCommandQueue* queue, size_t thread_index);
+
+// Recording (safe during ecs_for_each and from parallel systems, one buffer per thread)
+Entity ecs_cmd_create(EcsCommandBuffer* buffer);
+void ecs_cmd_destroy(EcsCommandBuffer* buffer, Entity entity);
+void ecs_cmd_add(EcsCommandBuffer* buffer, Entity entity, size_t component_id, const void* data, size_t size);
+void ecs_cmd_remove(EcsCommandBuffer* buffer, Entity entity, size_t component_id);
+
+// Apply every recorded command in one sorted, coalesced pass and reset the buffers.
+// Must run on a single thread while no system is iterating. Returns the number of applied changes.
+size_t ecs_commands_playback(EcsCommandQueue* queue, ECS* ecs);
+
+// Map a provisional entity to the real entity created by the last playback (UINT32_MAX if none)
+Entity ecs_commands_resolve(const EcsCommandQueue* queue, Entity provisional);
+
+#endif // ECS_COMMANDS_H
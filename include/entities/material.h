@@ -4,8 +4,11 @@
 #include <glad/glad.h>
 #include <cglm/cglm.h>
 #include <cgltf.h>
+#include <stdint.h>
 
 typedef struct {
+    uint32_t id;                    // Unique per material (never 0), equal ids bind the same state
+
     GLuint diffuse_texture_id;      // Diffuse (base color) texture
     GLuint normal_texture_id;       // Normal map
     GLuint metallic_roughness_texture_id; // Metallic-roughness texture
@@ -33,6 +36,7 @@ typedef enum {
 } MaterialTextureType;
 
 GLuint load_texture_from_gltf(cgltf_texture *gltf_texture, const char* model_path);
+GLuint load_texture_from_uri(const char* uri, const char* model_path); // URI relative to the model's directory
 
 int material_create_gl_texture(cgltf_texture* texture, MaterialTextureType type, GLuint* texture_id_dest, const char* model_path);
 
@@ -41,7 +45,10 @@ int material_create_gl_texture(cgltf_texture* texture, MaterialTextureType type,
 // Function to apply the material (binds its textures) to a shader program
 void material_apply(const Material* material, GLuint shader_program_id);
 
-// Function to free material resources, including GPU textures
+// Next material id, materials are created on the GL thread only
+uint32_t material_next_id();
+
+// Function to free material resources (textures are released, the last user deletes them)
 void material_free(Material* material);
 
 #endif // MATERIAL_H
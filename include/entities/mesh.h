@@ -2,9 +2,11 @@
 #define MESH_H
 
 #include <entities/material.h>
+#include <entities/transform.h>
 #include <cglm/cglm.h>
 #include <stdint.h>
 
+#define MESH_NO_MATERIAL 0xFFFFFFFFu
 
 typedef struct {
     char *name;              // Name of the mesh
@@ -22,8 +24,15 @@ typedef struct {
     versor rotation;           // Rotation of the mesh in Euler angles (x, y, z)
 
     mat4 transform_matrix;   // Combined transformation matrix (Position, Rotation, Scale)
+    TransformId transform;   // Node in the owning model's transform hierarchy (TRANSFORM_NONE if unbound)
 
-	Material *material;
+    // Baked meshes only (see mesh_baked.h): GPU-ready data inside the owning model's mapped file, the CPU arrays stay NULL
+    const void *vertex_data; // Interleaved MeshBakedVertex
+    const void *index_data;
+    uint32_t index_size;     // Bytes per index (2 or 4)
+
+	Material *material;      // Shared entry of the owning model's material table (not owned by the mesh)
+	uint32_t material_index; // Index into that table, MESH_NO_MATERIAL if the mesh has none
 } Mesh;
 
 Mesh *mesh_create(const char *name); // Constructor with name initialization
@@ -0,0 +1,119 @@
+#ifndef MESH_BAKED_H
+#define MESH_BAKED_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Baked model container (.lmesh), written offline by tools/meshbake.c from a glTF file and mapped at runtime.
+// Layout: MeshBakedHeader, mesh_count MeshBakedMesh, material_count MeshBakedMaterial, then the vertex block,
+// the index block and the string table, each section starting on a MESH_BAKED_ALIGNMENT boundary.
+// Vertices are interleaved MeshBakedVertex, indices 16-bit when the mesh allows it, so both blocks go to
+// glBufferStorage straight from the mapping. All fields are little-endian.
+
+#define MESH_BAKED_MAGIC 0x48534D4Cu // "LMSH"
+#define MESH_BAKED_VERSION 1
+#define MESH_BAKED_EXTENSION ".lmesh"
+#define MESH_BAKED_ALIGNMENT 16
+
+#define MESH_BAKED_HAS_NORMALS   0x1
+#define MESH_BAKED_HAS_TEXCOORDS 0x2
+#define MESH_BAKED_HAS_NODE      0x4 // translation/rotation/scale hold the node transform (engine axes)
+
+#define MESH_BAKED_NO_MATERIAL 0xFFFFFFFFu
+
+typedef struct {
+    float position[3];
+    float normal[3];
+    float texcoord[2];
+} MeshBakedVertex;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t mesh_count;
+    uint32_t material_count;
+    uint64_t vertex_offset;   // Vertex block, from the start of the file
+    uint64_t vertex_size;
+    uint64_t index_offset;    // Index block
+    uint64_t index_size;
+    uint64_t string_offset;   // Null-terminated strings, offset 0 is the empty string
+    uint64_t string_size;
+} MeshBakedHeader;
+
+typedef struct {
+    uint32_t name;            // String offset
+    uint32_t material;        // Material index or MESH_BAKED_NO_MATERIAL
+    uint32_t vertex_count;
+    uint32_t index_count;
+    uint32_t index_size;      // 2 or 4 bytes, 0 when the mesh is not indexed
+    uint32_t flags;
+    uint64_t vertex_offset;   // From the start of the vertex block
+    uint64_t index_offset;    // From the start of the index block
+    float min_bound[3];
+    float max_bound[3];
+    float translation[3];
+    float rotation[4];        // x, y, z, w
+    float scale[3];
+} MeshBakedMesh;
+
+typedef struct {
+    uint32_t diffuse_texture;             // String offsets of the texture URIs (relative to the model), 0 if unused
+    uint32_t normal_texture;
+    uint32_t occlusion_texture;
+    uint32_t emissive_texture;
+    float emissive_color[3];
+} MeshBakedMaterial;
+
+static inline const MeshBakedMesh* mesh_baked_meshes(const MeshBakedHeader* header) {
+    return (const MeshBakedMesh*)(header + 1);
+}
+
+static inline const MeshBakedMaterial* mesh_baked_materials(const MeshBakedHeader* header) {
+    return (const MeshBakedMaterial*)(mesh_baked_meshes(header) + header->mesh_count);
+}
+
+static inline const char* mesh_baked_string(const MeshBakedHeader* header, uint32_t offset) {
+    return (const char*)header + header->string_offset + offset;
+}
+
+static inline bool mesh_baked_range(uint64_t offset, uint64_t size, uint64_t limit) {
+    return offset <= limit && size <= limit - offset;
+}
+
+// Check a mapped container before anything reads it, returns NULL if it is truncated or not a container
+static inline const MeshBakedHeader* mesh_baked_validate(const unsigned char* data, size_t size) {
+    const MeshBakedHeader* header = (const MeshBakedHeader*)data;
+    if (!data || size < sizeof(MeshBakedHeader)) return NULL;
+    if (header->magic != MESH_BAKED_MAGIC || header->version != MESH_BAKED_VERSION) return NULL;
+
+    uint64_t tables = sizeof(MeshBakedHeader) + (uint64_t)header->mesh_count * sizeof(MeshBakedMesh) +
+                      (uint64_t)header->material_count * sizeof(MeshBakedMaterial);
+    if (tables > size || !mesh_baked_range(header->vertex_offset, header->vertex_size, size) ||
+        !mesh_baked_range(header->index_offset, header->index_size, size) ||
+        !mesh_baked_range(header->string_offset, header->string_size, size) || header->string_size == 0 ||
+        data[header->string_offset + header->string_size - 1] != '\0') {
+        return NULL;
+    }
+
+    const MeshBakedMesh* meshes = mesh_baked_meshes(header);
+    for (uint32_t i = 0; i < header->mesh_count; i++) {
+        const MeshBakedMesh* mesh = &meshes[i];
+        if (mesh->name >= header->string_size) return NULL;
+        if (mesh->material != MESH_BAKED_NO_MATERIAL && mesh->material >= header->material_count) return NULL;
+        if (mesh->index_size != 0 && mesh->index_size != 2 && mesh->index_size != 4) return NULL;
+        if (!mesh_baked_range(mesh->vertex_offset, (uint64_t)mesh->vertex_count * sizeof(MeshBakedVertex), header->vertex_size)) return NULL;
+        if (!mesh_baked_range(mesh->index_offset, (uint64_t)mesh->index_count * mesh->index_size, header->index_size)) return NULL;
+    }
+
+    const MeshBakedMaterial* materials = mesh_baked_materials(header);
+    for (uint32_t i = 0; i < header->material_count; i++) {
+        if (materials[i].diffuse_texture >= header->string_size || materials[i].normal_texture >= header->string_size ||
+            materials[i].occlusion_texture >= header->string_size || materials[i].emissive_texture >= header->string_size) {
+            return NULL;
+        }
+    }
+    return header;
+}
+
+#endif // MESH_BAKED_H
@@ -3,6 +3,8 @@
 
 #include <entities/mesh.h>
 #include <entities/material.h>
+#include <entities/transform.h>
+#include <io/vfs.h>
 #include <stdint.h>
 #include <cglm/cglm.h>
 
@@ -10,18 +12,75 @@
 typedef struct {
     Mesh **meshes;            // Array of meshes
     uint32_t mesh_count;      // Number of meshes
-    Material **materials;     // Array of materials for each mesh
-    uint32_t material_count;  // Number of materials
+    Material **materials;     // Material table, one entry per source material (NULL until a mesh uses it)
+    uint32_t material_count;  // Number of table entries, meshes refer to them by material_index
 
     vec3 position;            // Position of the model
     vec3 scale;               // Scale of the model
     versor rotation;          // Rotation of the model as a quaternion (w, x, y, z)
     mat4 transform_matrix;    // Final transformation matrix (position + scale + rotation)
+
+    TransformSystem *transforms; // Hierarchy the model is attached to (NULL if unattached)
+    TransformId transform;       // Root node of the model, meshes are its children
+
+    VfsFile baked;               // Baked model file the meshes point into (see mesh_baked.h), unmapped by model_free
 } Model;
 
+struct ufbx_scene;
+struct ufbx_material;
+
+// Texture URIs (relative to the model) and factors a material is built from, read from glTF, FBX or a baked model
+typedef struct {
+    const char *diffuse_texture;
+    const char *normal_texture;
+    const char *occlusion_texture;
+    const char *emissive_texture;
+    float emissive_color[3];
+} MaterialSource;
+
+// A triangle primitive of a node, the glTF import creates one mesh for each
+typedef struct {
+    cgltf_node *node;
+    cgltf_primitive *primitive;
+} ModelGltfPrimitive;
+
+// Primitives in import order (mesh i of the model comes from entry i), returns the count; out may be NULL
+uint32_t model_gltf_primitives(const cgltf_data *gltf_data, ModelGltfPrimitive *out);
+
 // Load a model from a glTF file and set the texture
 int model_load_gltf(Model *model, const char *file_path, bool apply_parent_transform);
 
+// The two halves of model_load_gltf: geometry makes no GL calls and can run on a worker thread,
+// materials create the textures on the GL thread and free the parsed glTF
+int model_load_gltf_geometry(Model *model, const char *file_path, bool apply_parent_transform, cgltf_data **gltf_out);
+int model_load_gltf_materials(Model *model, cgltf_data *gltf_data, const char *file_path);
+
+// Material source of a glTF / FBX material, as the material passes and the mesh baker read it
+void model_gltf_material_source(const cgltf_material *gltf_material, MaterialSource *source);
+void model_fbx_material_source(const struct ufbx_material *fbx_material, MaterialSource *source);
+
+// FBX models through ufbx, converted to the glTF conventions so they produce the same meshes and materials.
+// Faces are triangulated and welded into indexed vertices, one mesh per material part of every node.
+// Split the same way as the glTF loader, and a sibling .lmesh is preferred like for glTF files.
+int model_load_fbx(Model *model, const char *file_path, bool apply_parent_transform);
+int model_load_fbx_geometry(Model *model, const char *file_path, bool apply_parent_transform, struct ufbx_scene **scene_out);
+int model_load_fbx_materials(Model *model, struct ufbx_scene *scene, const char *file_path);
+
+// True for ".fbx" paths (any case)
+bool model_is_fbx(const char *file_path);
+
+// Baked models (.lmesh, written by tools/meshbake.c): the file is mapped and the meshes point into it, no parsing.
+// Split like the glTF loader, geometry has no GL calls and materials must run on the GL thread.
+int model_load_baked(Model *model, const char *file_path, bool apply_parent_transform);
+int model_load_baked_geometry(Model *model, const char *file_path, bool apply_parent_transform);
+int model_load_baked_materials(Model *model, const char *file_path);
+
+// Baked file next to a glTF or FBX file ("a/b.gltf" -> "a/b.lmesh")
+void model_baked_path(const char *gltf_path, char *dest, size_t dest_size);
+
+// Texture URIs referenced by a loaded baked model's materials (duplicates included), returns how many were written
+uint32_t model_baked_texture_uris(const Model *model, const char **uris, uint32_t max_uris);
+
 // Set the position of the model
 void model_set_position(Model *model, vec3 new_position);
 
@@ -37,6 +96,9 @@ void create_rotation_quaternion(versor q, vec3 axis, float angle);
 // Apply the current transformation matrix to the model (position + scale + rotation)
 void model_apply_transform(Model *model);
 
+// Attach the model and its meshes to a transform hierarchy (meshes become children of the model root)
+void model_attach_transforms(Model *model, TransformSystem *system, TransformId parent);
+
 // Apply material for each mesh (bind textures, set material properties)
 void model_apply_materials(Model *model, GLuint shader_program_id);
 
@@ -17,7 +17,7 @@ typedef struct {
     ShaderProgram shader_program;
 } Cube;
 
-void create_debug_cube_shaders(Cube* cube, const char* vertex_shader, const char* fragment_shader);
+void create_debug_cube_shaders(Cube* cube, const char* vertex_shader, const char* fragment_shader); // Shared program, see pipeline/resources.h
 void create_debug_cube(Cube* cube, vec3 size, vec3 position, vec4 color);
 
 void set_debug_cube_model_matrix(Cube* cube);
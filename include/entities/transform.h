@@ -0,0 +1,71 @@
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include <cglm/cglm.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Transform handle (stable across re-sorting of the hierarchy)
+typedef uint32_t TransformId;
+
+#define TRANSFORM_NONE UINT32_MAX
+
+// Per-node flags
+#define TRANSFORM_FLAG_DIRTY        0x01  // Local TRS changed since the last update
+#define TRANSFORM_FLAG_CHANGED      0x02  // World matrix was rebuilt during the last update
+#define TRANSFORM_FLAG_LOCAL_MATRIX 0x04  // Local matrix was set directly, TRS is ignored
+
+// Transform hierarchy, stored densely in topological order (parents always precede children)
+// so world matrices can be rebuilt in a single linear pass.
+typedef struct {
+    vec3 *positions;          // Local position
+    versor *rotations;        // Local rotation (quaternion x, y, z, w)
+    vec3 *scales;             // Local scale
+    mat4 *locals;             // Local matrix (T * R * S)
+    mat4 *worlds;             // World matrix (parent world * local)
+    uint32_t *parents;        // Dense index of the parent or TRANSFORM_NONE
+    uint8_t *flags;           // TRANSFORM_FLAG_* bits
+
+    TransformId *dense_to_id; // Dense index -> handle
+    uint32_t *id_to_dense;    // Handle -> dense index (TRANSFORM_NONE when free)
+    TransformId *free_ids;    // Recycled handles
+    uint32_t free_count;
+
+    uint32_t count;           // Number of live transforms
+    uint32_t capacity;        // Allocated dense slots
+    uint32_t id_capacity;     // Allocated handle slots
+
+    uint32_t dirty_min;       // Lowest dense index flagged dirty (count when clean)
+    uint32_t changed_min;     // Lowest dense index rebuilt by the last update (count when none)
+} TransformSystem;
+
+// Compose T * R * S directly from a position, quaternion and scale
+void transform_compose(vec3 position, versor rotation, vec3 scale, mat4 dest);
+
+// Compose T * S * Rx * Ry * Rz from a position, Euler angles in degrees and scale
+void transform_compose_euler(vec3 position, vec3 euler_degrees, vec3 scale, mat4 dest);
+
+// System lifecycle
+void transform_system_init(TransformSystem *system, uint32_t initial_capacity);
+void transform_system_free(TransformSystem *system);
+
+// Node management
+TransformId transform_create(TransformSystem *system, TransformId parent);
+void transform_destroy(TransformSystem *system, TransformId id); // Destroys the node and its subtree
+void transform_set_parent(TransformSystem *system, TransformId id, TransformId parent);
+
+// Local state setters (mark the node dirty only when a value actually changes)
+void transform_set_position(TransformSystem *system, TransformId id, vec3 position);
+void transform_set_rotation(TransformSystem *system, TransformId id, versor rotation);
+void transform_set_scale(TransformSystem *system, TransformId id, vec3 scale);
+void transform_set_trs(TransformSystem *system, TransformId id, vec3 position, versor rotation, vec3 scale);
+void transform_set_local_matrix(TransformSystem *system, TransformId id, mat4 local);
+
+// Rebuild every dirty world matrix in one pass; a no-op when nothing moved
+void transform_system_update(TransformSystem *system);
+
+// Accessors
+vec4 *transform_world(TransformSystem *system, TransformId id);
+bool transform_changed(const TransformSystem *system, TransformId id);
+
+#endif // TRANSFORM_H
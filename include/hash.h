@@ -0,0 +1,13 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Fast non-cryptographic 64-bit hash for cache keys, checksums and content matching, 0 never comes out
+uint64_t hash_bytes(const void* data, size_t size);
+
+// Finalizer that spreads every input bit over the whole value (splitmix64)
+uint64_t hash_mix64(uint64_t value);
+
+#endif // HASH_H
@@ -0,0 +1,18 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Local cache for data the game derives at runtime (driver shader binaries, font atlases), in cache/<kind>/ under
+// the working directory. Entries are named by a hash of everything they depend on, so a changed input simply misses;
+// deleting the directory is always safe. Read entries with mapped_file_open.
+
+// Path of an entry, creates cache/<kind> when it does not exist yet
+void cache_entry_path(const char* kind, uint64_t key, const char* extension, char* dest, size_t dest_size);
+
+// Write header + payload through a temporary file and a rename, readers never see a partial entry
+bool cache_write(const char* path, const void* header, size_t header_size, const void* payload, size_t payload_size);
+
+#endif // CACHE_H
@@ -0,0 +1,18 @@
+#ifndef LZ4_H
+#define LZ4_H
+
+#include <stddef.h>
+
+// LZ4 block format (no frame header), compatible with the reference lz4 library.
+// Compression is a single-pass greedy matcher meant for offline tools, decompression is what the game runs.
+
+// Worst case size of compressing size bytes
+size_t lz4_compress_bound(size_t size);
+
+// Returns the compressed size, 0 if dst is too small
+size_t lz4_compress(const unsigned char* src, size_t size, unsigned char* dst, size_t capacity);
+
+// Returns the decompressed size, 0 if the block is malformed or does not fit in dst
+size_t lz4_decompress(const unsigned char* src, size_t size, unsigned char* dst, size_t capacity);
+
+#endif // LZ4_H
@@ -0,0 +1,19 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// Read-only memory-mapped file (mmap / MapViewOfFile).
+// The pages are only read from disk when touched, so opening is cheap and the OS page cache is shared between runs.
+typedef struct {
+    const unsigned char* data;
+    size_t size;
+    void* handle; // Windows mapping object, unused elsewhere
+} MappedFile;
+
+// Map a whole file, returns false (quietly) when it does not exist
+bool mapped_file_open(MappedFile* file, const char* path);
+void mapped_file_close(MappedFile* file);
+
+#endif // MAPPED_FILE_H
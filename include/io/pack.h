@@ -0,0 +1,77 @@
+#ifndef PACK_H
+#define PACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Resource pack (.lpak), written by tools/packbuild.c and mounted through the VFS (io/vfs.h).
+// Layout: PackHeader, entry_count PackEntry sorted by path hash, the name table, then the entry data, each entry
+// starting on a PACK_ALIGNMENT boundary. Stored entries are used in place, compressed ones are LZ4 blocks.
+// All fields are little-endian.
+
+#define PACK_MAGIC 0x4B41504Cu // "LPAK"
+#define PACK_VERSION 1
+#define PACK_ALIGNMENT 16
+
+typedef enum {
+    PACK_STORED,
+    PACK_LZ4
+} PackCompression;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t reserved;
+    uint64_t names_offset;    // Null-terminated normalized paths
+    uint64_t names_size;
+} PackHeader;
+
+typedef struct {
+    uint64_t hash;            // pack_hash_path of the normalized path
+    uint32_t name;            // Offset in the name table
+    uint32_t compression;     // PackCompression
+    uint64_t offset;          // From the start of the file
+    uint64_t size;            // Bytes stored in the pack
+    uint64_t raw_size;        // Bytes once decompressed
+} PackEntry;
+
+// FNV-1a, paths must be normalized first (see vfs_normalize_path)
+static inline uint64_t pack_hash_path(const char* path) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const unsigned char* p = (const unsigned char*)path; *p; p++) {
+        hash ^= *p;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static inline const PackEntry* pack_entries(const PackHeader* header) {
+    return (const PackEntry*)(header + 1);
+}
+
+static inline const char* pack_entry_name(const PackHeader* header, const PackEntry* entry) {
+    return (const char*)header + header->names_offset + entry->name;
+}
+
+// Check a mapped pack before anything reads it, returns NULL if it is truncated or not a pack
+static inline const PackHeader* pack_validate(const unsigned char* data, size_t size) {
+    const PackHeader* header = (const PackHeader*)data;
+    if (!data || size < sizeof(PackHeader)) return NULL;
+    if (header->magic != PACK_MAGIC || header->version != PACK_VERSION) return NULL;
+    if (sizeof(PackHeader) + (uint64_t)header->entry_count * sizeof(PackEntry) > size) return NULL;
+    if (header->names_offset > size || header->names_size > size - header->names_offset || header->names_size == 0) return NULL;
+    if (data[header->names_offset + header->names_size - 1] != '\0') return NULL;
+
+    const PackEntry* entries = pack_entries(header);
+    for (uint32_t i = 0; i < header->entry_count; i++) {
+        const PackEntry* entry = &entries[i];
+        if (entry->name >= header->names_size || entry->offset > size || entry->size > size - entry->offset) return NULL;
+        if (entry->compression > PACK_LZ4 || (entry->compression == PACK_STORED && entry->size != entry->raw_size)) return NULL;
+        if (i > 0 && entries[i - 1].hash > entry->hash) return NULL; // Lookups binary search the hashes
+    }
+    return header;
+}
+
+#endif // PACK_H
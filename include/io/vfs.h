@@ -0,0 +1,35 @@
+#ifndef VFS_H
+#define VFS_H
+
+#include <io/mapped_file.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Virtual file system over mounted resource packs (io/pack.h) with loose files as the fallback.
+// Paths are the ones the game already uses ("resources/models/cube.gltf"), a pack built from the game directory
+// stores the same names. Files not in any pack are read from disk, so development needs no pack at all.
+// Mount packs at startup before anything loads, lookups are read-only and safe from any thread afterwards.
+
+typedef struct {
+    const unsigned char* data; // Read-only view: inside the pack for stored entries, else owned or mapped
+    size_t size;
+    unsigned char* owned;      // Decompressed copy, freed by vfs_close
+    MappedFile mapped;         // Loose file mapping
+} VfsFile;
+
+// Mount a pack, later mounts are searched first. Returns false (quietly) when the file does not exist.
+bool vfs_mount(const char* pack_path);
+void vfs_unmount_all();
+
+// Zero-copy view of a file, returns false (quietly) when no pack nor the disk has it
+bool vfs_open(VfsFile* file, const char* path);
+void vfs_close(VfsFile* file);
+bool vfs_exists(const char* path);
+
+// Heap copy of a file, null-terminated so text files can be used as strings (free it)
+unsigned char* vfs_read(const char* path, size_t* size);
+
+// Forward slashes, no "." or "dir/.." segments (the form pack entries are stored and looked up in)
+void vfs_normalize_path(const char* path, char* dest, size_t dest_size);
+
+#endif // VFS_H
@@ -0,0 +1,29 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Background work function, runs on one of the worker threads
+typedef void (*JobFunc)(void* data);
+
+// One item of a parallel loop
+typedef void (*JobIndexFunc)(void* data, uint32_t index);
+
+// Start the worker pool (0 = one worker per hardware thread, minus the main thread)
+bool jobs_init(uint32_t worker_count);
+
+// Stop the workers; jobs that have not started yet are dropped
+void jobs_shutdown();
+
+// Queue a job (FIFO), returns false if the pool is not running
+bool jobs_submit(JobFunc func, void* data);
+
+// Run func for every index in [0, count) on the workers and the calling thread, returns once all are done.
+// The caller works through the items itself, so this is safe to call from inside a job.
+void jobs_parallel_for(uint32_t count, JobIndexFunc func, void* data);
+
+// Number of running workers
+uint32_t jobs_worker_count();
+
+#endif // JOBS_H
@@ -0,0 +1,48 @@
+#ifndef THREAD_H
+#define THREAD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef _WIN32
+	#include <pthread.h>
+#endif
+
+// Thin platform layer over Win32 threads and pthreads.
+// windows.h is kept out of the header (its near/far macros break Camera), the Win32
+// types are layout-compatible stand-ins for HANDLE, SRWLOCK and CONDITION_VARIABLE.
+#ifdef _WIN32
+typedef void* Thread;
+typedef struct { void* ptr; } Mutex;
+typedef struct { void* ptr; } CondVar;
+#else
+typedef pthread_t Thread;
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t CondVar;
+#endif
+
+typedef void (*ThreadFunc)(void* arg);
+
+// Threads
+bool thread_create(Thread* thread, ThreadFunc func, void* arg);
+void thread_join(Thread thread);
+uint32_t thread_current_id();
+uint32_t thread_hardware_concurrency();
+void thread_sleep_ms(uint32_t milliseconds);
+
+// Mutexes and condition variables
+void mutex_init(Mutex* mutex);
+void mutex_destroy(Mutex* mutex);
+void mutex_lock(Mutex* mutex);
+void mutex_unlock(Mutex* mutex);
+
+void cond_init(CondVar* cond);
+void cond_destroy(CondVar* cond);
+void cond_wait(CondVar* cond, Mutex* mutex);
+void cond_signal(CondVar* cond);
+void cond_broadcast(CondVar* cond);
+
+// Monotonic clock in nanoseconds
+uint64_t clock_now_ns();
+
+#endif // THREAD_H
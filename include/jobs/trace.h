@@ -0,0 +1,37 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+
+// Timeline tracing, compiled in with -DLWLAIM_TRACE (bun build-trace) and written as Chrome trace JSON on exit,
+// open it in chrome://tracing or ui.perfetto.dev.
+// Zones are begin/end pairs that nest per thread. Every thread records into its own buffer without locking, names
+// must be string literals (or otherwise outlive the trace), details are copied.
+// Without LWLAIM_TRACE the macros expand to nothing and their arguments are never evaluated.
+
+#ifdef LWLAIM_TRACE
+
+void trace_begin(const char* name, const char* detail);
+void trace_end();
+void trace_thread_name(const char* name);
+
+// Write every recorded event, returns false when the file cannot be written
+bool trace_write(const char* path);
+
+#define TRACE_BEGIN(name) trace_begin(name, NULL)
+#define TRACE_BEGIN_DETAIL(name, detail) trace_begin(name, detail) // detail: file path or other context
+#define TRACE_END() trace_end()
+#define TRACE_THREAD_NAME(name) trace_thread_name(name)
+#define TRACE_WRITE(path) trace_write(path)
+
+#else
+
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_BEGIN_DETAIL(name, detail) ((void)0)
+#define TRACE_END() ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#define TRACE_WRITE(path) ((void)0)
+
+#endif // LWLAIM_TRACE
+
+#endif // TRACE_H
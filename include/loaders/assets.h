@@ -0,0 +1,129 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <glad/glad.h>
+#include <AL/al.h>
+#include <cgltf.h>
+
+#include <entities/model.h>
+#include <pipeline/shader.h>
+#include <output/voices.h>
+#include <io/vfs.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Asynchronous asset loading.
+// File I/O, glTF parsing and image/audio decoding run on the job workers, GL work (texture uploads through
+// PBOs, shader compiles, material creation) runs on the main thread in assets_update under a time budget.
+// Finalization happens strictly in request order, so a callback can rely on everything requested before it.
+
+#define ASSETS_FRAME_BUDGET_MS 4.0 // Default main-thread time per frame spent finalizing loads
+
+typedef enum {
+    ASSET_FILE,     // Raw file contents (null-terminated)
+    ASSET_IMAGE,    // 2D texture
+    ASSET_CUBEMAP,  // Cubemap texture from six faces
+    ASSET_SHADER,   // Vertex + fragment program
+    ASSET_WAV,      // PCM samples ready for alBufferData
+    ASSET_MODEL,    // glTF or FBX model with its material textures
+    ASSET_BARRIER   // No work, only orders its callback after earlier requests
+} AssetType;
+
+typedef enum {
+    ASSET_QUEUED,   // Waiting for (or running on) a worker
+    ASSET_DECODED,  // Worker part done, waiting for the main thread
+    ASSET_READY,    // Finalized, callback invoked
+    ASSET_FAILED    // Something went wrong, callback invoked with no result
+} AssetStatus;
+
+// A decoded image waiting for its upload
+typedef struct {
+    char *uri;              // glTF URI (model textures only)
+    unsigned char *pixels;
+    int width, height, channels;
+    VfsFile baked;          // Baked container used instead of pixels, see texture_baked.h
+
+    // Model textures only, see texture_registry.h
+    char *canonical_path;
+    uint64_t content_hash;
+    GLuint texture_id;      // Registered texture the loader holds a reference to
+} AssetImage;
+
+typedef struct Asset Asset;
+typedef struct AssetPart AssetPart;
+
+// Invoked on the main thread once the asset is finalized (or failed).
+// CPU-side data (file bytes, PCM samples) is only valid during the callback, GL objects belong to the caller.
+typedef void (*AssetCallback)(Asset *asset, void *user);
+
+struct Asset {
+    AssetType type;
+    AssetStatus status;
+    char *paths[6];              // Source file(s)
+
+    // ASSET_FILE / ASSET_WAV
+    unsigned char *data;
+    size_t size;
+
+    // ASSET_IMAGE / ASSET_CUBEMAP / ASSET_MODEL
+    AssetImage *images;
+    uint32_t image_count;
+    bool flip;                   // Flip vertically on decode
+    GLuint texture_id;           // Uploaded texture (image and cubemap)
+    int width, height;
+
+    // ASSET_SHADER
+    char *sources[2];
+    ShaderBuild shader_build;    // Issued as soon as the sources are read, collected in request order
+    ShaderProgram shader;        // Shared through pipeline/resources.h, release with resources_program_release
+
+    // ASSET_WAV
+    ALenum format;
+    ALsizei frequency;
+    char *clip_name;             // Added to the sound bank under this name when set (assets_load_sound)
+    SoundClip clip;
+
+    // ASSET_MODEL
+    Model *model;
+    bool apply_parent_transform;
+    cgltf_data *gltf;
+    struct ufbx_scene *fbx;      // Set instead of gltf for FBX models
+
+    AssetCallback on_ready;
+    void *user;
+
+    AssetPart *parts;            // Per-image decode jobs (cubemap faces, model textures)
+    uint32_t part_count;
+    uint32_t pending;            // Decode jobs still running
+    bool failed_part;
+
+    uint32_t finalize_step;      // Progress of a multi-step finalize
+    Asset *next;                 // Request order
+};
+
+// Loader lifecycle (the job workers must be running, see jobs_init, and the GL context current)
+bool assets_init();
+void assets_shutdown(); // Call after jobs_shutdown so no worker still holds an asset
+
+// Requests, each returns immediately
+Asset *assets_load_file(const char *path, AssetCallback on_ready, void *user);
+Asset *assets_load_image(const char *path, bool flip, AssetCallback on_ready, void *user);
+Asset *assets_load_cubemap(const char *faces[6], AssetCallback on_ready, void *user);
+Asset *assets_load_shader(const char *vertex_path, const char *fragment_path, AssetCallback on_ready, void *user);
+Asset *assets_load_wav(const char *path, AssetCallback on_ready, void *user);
+Asset *assets_load_sound(const char *name, const char *path, AssetCallback on_ready, void *user); // Decoded on a worker, then into the sound bank
+Asset *assets_load_model(Model *model, const char *path, bool apply_parent_transform, AssetCallback on_ready, void *user);
+Asset *assets_after(AssetCallback on_ready, void *user);
+
+// Main thread: finalize decoded assets until the budget runs out (always at least one step)
+void assets_update(double budget_ms);
+
+// Fraction of the current batch that is done (1.0 when nothing is pending)
+float assets_progress();
+
+// True when every request has been finalized
+bool assets_idle();
+
+#endif // ASSETS_H
@@ -3,17 +3,21 @@
 
 #include <cglm/cglm.h>
 
+// Unified indexed mesh: every position/texcoord/normal triplet used by a face becomes one vertex, so all arrays
+// share the same indices. Polygons are triangulated as fans.
 typedef struct {
     float *positions;   // Vertex positions (x, y, z)
-    float *normals;     // Normals (x, y, z)
-    float *texcoords;   // Texture coordinates (u, v)
-    unsigned int *indices;  // Indices (for faces)
+    float *normals;     // Normals (x, y, z), NULL when the file has none
+    float *texcoords;   // Texture coordinates (u, v), NULL when the file has none
+    unsigned int *indices;  // Triangle indices
     size_t vertex_count;
     size_t index_count;
-    size_t texcoords_count;
-    size_t normals_count;
+    size_t texcoords_count; // vertex_count or 0
+    size_t normals_count;   // vertex_count or 0
 } StaticMesh;
 
+// Returns 1 on success, -1 on failure (the mesh is left empty)
 int load_obj(const char *filename, StaticMesh *mesh);
+void free_obj(StaticMesh *mesh);
 
-#endif // OBJ_H
\ No newline at end of file
+#endif // OBJ_H
@@ -0,0 +1,50 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <AL/al.h>
+
+// Per-frame 3D audio state. The listener is set once per frame from the camera and only sent to OpenAL when it
+// changed. Sources keep a copy of the parameters last sent to them, so setting a value that did not change costs
+// no AL call. Emitters only write their positions in memory: audio_update pushes them for the voices that own a
+// source, so the AL calls per frame depend on the sources in use, not on how many emitters exist.
+// Main thread only.
+
+typedef enum {
+    AUDIO_GAIN,
+    AUDIO_PITCH,
+    AUDIO_REFERENCE_DISTANCE,
+    AUDIO_MAX_DISTANCE,
+    AUDIO_ROLLOFF_FACTOR,
+    AUDIO_FLOAT_PARAMS
+} AudioFloatParam;
+
+// Values last sent to one source. A zeroed cache holds nothing, every value is sent the first time it is set.
+typedef struct {
+    uint32_t valid;             // Bit per cached value
+    float floats[AUDIO_FLOAT_PARAMS];
+    float position[3];
+    ALuint buffer;
+    bool looping;
+    bool relative;
+} AudioSourceCache;
+
+void audio_source_setf(AudioSourceCache* cache, ALuint source, AudioFloatParam param, float value);
+void audio_source_set_position(AudioSourceCache* cache, ALuint source, const float position[3]);
+void audio_source_set_buffer(AudioSourceCache* cache, ALuint source, ALuint buffer);
+void audio_source_set_looping(AudioSourceCache* cache, ALuint source, bool looping);
+void audio_source_set_relative(AudioSourceCache* cache, ALuint source, bool relative);
+void audio_source_invalidate(AudioSourceCache* cache); // The source was changed behind the cache's back
+
+// Listener, sent only when it moved or turned. The position is kept for audibility checks.
+void audio_listener_set(const float position[3], const float forward[3], const float up[3]);
+const float* audio_listener_position();
+
+// Forget everything sent so far (sound_initialize calls it for a new context)
+void audio_reset();
+
+// Once per frame: listener from the camera, then the voice pool and the streams
+void audio_update(const float listener_pos[3], const float listener_dir[3], const float listener_up[3]);
+
+#endif // AUDIO_H
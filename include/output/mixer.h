@@ -0,0 +1,71 @@
+#ifndef MIXER_H
+#define MIXER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Software mixer for low-latency one-shots. An audio thread sums the playing voices into small stereo blocks
+// (float, SSE2 gain / pan / attenuation ramps) and hands each block to an output: OpenAL (a short buffer queue on
+// one source), a WAV file writer, or a null sink. Triggers reach the audio thread through a lock-free
+// single-producer queue, so playing a sound never blocks and never allocates. Everything but the audio thread
+// is driven from one thread (the game's main thread).
+
+#define MIXER_BLOCK_FRAMES 128   // Frames mixed per block
+#define MIXER_MAX_CLIPS 64
+#define MIXER_MAX_VOICES 64
+#define MIXER_QUEUE_SIZE 1024    // Pending trigger events, a power of two
+
+typedef struct MixerOutput MixerOutput;
+
+// Output backend. write blocks until the output can take another block, which paces the audio thread.
+struct MixerOutput {
+    bool (*open)(MixerOutput* output, uint32_t sample_rate);
+    bool (*write)(MixerOutput* output, const int16_t* frames, uint32_t frame_count); // Interleaved stereo
+    void (*close)(MixerOutput* output);
+    uint32_t latency_frames;     // Frames the output buffers ahead of the speaker, for latency reporting
+    void* state;
+};
+
+// Outputs (the returned structs are static, one of each kind at a time)
+MixerOutput* mixer_output_openal(uint32_t buffer_count); // Source queue of buffer_count blocks, needs the AL context (mixer_openal.c)
+MixerOutput* mixer_output_wav(const char* path);         // Writes as fast as the mixer runs
+MixerOutput* mixer_output_null(bool realtime);           // Discards, optionally paced like a device
+
+typedef int MixerClip;      // -1 when adding failed
+typedef uint32_t MixerVoice; // 0 when the queue was full or the output failed
+
+typedef struct {
+    uint64_t blocks;
+    uint64_t frames;
+    uint64_t mix_ns;          // Time spent mixing (outputs excluded)
+    uint64_t triggers;
+    uint64_t dropped;         // Triggers with no voice left (the oldest is replaced) or a full queue
+    uint64_t latency_ns_total; // Trigger call to the block holding its first frame being written, summed
+    uint64_t latency_ns_max;
+    uint32_t voices_peak;
+} MixerStats;
+
+// Start the audio thread on an output, false when the output cannot be opened
+bool mixer_start(MixerOutput* output, uint32_t sample_rate);
+void mixer_stop();
+
+// True once mixer_stop was called, an output write that waits on its device should return
+bool mixer_stopping();
+
+// Add 16-bit mono samples, resampled to the mixer rate and kept as float. Call before triggering the clip.
+MixerClip mixer_clip_add(const int16_t* samples, size_t frame_count, uint32_t sample_rate);
+
+// pan: -1 left, 0 centre, 1 right (equal power). attenuation: distance gain 0..1, multiplied with volume.
+MixerVoice mixer_play(MixerClip clip, float volume, float pan, float attenuation);
+void mixer_voice_set(MixerVoice voice, float volume, float pan, float attenuation); // Ramped over one block
+void mixer_voice_stop(MixerVoice voice);
+
+void mixer_get_stats(MixerStats* stats);
+
+// Mix blocks on the calling thread instead of the audio thread (mixer_start not called), for tools and benchmarks
+bool mixer_render_begin(MixerOutput* output, uint32_t sample_rate);
+void mixer_render(uint32_t block_count);
+void mixer_render_end();
+
+#endif // MIXER_H
@@ -4,6 +4,7 @@
 #include <stdbool.h>
 #include <AL/al.h>
 #include <AL/alc.h>
+#include <output/audio.h>
 
 // Sound structure
 typedef struct {
@@ -13,6 +14,7 @@ typedef struct {
     bool is_muted;       // Mute state
 	bool played;
     float volume;        // Current volume
+    AudioSourceCache cache; // Values last sent to the source, zero-initialised with the struct
 } Sound;
 
 // Sound system initialization and cleanup
@@ -32,8 +34,9 @@ void sound_set_volume(Sound* sound, float volume);
 void sound_pause(Sound* sound);
 void sound_resume(Sound* sound);
 
-// Spatial audio: relative to world position (rtwp)
-void sound_play_once_rtwp(Sound* sound, float sound_pos[3], float listener_pos[3], float listener_dir[3], float listener_up[3]);
-void sound_play_repeat_rtwp(Sound* sound, float sound_pos[3], float listener_pos[3], float listener_dir[3], float listener_up[3]);
+// Spatial audio: relative to world position (rtwp). Safe to call every frame, only changed values reach OpenAL.
+// The listener comes from audio_update.
+void sound_play_once_rtwp(Sound* sound, const float sound_pos[3]);
+void sound_play_repeat_rtwp(Sound* sound, const float sound_pos[3]);
 
 #endif // SOUND_H
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdbool.h>
+
+// Streamed playback for music and long ambience. A decoder thread reads the WAV file a chunk at a time into a small
+// ring, the main thread moves filled chunks into a few queued AL buffers, so memory stays the same whatever the
+// track length. Opening returns at once: the file is opened and parsed on the decoder thread and playback starts
+// when the first chunk is ready. Loose files and stored pack entries are read straight from their mapping,
+// LZ4-compressed pack entries are decompressed whole (packbuild stores audio uncompressed for this).
+// Main thread only, apart from the decoder itself.
+
+#define SOUND_STREAM_CHUNKS 4          // Decoded chunks and AL buffers per stream
+#define SOUND_STREAM_CHUNK_FRAMES 8192 // About 190 ms at 44.1 kHz
+
+typedef struct SoundStream SoundStream;
+
+// NULL only when out of memory or sources, a file that fails to open shows up as a stream that never plays
+SoundStream* sound_stream_open(const char* path, bool looping, float volume);
+void sound_stream_close(SoundStream* stream);
+void sound_stream_set_volume(SoundStream* stream, float volume);
+bool sound_stream_finished(const SoundStream* stream); // Played to the end, or failed to open
+
+// Once per frame (audio_update calls it): queue decoded chunks and restart streams that ran dry
+void sound_streams_update();
+
+// Stops the decoder and frees every stream (sound_cleanup calls it)
+void sound_streams_cleanup();
+
+#endif // STREAM_H
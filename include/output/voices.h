@@ -0,0 +1,53 @@
+#ifndef VOICES_H
+#define VOICES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <AL/al.h>
+
+// Sound bank and voice pool. Clips are uploaded to an AL buffer once and shared by every voice playing them.
+// Voices are played on a fixed set of sources created at startup: triggering never allocates, and when every
+// source is busy the lowest priority (then quietest, then oldest) voice gives up its source. Voices beyond their
+// max distance, or stolen from, keep running virtually (time only) and get a source back once audible and free.
+// Main thread only. sound_initialize / sound_cleanup create and destroy the pool.
+
+#define SOUND_MAX_CLIPS 64
+#define SOUND_MAX_SOURCES 32            // Real AL sources, fewer when the device refuses more
+#define SOUND_MAX_VOICES 128            // Playing voices, real or virtual
+#define SOUND_REFERENCE_DISTANCE 5.0f   // Full volume within this distance
+#define SOUND_DEFAULT_MAX_DISTANCE 50.0f
+
+typedef int SoundClip;      // Index in the bank, -1 when loading failed
+typedef uint32_t SoundVoice; // Handle of a playing voice, 0 when nothing plays (stale handles are ignored)
+
+typedef struct {
+    float volume;
+    float pitch;            // 1 plays at the recorded rate
+    int priority;           // Higher keeps its source when voices are stolen
+    bool looping;
+    bool positional;        // Played at position in the world, otherwise at the listener
+    float position[3];
+    float max_distance;     // Positional only, fades out linearly up to here (0 = SOUND_DEFAULT_MAX_DISTANCE)
+} SoundParams;
+
+#define SOUND_PARAMS_DEFAULT { 1.0f, 1.0f, 0, false, false, { 0.0f, 0.0f, 0.0f }, 0.0f }
+
+bool voices_init();
+void voices_cleanup();
+
+// Upload decoded samples (format as for alBufferData) under a name, returns the existing clip when already added
+SoundClip sound_bank_add(const char* name, ALenum format, const void* data, ALsizei size, ALsizei frequency);
+SoundClip sound_bank_find(const char* name);
+
+// Start a clip, O(1) apart from a bounded scan over the sources when all are busy.
+// Returns 0 when every voice outranks this one.
+SoundVoice sound_trigger(SoundClip clip, const SoundParams* params);
+void sound_voice_stop(SoundVoice voice);
+void sound_voice_set_position(SoundVoice voice, const float position[3]); // Sent once per frame by the update
+bool sound_voice_active(SoundVoice voice);
+
+// Once per frame, after the listener is set (audio_update calls it): reclaims finished voices, sends moved
+// positions and moves voices between real and virtual
+void sound_voices_update();
+
+#endif // VOICES_H
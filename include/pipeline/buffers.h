@@ -21,6 +21,9 @@ GLuint buffers_create_vbo(const float* vertices, size_t vertex_count);
 // Initializes an EBO with index data
 GLuint buffers_create_ebo(const unsigned int* indices, size_t index_count);
 
+// Creates an immutable buffer (glBufferStorage) straight from data that stays valid only for the call, e.g. a mapped file
+GLuint buffers_create_storage(GLenum target, const void* data, size_t size);
+
 // Initializes a VAO, VBO, and optionally an EBO for existing data
 Buffers buffers_create_empty();
 
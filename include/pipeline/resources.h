@@ -0,0 +1,61 @@
+#ifndef RESOURCES_H
+#define RESOURCES_H
+
+#include <glad/glad.h>
+#include <pipeline/shader.h>
+#include <ui/text.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Process-wide shared GL resources, so scenes and UI components that use the same program or font get one copy.
+// Shader programs are keyed by the canonical paths of their two stages, and by the hash of their sources so the same
+// shaders copied under other paths are not compiled twice. Fonts are keyed by canonical path, size, spacing and
+// program (the glyph atlas is shared between every size already, see text.h). Images go through the texture
+// registry (image_init). Every acquire takes a reference, the resource is destroyed with the last release.
+// Main thread only.
+
+// Hash of a program's sources, 0 never comes out
+uint64_t resources_source_hash(const char *vertex_source, const char *fragment_source);
+
+// Program for the two files, compiled on first use. id 0 when it fails to build.
+ShaderProgram resources_program_acquire(const char *vertex_path, const char *fragment_path);
+
+// Deferred acquire, see shader_build_begin: begin every program first and finish them afterwards so a cold start
+// compiles them side by side. The paths must stay valid until the build is finished or cancelled.
+typedef struct {
+    const char *vertex_path;
+    const char *fragment_path;
+    uint64_t source_hash;
+    ShaderProgram shared;    // Already registered, nothing to build
+    ShaderBuild build;
+} ProgramBuild;
+
+// False when the sources cannot be read (finishing then returns id 0)
+bool resources_program_begin(ProgramBuild *build, const char *vertex_path, const char *fragment_path);
+// The program with one reference, like resources_program_acquire
+ShaderProgram resources_program_finish(ProgramBuild *build);
+// Drop a build that will never be finished
+void resources_program_cancel(ProgramBuild *build);
+
+// Registered program for the paths, or for the source hash when non-zero, with a new reference. id 0 when neither is
+// registered; a hash match also registers the paths, so the next lookup hits directly.
+ShaderProgram resources_program_find(const char *vertex_path, const char *fragment_path, uint64_t source_hash);
+
+// Register a freshly built program and return it with one reference. When the paths or sources were registered in
+// the meantime, the existing program is returned instead and this one is destroyed.
+ShaderProgram resources_program_add(const char *vertex_path, const char *fragment_path, uint64_t source_hash, ShaderProgram program);
+
+// Drop a reference and clear the handle (programs that are not registered are destroyed directly)
+void resources_program_release(ShaderProgram *program);
+
+// Font for the file at this size, never NULL: a font that failed to load renders nothing
+Font *resources_font_acquire(const char *path, float size, float spacing, GLuint shader_program);
+void resources_font_release(Font *font);
+
+void resources_report();
+
+// Destroy whatever is still registered (reports leaked references)
+void resources_shutdown();
+
+#endif // RESOURCES_H
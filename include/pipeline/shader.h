@@ -3,14 +3,40 @@
 
 #include <glad/glad.h>
 
+#include <stdint.h>
+#include <stdbool.h>
+
 // Struct to hold shader program information
 typedef struct {
     GLuint id;
 } ShaderProgram;
 
-// Create a shader program from vertex and fragment shader source strings
+// Program whose compiles and link have been issued but not checked yet
+typedef struct {
+    GLuint program;
+    GLuint vertex_shader;    // 0 when the program came from the binary cache
+    GLuint fragment_shader;
+    uint64_t cache_key;      // 0 when the binary cache is unavailable
+} ShaderBuild;
+
+// Detect GL_KHR/ARB_parallel_shader_compile and let the driver use its compiler threads. Call once after loading GL.
+void shader_init(GLADloadproc load);
+
+// Create a shader program from vertex and fragment shader source strings.
+// Linked programs are cached as driver binaries in cache/shaders, keyed by the sources and the GL vendor, renderer
+// and version, so later runs skip compilation. Rejected or damaged entries fall back to compiling the sources.
 ShaderProgram shader_create(const char* vertexSrc, const char* fragmentSrc);
 
+// Deferred creation: shader_build_begin only issues the work, reading a status is what makes the driver wait.
+// Begin every program first and finish each one when it is needed, so drivers with compiler threads overlap them.
+void shader_build_begin(ShaderBuild* build, const char* vertexSrc, const char* fragmentSrc);
+// True once finishing will not block (always true without parallel shader compile support)
+bool shader_build_ready(const ShaderBuild* build);
+// Collect the result, reporting errors like shader_create (id 0 on failure), and release the shader objects
+ShaderProgram shader_build_finish(ShaderBuild* build);
+// Drop a build that will never be finished
+void shader_build_cancel(ShaderBuild* build);
+
 // Use the shader program
 void shader_use(const ShaderProgram* shader);
 void shader_disband();
@@ -2,17 +2,41 @@
 #define TEXTURE_H
 
 #include <glad/glad.h>
+#include <stdbool.h>
+
+#include <pipeline/texture_baked.h>
 
 // Struct to hold texture information
 typedef struct {
     GLuint id;
     int width;
     int height;
+    size_t gpu_bytes;
 } Texture;
 
 // Initialize a texture with raw data (e.g., font bitmap or image pixel data)
 Texture texture_create(const unsigned char* data, int width, int height, GLenum format);
 
+// Decode an image file found through the VFS (stbi_load semantics, flip-on-load included), free with stbi_image_free
+unsigned char* texture_load_pixels(const char* path, int* width, int* height, int* channels, int desired_channels);
+
+// Path of the baked container next to a source image ("a/b.png" -> "a/b.ltex")
+void texture_baked_path(const char* source_path, char* dest, size_t dest_size);
+
+// Whether the GL can sample the container's format (BC1/BC3 need S3TC, BC7 needs GL 4.2)
+bool texture_baked_supported(const TextureBakedHeader* header);
+
+// Allocate immutable storage for every level of a container on the bound target (GL_TEXTURE_2D or GL_TEXTURE_CUBE_MAP)
+bool texture_baked_allocate(GLenum target, const TextureBakedHeader* header);
+
+// Upload every level of a validated container into the bound texture (GL_TEXTURE_2D or one cube map face)
+void texture_baked_upload(GLenum target, const TextureBakedHeader* header);
+
+// Create a texture from a baked container: the file is mapped and its mip chain uploaded as stored, nothing is decoded.
+// flip is the orientation the caller would have loaded the source with. Returns a texture with id 0 if the file is
+// missing, invalid, baked with the other orientation or in a format this GL cannot sample.
+Texture texture_create_baked(const char* path, bool flip);
+
 // Bind a texture to a specified texture unit
 void texture_bind(const Texture* texture, GLenum textureUnit);
 
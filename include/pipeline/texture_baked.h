@@ -0,0 +1,106 @@
+#ifndef TEXTURE_BAKED_H
+#define TEXTURE_BAKED_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Baked texture container (.ltex), written offline by tools/texbake.c and mapped at runtime.
+// Layout: TextureBakedHeader, level_count TextureBakedLevel entries, then the level data (largest first),
+// each level starting on a TEXTURE_BAKED_ALIGNMENT boundary. All fields are little-endian.
+// Levels are stored exactly as the GL expects them, so loading is a map and an upload with no decoding.
+
+#define TEXTURE_BAKED_MAGIC 0x5845544Cu // "LTEX"
+#define TEXTURE_BAKED_VERSION 1
+#define TEXTURE_BAKED_EXTENSION ".ltex"
+#define TEXTURE_BAKED_MAX_LEVELS 16
+#define TEXTURE_BAKED_ALIGNMENT 16
+
+typedef enum {
+    TEXTURE_BAKED_RGB8,
+    TEXTURE_BAKED_RGBA8,
+    TEXTURE_BAKED_BC1,   // 4x4 blocks of 8 bytes, opaque
+    TEXTURE_BAKED_BC3,   // 4x4 blocks of 16 bytes, interpolated alpha
+    TEXTURE_BAKED_BC7,   // 4x4 blocks of 16 bytes (produced by external encoders)
+    TEXTURE_BAKED_FORMAT_COUNT
+} TextureBakedFormat;
+
+#define TEXTURE_BAKED_FLIPPED 0x1 // Rows were flipped vertically before baking (stbi flip-on-load equivalent)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t format;      // TextureBakedFormat
+    uint32_t flags;
+    uint32_t width;
+    uint32_t height;
+    uint32_t level_count;
+    uint32_t reserved;
+} TextureBakedHeader;
+
+typedef struct {
+    uint64_t offset;      // From the start of the file
+    uint64_t size;
+} TextureBakedLevel;
+
+static inline bool texture_baked_compressed(uint32_t format) {
+    return format == TEXTURE_BAKED_BC1 || format == TEXTURE_BAKED_BC3 || format == TEXTURE_BAKED_BC7;
+}
+
+static inline uint32_t texture_baked_level_dimension(uint32_t size, uint32_t level) {
+    uint32_t dimension = size >> level;
+    return dimension ? dimension : 1;
+}
+
+// Levels of a complete chain down to 1x1, floor(log2(max(width, height))) + 1
+static inline uint32_t texture_baked_full_level_count(uint32_t width, uint32_t height) {
+    uint32_t largest = width > height ? width : height;
+    uint32_t count = 1;
+    while (largest >> count) count++;
+    return count;
+}
+
+// Bytes of one level in the given format
+static inline size_t texture_baked_level_size(uint32_t format, uint32_t width, uint32_t height) {
+    size_t blocks = (size_t)((width + 3) / 4) * ((height + 3) / 4);
+    switch (format) {
+        case TEXTURE_BAKED_RGB8: return (size_t)width * height * 3;
+        case TEXTURE_BAKED_RGBA8: return (size_t)width * height * 4;
+        case TEXTURE_BAKED_BC1: return blocks * 8;
+        default: return blocks * 16;
+    }
+}
+
+static inline const TextureBakedLevel* texture_baked_levels(const TextureBakedHeader* header) {
+    return (const TextureBakedLevel*)(header + 1);
+}
+
+// Check a mapped container before anything reads its levels, returns NULL if it is truncated or not a container
+static inline const TextureBakedHeader* texture_baked_validate(const unsigned char* data, size_t size) {
+    const TextureBakedHeader* header = (const TextureBakedHeader*)data;
+    if (!data || size < sizeof(TextureBakedHeader)) return NULL;
+    if (header->magic != TEXTURE_BAKED_MAGIC || header->version != TEXTURE_BAKED_VERSION) return NULL;
+    if (header->format >= TEXTURE_BAKED_FORMAT_COUNT || !header->width || !header->height) return NULL;
+    if (!header->level_count || header->level_count > TEXTURE_BAKED_MAX_LEVELS) return NULL;
+    // More levels than the chain has would make glTexStorage2D fail
+    if (header->level_count > texture_baked_full_level_count(header->width, header->height)) return NULL;
+    if (size < sizeof(TextureBakedHeader) + sizeof(TextureBakedLevel) * header->level_count) return NULL;
+
+    const TextureBakedLevel* levels = texture_baked_levels(header);
+    for (uint32_t i = 0; i < header->level_count; i++) {
+        size_t expected = texture_baked_level_size(header->format, texture_baked_level_dimension(header->width, i),
+                                                   texture_baked_level_dimension(header->height, i));
+        if (levels[i].size != expected || levels[i].offset > size || levels[i].size > size - levels[i].offset) return NULL;
+    }
+    return header;
+}
+
+// GPU memory of the whole chain
+static inline size_t texture_baked_gpu_bytes(const TextureBakedHeader* header) {
+    size_t bytes = 0;
+    const TextureBakedLevel* levels = texture_baked_levels(header);
+    for (uint32_t i = 0; i < header->level_count; i++) bytes += (size_t)levels[i].size;
+    return bytes;
+}
+
+#endif // TEXTURE_BAKED_H
@@ -0,0 +1,52 @@
+#ifndef TEXTURE_REGISTRY_H
+#define TEXTURE_REGISTRY_H
+
+#include <glad/glad.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Process-wide registry of shared GL textures.
+// A texture is found either by its canonical absolute path or by the hash of its file contents, so the same
+// image referenced from different models (or copied under another name) is uploaded once. Every user holds a
+// reference; the GL texture is deleted when the last one is released.
+// Lookups and retains are thread-safe, the final release deletes the texture and must happen on the GL thread.
+
+#define TEXTURE_PATH_MAX 1024
+
+// Canonical absolute form of a path (separators normalized, case-folded on Windows)
+bool texture_path_canonical(const char* path, char* dest, size_t dest_size);
+
+// Estimated GPU memory of a texture (RGB is assumed padded to RGBA, mipmaps add a third)
+size_t texture_gpu_bytes(int width, int height, int channels, bool mipmapped);
+
+// Find a texture by canonical path, or by content hash (hash_bytes of the encoded file) when non-zero. Returns the
+// texture with a new reference, 0 if not registered. A content match also registers the path, so the next lookup
+// hits directly.
+GLuint texture_registry_find(const char* canonical_path, uint64_t content_hash);
+
+// Register a freshly uploaded texture and return it with one reference. If the same path or content was
+// registered in the meantime, the existing texture is returned instead and texture_id is deleted.
+GLuint texture_registry_add(const char* canonical_path, uint64_t content_hash, GLuint texture_id, int width, int height, size_t gpu_bytes);
+
+// Reference counting (ids that are not registered, or whose last reference is being released, are ignored)
+void texture_registry_retain(GLuint texture_id);
+void texture_registry_release(GLuint texture_id);
+uint32_t texture_registry_refcount(GLuint texture_id);
+
+// Dimensions a texture was registered with, false when it is not registered
+bool texture_registry_size(GLuint texture_id, int* width, int* height);
+
+// GPU memory accounting
+size_t texture_registry_gpu_bytes(GLuint texture_id);
+size_t texture_registry_total_gpu_bytes();
+uint32_t texture_registry_count();
+void texture_registry_report();
+
+// Call once on the main thread before any other registry function (before the job workers start)
+void texture_registry_init();
+
+// Delete whatever is still registered (reports leaked references)
+void texture_registry_shutdown();
+
+#endif // TEXTURE_REGISTRY_H
@@ -1 +1,4 @@
-char* read_file(const char* filePath);
\ No newline at end of file
+#include <stddef.h>
+
+char* read_file(const char* filePath);
+unsigned char* read_file_bytes(const char* filePath, size_t* size); // Binary-safe, also null-terminated
\ No newline at end of file
@@ -3,19 +3,38 @@
 
 #include <GLFW/glfw3.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
-// Define a simple key-value pair for the scene state
-typedef struct KeyValuePair {
-    char *key;    // The key (name of the variable)
-    char *value;  // The value (stored as a string for simplicity)
-} KeyValuePair;
+// Scene state: keys are interned once, at registration, into integer slots. Values are typed and packed by slot,
+// so reading or writing one every frame is an array access. Each value has a version bumped when it actually
+// changes, so text built from a value only needs reformatting when the version moves on.
+typedef int StateSlot; // -1 when the key is not registered
+
+typedef enum {
+    STATE_INT,
+    STATE_FLOAT,
+    STATE_BOOL,
+    STATE_VEC4      // Also holds vec2 / vec3, unused components stay 0
+} StateType;
+
+typedef struct {
+    StateType type;
+    uint32_t version;   // 1 on registration, bumped on every change
+    union {
+        int i;
+        float f;
+        bool b;
+        float v[4];
+    };
+} StateValue;
 
-// Define the scene state structure
 typedef struct SceneState {
-    KeyValuePair *data;  // Array of key-value pairs
-    size_t count;        // Number of key-value pairs
+    char **keys;         // Interned key per slot
+    StateValue *values;  // Packed by slot
+    size_t count;
+    size_t capacity;     // Grows by doubling
 } SceneState;
 
 // Define the Scene structure
@@ -23,6 +42,7 @@ typedef struct Scene {
     char* name;
     GLFWwindow* window;
     SceneState state;
+    bool resident;       // Setup ran and every asset it queued is finalized (set by the scene manager)
 
     void (*update)(struct Scene* self);
     void (*render)(struct Scene* self);
@@ -33,9 +53,20 @@ typedef struct Scene {
 Scene *scene_create(const char *name, GLFWwindow *window);
 void scene_destroy(Scene *scene);
 
-// State management functions
-bool scene_state_set(SceneState *state, const char *key, const char *value);
-const char *scene_state_get(const SceneState *state, const char *key);
+// State registration, done once at setup. Registering a key again returns its slot when the type matches, -1 otherwise.
+StateSlot scene_state_register(SceneState *state, const char *key, StateType type);
+StateSlot scene_state_find(const SceneState *state, const char *key);
+
+// Typed access by slot. Setters return false for an unknown slot or another type, getters return 0.
+bool scene_state_set_int(SceneState *state, StateSlot slot, int value);
+bool scene_state_set_float(SceneState *state, StateSlot slot, float value);
+bool scene_state_set_bool(SceneState *state, StateSlot slot, bool value);
+bool scene_state_set_vec4(SceneState *state, StateSlot slot, const float value[4]);
+int scene_state_get_int(const SceneState *state, StateSlot slot);
+float scene_state_get_float(const SceneState *state, StateSlot slot);
+bool scene_state_get_bool(const SceneState *state, StateSlot slot);
+const float *scene_state_get_vec4(const SceneState *state, StateSlot slot);
+uint32_t scene_state_version(const SceneState *state, StateSlot slot); // 0 for an unknown slot
 
 // Scene management functions
 void scene_update(Scene *scene);
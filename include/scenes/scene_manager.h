@@ -0,0 +1,36 @@
+#ifndef SCENE_MANAGER_H
+#define SCENE_MANAGER_H
+
+#include <scenes/scene.h>
+
+// Scene stack with background loading. push / replace only queue a transition: the new scene's setup (its render
+// callback) runs on a later frame, after the current scene has been shown, and its queued assets load while the
+// current scene keeps running. The switch happens once everything the setup requested has been finalized, so the
+// first frame of the new scene never waits on a load. pop is immediate (at the next update), the scene below is
+// still resident. Main thread only.
+
+#define SCENE_MANAGER_MAX_DEPTH 8    // Scenes on the stack
+#define SCENE_MANAGER_MAX_PENDING 8  // Queued transitions
+
+typedef enum {
+    SCENE_TRANSITION_NONE,       // Nothing queued
+    SCENE_TRANSITION_PENDING,    // Queued, setup not started yet
+    SCENE_TRANSITION_LOADING,    // Setup done, its assets are loading behind the current scene
+    SCENE_TRANSITION_READY       // Resident, switched to at the next update
+} SceneTransition;
+
+// Transitions apply in the order they were requested, false when the queue is full
+bool scene_manager_push(Scene *scene);     // The current scene stays resident underneath
+bool scene_manager_replace(Scene *scene);  // The current scene is cleaned up after the switch
+bool scene_manager_pop();                  // Cleans up the current scene and resumes the one below
+
+// Once per frame, after assets_update: starts and applies transitions, then updates the current scene
+void scene_manager_update();
+
+Scene *scene_manager_current();                 // NULL before the first scene is resident
+SceneTransition scene_manager_transition();     // State of the oldest queued transition
+
+// Cleans up every scene that was set up, on the stack or still loading (call after assets_shutdown)
+void scene_manager_shutdown();
+
+#endif // SCENE_MANAGER_H
@@ -20,6 +20,7 @@ typedef struct {
 } Skybox;
 
 void skybox_init(Skybox* skybox, const char* source[6], size_t program_id);
+void skybox_init_from_texture(Skybox* skybox, GLuint texture_id, size_t program_id); // Cubemap already uploaded
 void skybox_use(Skybox* skybox, mat4 projection, mat4 view, mat4 model);
 void skybox_destroy(Skybox* skybox);
 
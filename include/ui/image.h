@@ -12,12 +12,14 @@ typedef struct {
     GLuint shader_program;
     Buffers buffers;
     int width, height;
+    bool registry_texture;  // A reference from the texture registry (image_init), otherwise owned
 	float rotation;
 	bool model_dirty;
 } Image;
 
 // Function prototypes
-void image_init(Image *image, const char *image_path, GLuint shader_program);
+void image_init(Image *image, const char *image_path, GLuint shader_program); // Shares the texture with other images of the file
+void image_init_from_texture(Image *image, GLuint texture_id, int width, int height, GLuint shader_program); // Takes ownership of the texture
 void image_set_dimensions(Image *image, int new_width, int new_height);
 void image_set_dimensions_by_shader(Image *image, float new_width, float new_height);
 void image_set_rotation_by_shader_dirty(Image *image, float angle_degrees);
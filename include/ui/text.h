@@ -5,24 +5,30 @@
 #include <glad/glad.h>
 #include <stb_truetype.h>
 
-typedef struct {
-    GLuint texture_id;
-    int width, height;
-    int x_offset, y_offset;
-    int advance;
-} Character;
+// Text is UTF-8 and drawn from one signed distance field atlas per font file, generated at FONT_SDF_PIXEL_HEIGHT
+// and scaled to any size by the text shader. Atlases are shared between Fonts of the same file (whatever their size).
+// Printable ASCII is generated up front and cached on disk in cache/fonts, keyed by the hash of the font file; any
+// other glyph is generated the first time it is measured or drawn. When the atlas is full the least recently drawn
+// glyphs make room. Kerning from the font is applied between glyphs.
+
+#define FONT_SDF_PIXEL_HEIGHT 48.0f // Glyph size the distance field is generated at
+#define FONT_SDF_PADDING 6          // Distance field spread around each glyph, in atlas pixels
+
+typedef struct FontAtlas FontAtlas;
 
 typedef struct {
-    Character characters[128]; // ASCII characters
+    FontAtlas *atlas;        // Shared, NULL when initialization failed
     float size;
 	float scalar;
     GLuint VAO, VBO;
+    size_t vertex_capacity;  // Vertices the VBO holds
     GLuint shader_program;
 } Font;
 
 void font_init(Font *font, const char *font_path, float font_size, float space_scalar, GLuint shader_program);
+void font_init_from_memory(Font *font, const unsigned char *font_buffer, size_t font_buffer_size, float font_size, float space_scalar, GLuint shader_program); // TTF data already in memory
 void font_get_text_dimensions(Font *font, const char *text, float *width, float *height);
 void font_render_text(Font *font, const char *text, float x, float y, vec3 color);
 void font_cleanup(Font *font);
 
-#endif
\ No newline at end of file
+#endif
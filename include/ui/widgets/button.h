@@ -21,7 +21,7 @@ typedef struct {
     vec4 bg_color;             // Background color (if BUTTON_TYPE_COLOR)
     vec3 text_color;           // Text color
     const char *text;           // Button label text
-    Font font;                  // Font used for button text
+    Font *font;                 // Font used for button text (borrowed, must outlive the button)
     float text_offset_x, text_offset_y;  // Text offset for positioning
     Buffers buffers;          // Buffers (VAO, VBO, etc.) for button geometry
 	bool hovered;
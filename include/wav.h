@@ -1,6 +1,36 @@
+#ifndef WAV_H
+#define WAV_H
+
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <AL/al.h>
 
-bool load_wav(const char* filename, ALenum* format, ALvoid** data, ALsizei* size, ALsizei* freq);
\ No newline at end of file
+// Layout of a RIFF/WAVE file, samples points into the parsed data
+typedef struct {
+    uint16_t audio_format;     // 1 = PCM, 3 = float (resolved from the sub-format of extensible files)
+    uint16_t num_channels;
+    uint32_t sample_rate;
+    uint16_t block_align;      // Bytes per frame
+    uint16_t bits_per_sample;
+    const unsigned char* samples;
+    size_t samples_size;       // Whole frames only
+} WavInfo;
+
+// Decode a WAV file (8/16/24/32-bit PCM or 32-bit float, any channel count) to 16-bit mono, from its mapping
+bool load_wav(const char* filename, ALenum* format, ALvoid** data, ALsizei* size, ALsizei* freq);
+
+// Walk the chunks of a WAV file in memory, the fmt and data chunks may come in any order
+bool wav_parse(const unsigned char* data, size_t size, WavInfo* info);
+bool wav_supported(const WavInfo* info);
+
+// 16-bit mono samples (malloc'd), resampled when target_rate is not 0 and differs from the file's
+bool wav_decode_mono(const WavInfo* info, uint32_t target_rate, int16_t** samples, size_t* frames);
+
+// Conversion kernels (SSE2, SSSE3 for 24-bit, scalar elsewhere). dest may alias src for the downmix.
+void wav_convert_s16(const WavInfo* info, const unsigned char* src, size_t frames, int16_t* dest); // Keeps channels interleaved
+void wav_downmix_s16(const int16_t* src, size_t frames, int channels, int16_t* dest);
+void wav_resample_s16(const int16_t* src, size_t frames, uint32_t src_rate, uint32_t dst_rate, int16_t* dest); // Mono, linear
+size_t wav_resampled_frames(size_t frames, uint32_t src_rate, uint32_t dst_rate);
+
+#endif // WAV_H
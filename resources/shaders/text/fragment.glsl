@@ -7,11 +7,13 @@ uniform sampler2D text;
 uniform vec3 textColor;
 
 void main() {
-    // Get the alpha from the texture (assuming it’s a grayscale texture where R=G=B=A)
-    float alpha = texture(text, TexCoords).r;
-	
+    // Signed distance field: 0.5 is the glyph outline, the edge is smoothed over about one screen pixel at any size
+    float distance = texture(text, TexCoords).r;
+    float smoothing = max(fwidth(distance), 1e-4);
+    float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+
     // If alpha is 0, discard the fragment (improves performance for transparent parts)
-    if (alpha < 0.1) {
+    if (alpha < 0.01) {
         discard;
     }
 
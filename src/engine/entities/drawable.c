@@ -1,4 +1,6 @@
 #include <entities/drawable.h>
+#include <entities/transform.h>
+#include <entities/mesh_baked.h>
 #include <glad/glad.h>
 
 #include <stdlib.h>
@@ -12,33 +14,50 @@ void draw_manager_init_from_mesh(Drawable* p_drawable, Mesh* mesh, const char* n
     DrawableMesh* new_mesh = &p_drawable->meshes[p_drawable->mesh_count++];
     new_mesh->mesh = mesh;
     new_mesh->name = name;  // Set the name of the mesh
+    new_mesh->index_type = GL_UNSIGNED_INT;
 
     // Initialize the buffers for the mesh
     new_mesh->buffers = buffers_create_empty();
     buffers_bind_vao(new_mesh->buffers.VAO);
 
-    // Load vertex positions (VBO)
-    new_mesh->buffers.VBO = buffers_create_vbo(mesh->vertices, mesh->vertex_count * 3);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // Load normals (if available)
-    if (mesh->normals) {
-        new_mesh->buffers.NormalVBO = buffers_create_vbo(mesh->normals, mesh->vertex_count * 3);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
+    if (mesh->vertex_data) {
+        // Baked mesh: one interleaved buffer and the indices, both straight from the mapped file
+        new_mesh->buffers.VBO = buffers_create_storage(GL_ARRAY_BUFFER, mesh->vertex_data, sizeof(MeshBakedVertex) * mesh->vertex_count);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MeshBakedVertex), (void*)offsetof(MeshBakedVertex, position));
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(MeshBakedVertex), (void*)offsetof(MeshBakedVertex, normal));
         glEnableVertexAttribArray(1);
-    }
-
-    // Load texture coordinates (if available)
-    if (mesh->texcoords) {
-        new_mesh->buffers.TexCoordVBO = buffers_create_vbo(mesh->texcoords, mesh->vertex_count * 2);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(MeshBakedVertex), (void*)offsetof(MeshBakedVertex, texcoord));
         glEnableVertexAttribArray(2);
-    }
 
-    // Load indices (if available)
-    if (mesh->indices) {
-        new_mesh->buffers.EBO = buffers_create_ebo(mesh->indices, mesh->index_count);
+        if (mesh->index_data) {
+            new_mesh->buffers.EBO = buffers_create_storage(GL_ELEMENT_ARRAY_BUFFER, mesh->index_data, (size_t)mesh->index_size * mesh->index_count);
+            new_mesh->index_type = mesh->index_size == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        }
+    } else {
+        // Load vertex positions (VBO)
+        new_mesh->buffers.VBO = buffers_create_vbo(mesh->vertices, mesh->vertex_count * 3);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
+        glEnableVertexAttribArray(0);
+
+        // Load normals (if available)
+        if (mesh->normals) {
+            new_mesh->buffers.NormalVBO = buffers_create_vbo(mesh->normals, mesh->vertex_count * 3);
+            glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
+            glEnableVertexAttribArray(1);
+        }
+
+        // Load texture coordinates (if available)
+        if (mesh->texcoords) {
+            new_mesh->buffers.TexCoordVBO = buffers_create_vbo(mesh->texcoords, mesh->vertex_count * 2);
+            glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
+            glEnableVertexAttribArray(2);
+        }
+
+        // Load indices (if available)
+        if (mesh->indices) {
+            new_mesh->buffers.EBO = buffers_create_ebo(mesh->indices, mesh->index_count);
+        }
     }
 
     // Unbind VAO after setup
@@ -50,6 +69,7 @@ void draw_manager_init_from_mesh(Drawable* p_drawable, Mesh* mesh, const char* n
     glm_vec3_zero(p_drawable->translation);
     glm_vec3_one(p_drawable->scale);
     glm_vec3_zero(p_drawable->rotation);
+    p_drawable->model_dirty = false;  // Identity already matches the defaults
 }
 
 // Draws a specific mesh in the drawable object by its name
@@ -70,37 +90,11 @@ void draw_manager_draw(Drawable* drawable, const char* mesh_name) {
         return;  // Mesh with the specified name not found
     }
 
-    // Apply transformations to the model matrix
-    mat4 modelMatrix;
-    glm_mat4_identity(modelMatrix);
-
-    // Apply translation
-    mat4 translation_matrix;
-    glm_translate_make(translation_matrix, drawable->translation);  // Create translation matrix
-    glm_mat4_mul(modelMatrix, translation_matrix, modelMatrix);      // Apply translation
-
-    // Apply scaling
-    mat4 scale_matrix;
-    glm_scale_make(scale_matrix, drawable->scale);  // Create scaling matrix
-    glm_mat4_mul(modelMatrix, scale_matrix, modelMatrix);  // Apply scaling
-
-    // Apply rotation (assuming rotation is in Euler angles)
-    mat4 rotation_matrix;
-
-    // Apply rotation on X-axis (Pitch)
-    glm_rotate_make(rotation_matrix, glm_rad(drawable->rotation[0]), (vec3){1.0f, 0.0f, 0.0f});
-    glm_mat4_mul(modelMatrix, rotation_matrix, modelMatrix);
-
-    // Apply rotation on Y-axis (Yaw)
-    glm_rotate_make(rotation_matrix, glm_rad(drawable->rotation[1]), (vec3){0.0f, 1.0f, 0.0f});
-    glm_mat4_mul(modelMatrix, rotation_matrix, modelMatrix);
-
-    // Apply rotation on Z-axis (Roll)
-    glm_rotate_make(rotation_matrix, glm_rad(drawable->rotation[2]), (vec3){0.0f, 0.0f, 1.0f});
-    glm_mat4_mul(modelMatrix, rotation_matrix, modelMatrix);
-
-    // Now copy the combined modelMatrix to drawable->model_matrix
-    glm_mat4_copy(modelMatrix, drawable->model_matrix);
+    // Recompose the model matrix (translate * scale * rotate) only when it changed
+    if (drawable->model_dirty) {
+        transform_compose_euler(drawable->translation, drawable->rotation, drawable->scale, drawable->model_matrix);
+        drawable->model_dirty = false;
+    }
 
     buffers_bind_vao(mesh_to_draw->buffers.VAO);
 
@@ -120,7 +114,7 @@ void draw_manager_draw(Drawable* drawable, const char* mesh_name) {
     // Bind EBO if it exists
     if (mesh_to_draw->buffers.EBO) {
         buffers_bind_ebo(mesh_to_draw->buffers.EBO);
-        glDrawElements(GL_TRIANGLES, mesh_to_draw->mesh->index_count, GL_UNSIGNED_INT, 0);
+        glDrawElements(GL_TRIANGLES, mesh_to_draw->mesh->index_count, mesh_to_draw->index_type, 0);
     } else {
         glDrawArrays(GL_TRIANGLES, 0, mesh_to_draw->mesh->vertex_count);
     }
@@ -133,21 +127,30 @@ void draw_manager_draw(Drawable* drawable, const char* mesh_name) {
 void draw_manager_translate(Drawable* drawable, vec3 translation) {
     if (!drawable) return;
 
+    if (glm_vec3_eqv(translation, drawable->translation)) return;
+
     glm_vec3_copy(translation, drawable->translation);
+    drawable->model_dirty = true;
 }
 
 // Applies scaling to the drawable object
 void draw_manager_scale(Drawable* drawable, vec3 scale) {
     if (!drawable) return;
 
+    if (glm_vec3_eqv(scale, drawable->scale)) return;
+
     glm_vec3_copy(scale, drawable->scale);
+    drawable->model_dirty = true;
 }
 
 // Applies rotation to the drawable object
 void draw_manager_rotate(Drawable* drawable, vec3 rotation) {
     if (!drawable) return;
 
+    if (glm_vec3_eqv(rotation, drawable->rotation)) return;
+
     glm_vec3_copy(rotation, drawable->rotation);
+    drawable->model_dirty = true;
 }
 
 // Cleans up drawable buffers
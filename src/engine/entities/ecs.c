@@ -5,39 +5,92 @@
 
 // Initialize the ECS
 void ecs_init(ECS* ecs) {
+    ecs->entities = NULL;
+    ecs->component_masks = NULL;
+    ecs->free_entities = NULL;
     ecs->entity_count = 0;
+    ecs->entity_capacity = 0;
+    ecs->free_count = 0;
     for (size_t i = 0; i < MAX_COMPONENTS; ++i) {
         ecs->components[i].data = NULL;
         ecs->components[i].size = 0;
         ecs->components[i].count = 0;
         ecs->components[i].capacity = 0;
     }
-    memset(ecs->entity_component_mask, 0, sizeof(ecs->entity_component_mask));
+}
+
+// Free all entity and component storage
+void ecs_free(ECS* ecs) {
+    for (size_t i = 0; i < MAX_COMPONENTS; ++i) {
+        free(ecs->components[i].data);
+    }
+    free(ecs->entities);
+    free(ecs->component_masks);
+    free(ecs->free_entities);
+    ecs_init(ecs);
+}
+
+// Grow the entity tables (IDs, masks and free list share one capacity)
+static bool ecs_grow_entities(ECS* ecs) {
+    size_t capacity = ecs->entity_capacity ? ecs->entity_capacity * 2 : ECS_INITIAL_CAPACITY;
+    if (capacity > MAX_ENTITIES) capacity = MAX_ENTITIES;
+
+    Entity* entities = realloc(ecs->entities, sizeof(Entity) * capacity);
+    if (entities) ecs->entities = entities;
+    uint32_t* masks = realloc(ecs->component_masks, sizeof(uint32_t) * capacity);
+    if (masks) ecs->component_masks = masks;
+    Entity* free_entities = realloc(ecs->free_entities, sizeof(Entity) * capacity);
+    if (free_entities) ecs->free_entities = free_entities;
+
+    if (!entities || !masks || !free_entities) {
+        fprintf(stderr, "Error: Failed to grow entity storage!\n");
+        return false;
+    }
+    ecs->entity_capacity = capacity;
+    return true;
 }
 
 // Create a new entity
 Entity ecs_create_entity(ECS* ecs) {
+    // Reuse a destroyed ID first
+    if (ecs->free_count > 0) {
+        Entity entity = ecs->free_entities[--ecs->free_count];
+        ecs->entities[entity] = entity;
+        return entity;
+    }
+
     if (ecs->entity_count >= MAX_ENTITIES) {
         fprintf(stderr, "Error: Maximum number of entities reached!\n");
         return UINT32_MAX;
     }
+    if (ecs->entity_count >= ecs->entity_capacity && !ecs_grow_entities(ecs)) {
+        return UINT32_MAX;
+    }
     Entity entity = ecs->entity_count++;
     ecs->entities[entity] = entity;
+    ecs->component_masks[entity] = 0;
     return entity;
 }
 
 // Destroy an entity
 void ecs_destroy_entity(ECS* ecs, Entity entity) {
-    if (entity >= ecs->entity_count) {
+    if (!ecs_is_alive(ecs, entity)) {
         fprintf(stderr, "Error: Invalid entity ID!\n");
         return;
     }
-    for (size_t i = 0; i < MAX_COMPONENTS; ++i) {
-        if (ecs->entity_component_mask[entity][i]) {
+    uint32_t mask = ecs->component_masks[entity];
+    for (size_t i = 0; mask; ++i, mask >>= 1) {
+        if (mask & 1u) {
             ecs_remove_component(ecs, entity, i);
         }
     }
     ecs->entities[entity] = UINT32_MAX; // Mark entity as destroyed
+    ecs->free_entities[ecs->free_count++] = entity;
+}
+
+// Check whether an entity ID refers to a live entity
+bool ecs_is_alive(const ECS* ecs, Entity entity) {
+    return entity < ecs->entity_count && ecs->entities[entity] == entity;
 }
 
 // Register a component type
@@ -61,20 +114,32 @@ void* ecs_add_component(ECS* ecs, Entity entity, size_t component_id) {
         fprintf(stderr, "Error: Invalid component ID!\n");
         return NULL;
     }
-    if (ecs->entity_component_mask[entity][component_id]) {
+    if (!ecs_is_alive(ecs, entity)) {
+        fprintf(stderr, "Error: Invalid entity ID!\n");
+        return NULL;
+    }
+    if (ecs->component_masks[entity] & ECS_COMPONENT_BIT(component_id)) {
         fprintf(stderr, "Error: Entity already has this component!\n");
         return NULL;
     }
 
+    // Components are stored at the entity's index, grow until it fits
     ComponentArray* array = &ecs->components[component_id];
-    if (array->count >= array->capacity) {
-        array->capacity *= 2;
-        array->data = realloc(array->data, array->size * array->capacity);
+    if (entity >= array->capacity) {
+        size_t capacity = array->capacity;
+        while (capacity <= entity) capacity *= 2;
+        void* data = realloc(array->data, array->size * capacity);
+        if (!data) {
+            fprintf(stderr, "Error: Failed to grow component storage!\n");
+            return NULL;
+        }
+        array->data = data;
+        array->capacity = capacity;
     }
-    void* component = (char*)array->data + (array->count * array->size);
+    void* component = (char*)array->data + (entity * array->size);
     memset(component, 0, array->size); // Initialize to zero
     array->count++;
-    ecs->entity_component_mask[entity][component_id] = true;
+    ecs->component_masks[entity] |= ECS_COMPONENT_BIT(component_id);
     return component;
 }
 
@@ -84,7 +149,7 @@ void* ecs_get_component(ECS* ecs, Entity entity, size_t component_id) {
         fprintf(stderr, "Error: Invalid component ID!\n");
         return NULL;
     }
-    if (!ecs->entity_component_mask[entity][component_id]) {
+    if (!ecs_has_component(ecs, entity, component_id)) {
         return NULL; // Entity does not have this component
     }
     ComponentArray* array = &ecs->components[component_id];
@@ -97,11 +162,18 @@ void ecs_remove_component(ECS* ecs, Entity entity, size_t component_id) {
         fprintf(stderr, "Error: Invalid component ID!\n");
         return;
     }
-    if (!ecs->entity_component_mask[entity][component_id]) {
+    if (!ecs_has_component(ecs, entity, component_id)) {
         fprintf(stderr, "Error: Entity does not have this component!\n");
         return;
     }
-    ecs->entity_component_mask[entity][component_id] = false;
+    ecs->component_masks[entity] &= ~ECS_COMPONENT_BIT(component_id);
+    ecs->components[component_id].count--;
+}
+
+// Check whether an entity has a specific component
+bool ecs_has_component(const ECS* ecs, Entity entity, size_t component_id) {
+    if (entity >= ecs->entity_count || component_id >= MAX_COMPONENTS) return false;
+    return (ecs->component_masks[entity] & ECS_COMPONENT_BIT(component_id)) != 0;
 }
 
 // Apply a system to all entities with a specific component
@@ -112,9 +184,41 @@ void ecs_for_each(ECS* ecs, size_t component_id, void (*callback)(Entity, void*)
     }
     ComponentArray* array = &ecs->components[component_id];
     for (size_t i = 0; i < ecs->entity_count; ++i) {
-        if (ecs->entity_component_mask[i][component_id]) {
+        if (ecs->component_masks[i] & ECS_COMPONENT_BIT(component_id)) {
             void* component = (char*)array->data + (i * array->size);
             callback(i, component);
         }
     }
-}
\ No newline at end of file
+}
+
+// Apply a system with caller context (e.g. a command buffer) to all entities with a specific component
+void ecs_for_each_ctx(ECS* ecs, size_t component_id, void (*callback)(Entity, void*, void*), void* ctx) {
+    if (component_id >= MAX_COMPONENTS || ecs->components[component_id].data == NULL) {
+        fprintf(stderr, "Error: Invalid component ID!\n");
+        return;
+    }
+    ComponentArray* array = &ecs->components[component_id];
+    for (size_t i = 0; i < ecs->entity_count; ++i) {
+        if (ecs->component_masks[i] & ECS_COMPONENT_BIT(component_id)) {
+            void* component = (char*)array->data + (i * array->size);
+            callback(i, component, ctx);
+        }
+    }
+}
+
+// Apply a system to all entities owning every component in the mask
+void ecs_for_each_mask(ECS* ecs, uint32_t mask, void (*callback)(Entity, void*), void* ctx) {
+    ecs_for_each_mask_range(ecs, mask, 0, ecs->entity_count, callback, ctx);
+}
+
+// Same as ecs_for_each_mask, limited to entity IDs in [begin, end)
+void ecs_for_each_mask_range(ECS* ecs, uint32_t mask, size_t begin, size_t end, void (*callback)(Entity, void*), void* ctx) {
+    if (end > ecs->entity_count) end = ecs->entity_count;
+
+    const uint32_t* masks = ecs->component_masks;
+    for (size_t i = begin; i < end; ++i) {
+        if ((masks[i] & mask) == mask && ecs->entities[i] == i) {
+            callback((Entity)i, ctx);
+        }
+    }
+}
@@ -0,0 +1,313 @@
+#include <entities/ecs_commands.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define PROVISIONAL_INDEX_BITS 20
+#define PROVISIONAL_INDEX_MASK (ECS_PROVISIONAL_PER_SYNC - 1)
+
+// Sort entry referencing a recorded command
+typedef struct {
+    Entity entity;
+    uint32_t buffer;
+    uint32_t command;
+} PlaybackEntry;
+
+bool ecs_commands_init(EcsCommandQueue* queue, size_t thread_count) {
+    memset(queue, 0, sizeof(EcsCommandQueue));
+
+    if (thread_count == 0 || thread_count > ECS_PROVISIONAL_BUFFERS) {
+        fprintf(stderr, "Error: Invalid command buffer count %zu!\n", thread_count);
+        return false;
+    }
+
+    queue->buffers = calloc(thread_count, sizeof(EcsCommandBuffer));
+    if (!queue->buffers) {
+        fprintf(stderr, "Error: Failed to allocate command buffers!\n");
+        return false;
+    }
+
+    queue->buffer_count = thread_count;
+    for (size_t i = 0; i < thread_count; ++i) {
+        queue->buffers[i].index = (uint32_t)i;
+    }
+    return true;
+}
+
+void ecs_commands_free(EcsCommandQueue* queue) {
+    if (!queue) return;
+
+    for (size_t i = 0; i < queue->buffer_count; ++i) {
+        free(queue->buffers[i].commands);
+        free(queue->buffers[i].payload);
+        free(queue->buffers[i].resolved);
+    }
+    free(queue->buffers);
+    free(queue->scratch);
+    memset(queue, 0, sizeof(EcsCommandQueue));
+}
+
+EcsCommandBuffer* ecs_commands_buffer(EcsCommandQueue* queue, size_t thread_index) {
+    if (thread_index >= queue->buffer_count) {
+        fprintf(stderr, "Error: Invalid command buffer index %zu!\n", thread_index);
+        return NULL;
+    }
+    return &queue->buffers[thread_index];
+}
+
+// Append a command, growing the buffer geometrically
+static EcsCommand* push_command(EcsCommandBuffer* buffer, EcsCommandType type, Entity entity, size_t component_id) {
+    if (buffer->count >= buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity * 2 : 64;
+        EcsCommand* commands = realloc(buffer->commands, sizeof(EcsCommand) * capacity);
+        if (!commands) {
+            fprintf(stderr, "Error: Failed to grow command buffer!\n");
+            return NULL;
+        }
+        buffer->commands = commands;
+        buffer->capacity = capacity;
+    }
+
+    EcsCommand* command = &buffer->commands[buffer->count++];
+    command->type = (uint8_t)type;
+    command->component_id = (uint8_t)component_id;
+    command->entity = entity;
+    command->payload_offset = 0;
+    command->payload_size = 0;
+    return command;
+}
+
+Entity ecs_cmd_create(EcsCommandBuffer* buffer) {
+    if (buffer->created >= ECS_PROVISIONAL_PER_SYNC) {
+        fprintf(stderr, "Error: Too many deferred entity creations before playback!\n");
+        return UINT32_MAX;
+    }
+
+    Entity provisional = ECS_PROVISIONAL_BIT | (buffer->index << PROVISIONAL_INDEX_BITS) | buffer->created;
+    if (!push_command(buffer, ECS_CMD_CREATE, provisional, 0)) return UINT32_MAX;
+
+    buffer->created++;
+    return provisional;
+}
+
+void ecs_cmd_destroy(EcsCommandBuffer* buffer, Entity entity) {
+    push_command(buffer, ECS_CMD_DESTROY, entity, 0);
+}
+
+void ecs_cmd_add(EcsCommandBuffer* buffer, Entity entity, size_t component_id, const void* data, size_t size) {
+    if (component_id >= MAX_COMPONENTS) {
+        fprintf(stderr, "Error: Invalid component ID!\n");
+        return;
+    }
+
+    // Copy the initial data into the buffer's arena (8-byte aligned)
+    size_t offset = (buffer->payload_size + 7) & ~(size_t)7;
+    if (data && size) {
+        if (offset + size > buffer->payload_capacity) {
+            size_t capacity = buffer->payload_capacity ? buffer->payload_capacity : 1024;
+            while (capacity < offset + size) capacity *= 2;
+            unsigned char* payload = realloc(buffer->payload, capacity);
+            if (!payload) {
+                fprintf(stderr, "Error: Failed to grow command payload arena!\n");
+                return;
+            }
+            buffer->payload = payload;
+            buffer->payload_capacity = capacity;
+        }
+        memcpy(buffer->payload + offset, data, size);
+    }
+
+    EcsCommand* command = push_command(buffer, ECS_CMD_ADD, entity, component_id);
+    if (!command) return;
+
+    if (data && size) {
+        command->payload_offset = (uint32_t)offset;
+        command->payload_size = (uint32_t)size;
+        buffer->payload_size = offset + size;
+    }
+}
+
+void ecs_cmd_remove(EcsCommandBuffer* buffer, Entity entity, size_t component_id) {
+    if (component_id >= MAX_COMPONENTS) {
+        fprintf(stderr, "Error: Invalid component ID!\n");
+        return;
+    }
+    push_command(buffer, ECS_CMD_REMOVE, entity, component_id);
+}
+
+// Order by entity, then by recording order (buffer index, then position in the buffer)
+static int compare_entries(const void* a, const void* b) {
+    const PlaybackEntry* lhs = (const PlaybackEntry*)a;
+    const PlaybackEntry* rhs = (const PlaybackEntry*)b;
+
+    if (lhs->entity != rhs->entity) return lhs->entity < rhs->entity ? -1 : 1;
+    if (lhs->buffer != rhs->buffer) return lhs->buffer < rhs->buffer ? -1 : 1;
+    if (lhs->command != rhs->command) return lhs->command < rhs->command ? -1 : 1;
+    return 0;
+}
+
+static Entity* provisional_slot(EcsCommandQueue* queue, Entity provisional) {
+    uint32_t buffer_index = (provisional & ~ECS_PROVISIONAL_BIT) >> PROVISIONAL_INDEX_BITS;
+    uint32_t index = provisional & PROVISIONAL_INDEX_MASK;
+    if (buffer_index >= queue->buffer_count) return NULL;
+
+    EcsCommandBuffer* buffer = &queue->buffers[buffer_index];
+    if (index >= buffer->created) return NULL;
+    return &buffer->resolved[index];
+}
+
+size_t ecs_commands_playback(EcsCommandQueue* queue, ECS* ecs) {
+    size_t total = 0;
+    for (size_t b = 0; b < queue->buffer_count; ++b) {
+        EcsCommandBuffer* buffer = &queue->buffers[b];
+        total += buffer->count;
+
+        // Make room for this sync's provisional -> real mapping
+        if (buffer->created > buffer->resolved_capacity) {
+            Entity* resolved = realloc(buffer->resolved, sizeof(Entity) * buffer->created);
+            if (!resolved) {
+                fprintf(stderr, "Error: Failed to allocate provisional entity table!\n");
+                return 0;
+            }
+            buffer->resolved = resolved;
+            buffer->resolved_capacity = buffer->created;
+        }
+        for (uint32_t i = 0; i < buffer->created; ++i) buffer->resolved[i] = UINT32_MAX;
+    }
+
+    if (total > queue->scratch_capacity) {
+        void* scratch = realloc(queue->scratch, sizeof(PlaybackEntry) * total);
+        if (!scratch) {
+            fprintf(stderr, "Error: Failed to allocate command playback scratch!\n");
+            return 0;
+        }
+        queue->scratch = scratch;
+        queue->scratch_capacity = total;
+    }
+
+    // Gather every command from every thread and sort them by entity
+    PlaybackEntry* entries = (PlaybackEntry*)queue->scratch;
+    size_t entry_count = 0;
+    for (size_t b = 0; b < queue->buffer_count; ++b) {
+        EcsCommandBuffer* buffer = &queue->buffers[b];
+        for (size_t c = 0; c < buffer->count; ++c) {
+            entries[entry_count].entity = buffer->commands[c].entity;
+            entries[entry_count].buffer = (uint32_t)b;
+            entries[entry_count].command = (uint32_t)c;
+            entry_count++;
+        }
+    }
+    qsort(entries, entry_count, sizeof(PlaybackEntry), compare_entries);
+
+    size_t applied = 0;
+    size_t group_start = 0;
+    while (group_start < entry_count) {
+        Entity entity = entries[group_start].entity;
+        size_t group_end = group_start;
+        bool destroyed = false;
+        bool created = false;
+
+        while (group_end < entry_count && entries[group_end].entity == entity) {
+            const EcsCommand* command = &queue->buffers[entries[group_end].buffer].commands[entries[group_end].command];
+            if (command->type == ECS_CMD_DESTROY) destroyed = true;
+            if (command->type == ECS_CMD_CREATE) created = true;
+            group_end++;
+        }
+
+        Entity target = entity;
+        if (ecs_is_provisional(entity)) {
+            Entity* slot = provisional_slot(queue, entity);
+
+            // Created and destroyed before the sync point: never materialize it
+            if (!slot || !created || destroyed) {
+                if (!slot || !created) fprintf(stderr, "Error: Command references unknown provisional entity!\n");
+                group_start = group_end;
+                continue;
+            }
+
+            target = ecs_create_entity(ecs);
+            if (target == UINT32_MAX) {
+                group_start = group_end;
+                continue;
+            }
+            *slot = target;
+            applied++;
+        } else if (!ecs_is_alive(ecs, entity)) {
+            fprintf(stderr, "Error: Deferred command targets a dead entity!\n");
+            group_start = group_end;
+            continue;
+        } else if (destroyed) {
+            // Destruction wins over any other change to the same entity
+            ecs_destroy_entity(ecs, entity);
+            applied++;
+            group_start = group_end;
+            continue;
+        }
+
+        // Only the last add/remove per component matters
+        size_t last[MAX_COMPONENTS];
+        uint32_t touched = 0;
+        for (size_t e = group_start; e < group_end; ++e) {
+            const EcsCommand* command = &queue->buffers[entries[e].buffer].commands[entries[e].command];
+            if (command->type == ECS_CMD_ADD || command->type == ECS_CMD_REMOVE) {
+                last[command->component_id] = e;
+                touched |= 1u << command->component_id;
+            }
+        }
+
+        for (size_t component_id = 0; touched; ++component_id, touched >>= 1) {
+            if (!(touched & 1u)) continue;
+
+            const PlaybackEntry* entry = &entries[last[component_id]];
+            const EcsCommandBuffer* buffer = &queue->buffers[entry->buffer];
+            const EcsCommand* command = &buffer->commands[entry->command];
+            bool has = ecs_has_component(ecs, target, component_id);
+
+            if (command->type == ECS_CMD_REMOVE) {
+                if (has) {
+                    ecs_remove_component(ecs, target, component_id);
+                    applied++;
+                }
+                continue;
+            }
+
+            void* component = has ? ecs_get_component(ecs, target, component_id)
+                                  : ecs_add_component(ecs, target, component_id);
+            if (!component) continue;
+
+            size_t size = ecs->components[component_id].size;
+            if (command->payload_size) {
+                memcpy(component, buffer->payload + command->payload_offset,
+                       command->payload_size < size ? command->payload_size : size);
+            } else if (has) {
+                memset(component, 0, size);
+            }
+            applied++;
+        }
+
+        group_start = group_end;
+    }
+
+    // Reset the buffers for the next frame, keeping their memory
+    for (size_t b = 0; b < queue->buffer_count; ++b) {
+        EcsCommandBuffer* buffer = &queue->buffers[b];
+        buffer->count = 0;
+        buffer->payload_size = 0;
+        buffer->resolved_count = buffer->created;
+        buffer->created = 0;
+    }
+
+    return applied;
+}
+
+Entity ecs_commands_resolve(const EcsCommandQueue* queue, Entity provisional) {
+    if (!ecs_is_provisional(provisional)) return provisional;
+
+    uint32_t buffer_index = (provisional & ~ECS_PROVISIONAL_BIT) >> PROVISIONAL_INDEX_BITS;
+    uint32_t index = provisional & PROVISIONAL_INDEX_MASK;
+    if (buffer_index >= queue->buffer_count) return UINT32_MAX;
+
+    const EcsCommandBuffer* buffer = &queue->buffers[buffer_index];
+    if (index >= buffer->resolved_count) return UINT32_MAX;
+    return buffer->resolved[index];
+}
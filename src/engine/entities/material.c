@@ -1,4 +1,8 @@
 #include <entities/material.h>
+#include <pipeline/texture_registry.h>
+#include <pipeline/texture.h>
+#include <qreader.h>
+#include <hash.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -78,25 +82,8 @@ char *find_file_in_directory(const char *base_dir, const char *target_file) {
     return NULL; // File not found in this directory or its subdirectories
 }
 
-#define MAX_TEXTURES 1024
-
-// Structure to store both the texture path and its OpenGL texture ID
-typedef struct {
-    char* uri;
-    GLuint texture_id;
-} LoadedTexture;
-
-// Array to store the loaded textures
-static LoadedTexture loaded_textures[MAX_TEXTURES];
-static int texture_count = 0;
-
-
 // Function to load a texture from a GLTF texture structure
 GLuint load_texture_from_gltf(cgltf_texture *gltf_texture, const char *model_path) {
-    // Get parent directory from the model path
-    char parent_dir[1024];
-    get_parent_directory(model_path, parent_dir);
-
     // Get the texture URI from the GLTF texture structure
     cgltf_image *gltf_image = gltf_texture->image;
     if (!gltf_image || !gltf_image->uri) {
@@ -104,29 +91,61 @@ GLuint load_texture_from_gltf(cgltf_texture *gltf_texture, const char *model_pat
         return 0;
     }
 
-    // Check if this texture has already been loaded
-    for (int i = 0; i < texture_count; i++) {
-        if (strcmp(loaded_textures[i].uri, gltf_image->uri) == 0) {
-            // Texture is already loaded, return the cached texture ID
-            // printf("[TEXTURE] SKIPPING LOADING (CACHED) TEXTURE WITH PATH \"%s\"\n", gltf_image->uri);
-            return loaded_textures[i].texture_id;
-        }
-    }
+    return load_texture_from_uri(gltf_image->uri, model_path);
+}
+
+// Function to load a texture by its URI, relative to the model's directory.
+// Textures are shared through the texture registry: the returned id carries a reference, release it with material_free.
+GLuint load_texture_from_uri(const char *uri, const char *model_path) {
+    // Get parent directory from the model path
+    char parent_dir[1024];
+    get_parent_directory(model_path, parent_dir);
 
     // Find the texture file in the directory
     char texture_path[1024];
-    snprintf(texture_path, sizeof(texture_path), "%s/%s", parent_dir, gltf_image->uri);
+    snprintf(texture_path, sizeof(texture_path), "%s/%s", parent_dir, uri);
+
+    // Already loaded under this path (by any model)
+    char canonical_path[TEXTURE_PATH_MAX];
+    texture_path_canonical(texture_path, canonical_path, sizeof(canonical_path));
+
+    GLuint texture_id = texture_registry_find(canonical_path, 0);
+    if (texture_id) return texture_id;
+
+    // Baked container next to the image: mip chain uploaded as stored, no decode
+    char baked_path[1024];
+    texture_baked_path(texture_path, baked_path, sizeof(baked_path));
+    Texture baked = texture_create_baked(baked_path, false);
+    if (baked.id) {
+        printf("[TEXTURE] LOADED BAKED TEXTURE WITH PATH \"%s\"\n", uri);
+        return texture_registry_add(canonical_path, 0, baked.id, baked.width, baked.height, baked.gpu_bytes);
+    }
+
+    // Already loaded from an identical file under another path
+    size_t file_size;
+    unsigned char *file_data = read_file_bytes(texture_path, &file_size);
+    if (!file_data) {
+        printf("Failed to load texture data: %s\n", uri);
+        return 0;
+    }
+
+    uint64_t content_hash = hash_bytes(file_data, file_size);
+    texture_id = texture_registry_find(canonical_path, content_hash);
+    if (texture_id) {
+        free(file_data);
+        return texture_id;
+    }
 
     // Load texture data
     int width, height, channels;
-    unsigned char *data = stbi_load(texture_path, &width, &height, &channels, 0);
+    unsigned char *data = stbi_load_from_memory(file_data, (int)file_size, &width, &height, &channels, 0);
+    free(file_data);
     if (!data) {
-        printf("Failed to load texture data: %s\n", gltf_image->uri);
+        printf("Failed to load texture data: %s\n", uri);
         return 0; // Return 0 if texture loading fails
     }
 
     // Generate OpenGL texture
-    GLuint texture_id;
     glGenTextures(1, &texture_id);
     glBindTexture(GL_TEXTURE_2D, texture_id);
 
@@ -137,15 +156,8 @@ GLuint load_texture_from_gltf(cgltf_texture *gltf_texture, const char *model_pat
     glBindTexture(GL_TEXTURE_2D, 0);
     stbi_image_free(data);
 
-    // Cache the loaded texture path and its OpenGL texture ID
-    if (texture_count < MAX_TEXTURES) {
-        loaded_textures[texture_count].uri = strdup(gltf_image->uri); // Copy the texture path into the array
-        loaded_textures[texture_count].texture_id = texture_id; // Store the texture ID
-        texture_count++;
-    }
-
-    printf("[TEXTURE] LOADED TEXTURE WITH PATH \"%s\"\n", gltf_image->uri);
-    return texture_id;
+    printf("[TEXTURE] LOADED TEXTURE WITH PATH \"%s\"\n", uri);
+    return texture_registry_add(canonical_path, content_hash, texture_id, width, height, texture_gpu_bytes(width, height, channels, true));
 }
 
 int material_create_gl_texture(cgltf_texture* texture, MaterialTextureType type, GLuint* texture_id_dest, const char* model_path) {
@@ -212,23 +224,18 @@ void material_apply(const Material* material, GLuint shader_program_id) {
     if (material->roughness) glUniform1f(glGetUniformLocation(shader_program_id, "roughness"), material->roughness);
 }
 
-// Function to free material resources, including GPU textures
+uint32_t material_next_id() {
+    static uint32_t next_id = 0;
+    return ++next_id;
+}
+
+// Function to free material resources, dropping the material's references to its textures
 void material_free(Material* material) {
-    if (material->diffuse_texture_id) {
-        glDeleteTextures(1, &material->diffuse_texture_id);
-    }
-    if (material->normal_texture_id) {
-        glDeleteTextures(1, &material->normal_texture_id);
-    }
-    if (material->metallic_roughness_texture_id) {
-        glDeleteTextures(1, &material->metallic_roughness_texture_id);
-    }
-    if (material->occlusion_texture_id) {
-        glDeleteTextures(1, &material->occlusion_texture_id);
-    }
-    if (material->emissive_texture_id) {
-        glDeleteTextures(1, &material->emissive_texture_id);
-    }
+    texture_registry_release(material->diffuse_texture_id);
+    texture_registry_release(material->normal_texture_id);
+    texture_registry_release(material->metallic_roughness_texture_id);
+    texture_registry_release(material->occlusion_texture_id);
+    texture_registry_release(material->emissive_texture_id);
 
     free(material);
 }
\ No newline at end of file
@@ -20,6 +20,9 @@ Mesh *mesh_create(const char *name) {
     new_mesh->vertex_count = 0;
     new_mesh->indices = NULL;
     new_mesh->index_count = 0;
+    new_mesh->vertex_data = NULL;
+    new_mesh->index_data = NULL;
+    new_mesh->index_size = 0;
 
     glm_vec3_zero(new_mesh->min_bound);  // Default bounding box
     glm_vec3_zero(new_mesh->max_bound);
@@ -29,9 +32,11 @@ Mesh *mesh_create(const char *name) {
     glm_quat_identity(new_mesh->rotation); // Default rotation (identity quaternion)
 
     glm_mat4_identity(new_mesh->transform_matrix); // Default transform matrix
+    new_mesh->transform = TRANSFORM_NONE;          // Not part of a hierarchy yet
 
     // Initialize the material pointer to NULL (set from outside when used)
     new_mesh->material = NULL;
+    new_mesh->material_index = MESH_NO_MATERIAL;
 
     return new_mesh;
 }
@@ -47,22 +52,8 @@ void mesh_set_material(Mesh *mesh, Material *material) {
 void mesh_update_transform_matrix(Mesh *mesh) {
     if (!mesh) return;
 
-    mat4 translation_matrix, rotation_matrix, scale_matrix;
-
-    // Create translation matrix
-    glm_translate_make(translation_matrix, mesh->position);
-
-    // Create rotation matrix from quaternion
-    glm_quat_mat4(mesh->rotation, rotation_matrix);
-
-    // Create scale matrix
-    glm_scale_make(scale_matrix, mesh->scale);
-
-    // Combine the transformation matrices in the correct order (scale -> rotate -> translate)
-    glm_mat4_identity(mesh->transform_matrix);  // Start with identity matrix
-    glm_mat4_mul(scale_matrix, mesh->transform_matrix, mesh->transform_matrix);
-    glm_mat4_mul(rotation_matrix, mesh->transform_matrix, mesh->transform_matrix);
-    glm_mat4_mul(translation_matrix, mesh->transform_matrix, mesh->transform_matrix);
+    // Compose translate * rotate * scale directly instead of multiplying three matrices
+    transform_compose(mesh->position, mesh->rotation, mesh->scale, mesh->transform_matrix);
 }
 
 // Function to free a mesh
@@ -73,13 +64,8 @@ void mesh_free(Mesh *mesh) {
         if (mesh->normals) free(mesh->normals);
         if (mesh->texcoords) free(mesh->texcoords);
         if (mesh->indices) free(mesh->indices);
-        
-        // Free material if it exists
-        if (mesh->material) {
-            material_free(mesh->material);  // Free the material resources
-            free(mesh->material);           // Free the material pointer if dynamically allocated
-        }
-        
+
+        // The material belongs to the model's material table
         free(mesh);
     }
 }
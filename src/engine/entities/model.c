@@ -1,7 +1,12 @@
 #include <entities/model.h>
 #include <entities/mesh.h>
+#include <pipeline/texture_registry.h>
+#include <entities/mesh_baked.h>
+#include <jobs/jobs.h>
+#include <jobs/trace.h>
 #include <glad/glad.h>
 #include <cgltf.h>
+#include <loaders/ufbx.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -10,8 +15,14 @@
 #include <cglm/cglm.h>
 #include <cglm/struct.h>
 
-// Function to load a texture from the GLTF data
-static Material *load_material_from_gltf(cgltf_material *gltf_material, const char* model_path) {
+#define MODEL_FBX_THREADED_SIZE (4 * 1024 * 1024) // Files from this size on are parsed with the worker pool
+
+static const char *gltf_texture_uri(const cgltf_texture *texture) {
+    return texture && texture->image ? texture->image->uri : NULL;
+}
+
+// Function to create a material and load its textures
+static Material *load_material(const MaterialSource *source, const char* model_path) {
     // Allocate memory for the Material struct
     Material *material = malloc(sizeof(Material));
     if (!material) {
@@ -19,22 +30,17 @@ static Material *load_material_from_gltf(cgltf_material *gltf_material, const ch
         return NULL;
     }
 
-	if (!gltf_material) {
-        printf("[GLTF_MODEL] No GLTF Material was defined.\n");
-        return NULL;
-    }
-
     // Initialize material properties with default values
     memset(material, 0, sizeof(Material));
+    material->id = material_next_id();
     glm_vec4_copy((vec4){1.0f, 1.0f, 1.0f, 1.0f}, material->diffuse_color); // Default diffuse color
     glm_vec3_copy((vec3){0.0f, 0.0f, 0.0f}, material->emissive_color);      // Default emissive color
     material->metallic = 0.0f;                                            // Default metallic
     material->roughness = 1.0f;                                           // Default roughness
 
 	// Load diffuse texture
-	if (gltf_material->pbr_metallic_roughness.base_color_texture.texture && !material->diffuse_texture_id) {
-		cgltf_texture *base_color_texture = gltf_material->pbr_metallic_roughness.base_color_texture.texture;
-		material->diffuse_texture_id = load_texture_from_gltf(base_color_texture, model_path);
+	if (source->diffuse_texture && !material->diffuse_texture_id) {
+		material->diffuse_texture_id = load_texture_from_uri(source->diffuse_texture, model_path);
 		if (!material->diffuse_texture_id) {
 			printf("Warning: Failed to load diffuse texture.\n");
 		} else {
@@ -47,14 +53,23 @@ static Material *load_material_from_gltf(cgltf_material *gltf_material, const ch
 	// Fallback default diffuse texture
 	if (!material->diffuse_texture_id) {
 		printf("Using default white texture as fallback for diffuse.\n");
-		glGenTextures(1, &material->diffuse_texture_id);
-		glBindTexture(GL_TEXTURE_2D, material->diffuse_texture_id);
 
-		unsigned char white_pixel[4] = {255, 255, 255, 255};
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white_pixel);
+		// One white texture shared by every material that needs it
+		material->diffuse_texture_id = texture_registry_find("builtin:white", 0);
+		if (!material->diffuse_texture_id) {
+			GLuint white_texture;
+			glGenTextures(1, &white_texture);
+			glBindTexture(GL_TEXTURE_2D, white_texture);
+
+			unsigned char white_pixel[4] = {255, 255, 255, 255};
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white_pixel);
 
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glBindTexture(GL_TEXTURE_2D, 0);
+
+			material->diffuse_texture_id = texture_registry_add("builtin:white", 0, white_texture, 1, 1, texture_gpu_bytes(1, 1, 4, false));
+		}
 	}
 
     // // Check if the material has a valid PBR metallic-roughness component
@@ -97,9 +112,8 @@ static Material *load_material_from_gltf(cgltf_material *gltf_material, const ch
     // }
 
     // Load normal texture
-    if (gltf_material->normal_texture.texture) {
-        cgltf_texture *normal_texture = gltf_material->normal_texture.texture;
-        material->normal_texture_id = load_texture_from_gltf(normal_texture, model_path);
+    if (source->normal_texture) {
+        material->normal_texture_id = load_texture_from_uri(source->normal_texture, model_path);
         if (!material->normal_texture_id) {
             printf("Warning: Failed to load normal texture.\n");
         } else {
@@ -108,9 +122,8 @@ static Material *load_material_from_gltf(cgltf_material *gltf_material, const ch
     }
 
     // Load occlusion texture
-    if (gltf_material->occlusion_texture.texture) {
-        cgltf_texture *occlusion_texture = gltf_material->occlusion_texture.texture;
-        material->occlusion_texture_id = load_texture_from_gltf(occlusion_texture, model_path);
+    if (source->occlusion_texture) {
+        material->occlusion_texture_id = load_texture_from_uri(source->occlusion_texture, model_path);
         if (!material->occlusion_texture_id) {
             printf("Warning: Failed to load occlusion texture.\n");
         } else {
@@ -119,9 +132,8 @@ static Material *load_material_from_gltf(cgltf_material *gltf_material, const ch
     }
 
     // Load emissive texture
-    if (gltf_material->emissive_texture.texcoord) {
-        cgltf_texture *emissive_texture = gltf_material->emissive_texture.texture;
-        material->emissive_texture_id = load_texture_from_gltf(emissive_texture, model_path);
+    if (source->emissive_texture) {
+        material->emissive_texture_id = load_texture_from_uri(source->emissive_texture, model_path);
         if (!material->emissive_texture_id) {
             printf("Warning: Failed to load emissive texture.\n");
         }  else {
@@ -130,114 +142,179 @@ static Material *load_material_from_gltf(cgltf_material *gltf_material, const ch
     }
 
     // Emissive color
-    if (sizeof(gltf_material->emissive_factor)) {
-        glm_vec3_copy(gltf_material->emissive_factor, material->emissive_color);
-    }
+    glm_vec3_copy((float *)source->emissive_color, material->emissive_color);
 
     return material;
 }
 
-static Mesh *load_mesh_from_gltf(cgltf_mesh *gltf_mesh, const cgltf_data *gltf_data, cgltf_node *node, bool apply_parent_transform, Model *model, const char* model_path) {
-    Mesh *mesh = mesh_create(gltf_mesh->name ? gltf_mesh->name : "unknown_or_singular_mesh_type");
+void model_gltf_material_source(const cgltf_material *gltf_material, MaterialSource *source) {
+    // The emissive texture is only used when it names a texcoord set
+    *source = (MaterialSource){
+        .diffuse_texture = gltf_texture_uri(gltf_material->pbr_metallic_roughness.base_color_texture.texture),
+        .normal_texture = gltf_texture_uri(gltf_material->normal_texture.texture),
+        .occlusion_texture = gltf_texture_uri(gltf_material->occlusion_texture.texture),
+        .emissive_texture = gltf_material->emissive_texture.texcoord ? gltf_texture_uri(gltf_material->emissive_texture.texture) : NULL
+    };
+    memcpy(source->emissive_color, gltf_material->emissive_factor, sizeof(source->emissive_color));
+}
+
+static Material *load_material_from_gltf(cgltf_material *gltf_material, const char* model_path) {
+	if (!gltf_material) {
+        printf("[GLTF_MODEL] No GLTF Material was defined.\n");
+        return NULL;
+    }
+
+    MaterialSource source;
+    model_gltf_material_source(gltf_material, &source);
+    return load_material(&source, model_path);
+}
+
+static Material *load_material_from_baked(const MeshBakedHeader *header, const MeshBakedMaterial *baked, const char* model_path) {
+    MaterialSource source = {
+        .diffuse_texture = baked->diffuse_texture ? mesh_baked_string(header, baked->diffuse_texture) : NULL,
+        .normal_texture = baked->normal_texture ? mesh_baked_string(header, baked->normal_texture) : NULL,
+        .occlusion_texture = baked->occlusion_texture ? mesh_baked_string(header, baked->occlusion_texture) : NULL,
+        .emissive_texture = baked->emissive_texture ? mesh_baked_string(header, baked->emissive_texture) : NULL
+    };
+    memcpy(source.emissive_color, baked->emissive_color, sizeof(source.emissive_color));
+    return load_material(&source, model_path);
+}
 
-    // Assume single primitive for simplicity
-    cgltf_primitive *primitive = &gltf_mesh->primitives[0];
+// A node's transform is only applied on request, otherwise the mesh starts from the model's own transform
+static void mesh_copy_model_transform(Mesh *mesh, const Model *model) {
+    mesh->position[0] = model->position[0];
+    mesh->position[1] = model->position[1];
+    mesh->position[2] = model->position[2];
 
-    // Load vertex data (positions, normals, texcoords)
-    for (size_t i = 0; i < primitive->attributes_count; i++) {
-        cgltf_attribute *attribute = &primitive->attributes[i];
-        cgltf_accessor *accessor = attribute->data;
+    mesh->rotation[0] = model->rotation[1];
+    mesh->rotation[1] = model->rotation[2];
+    mesh->rotation[2] = model->rotation[3];
+    mesh->rotation[3] = model->rotation[0];
+
+    mesh->scale[0] = model->scale[0];
+    mesh->scale[1] = model->scale[2];
+    mesh->scale[2] = model->scale[1];
+}
+
+// Node transform (glTF axes, rotation x, y, z, w) to the mesh, only the components the file sets
+static void mesh_set_node_transform(Mesh *mesh, const float translation[3], const float rotation[4], const float scale[3], const bool has[3]) {
+    if (has[0]) {
+        mesh->position[0] = translation[0];
+        mesh->position[1] = -translation[2];
+        mesh->position[2] = translation[1];
+    }
+    if (has[2]) {
+        mesh->scale[0] = scale[0];
+        mesh->scale[1] = scale[2];
+        mesh->scale[2] = scale[1];
+    }
+    if (has[1]) {
+        mesh->rotation[0] = rotation[1];
+        mesh->rotation[1] = rotation[2];
+        mesh->rotation[2] = rotation[3];
+        mesh->rotation[3] = rotation[0];
+    }
+}
+
+// Read a float attribute, tightly packed float data is copied in one go by cgltf
+static float *read_gltf_floats(const cgltf_accessor *accessor, size_t components) {
+    float *data = malloc(sizeof(float) * components * accessor->count);
+    if (!data) return NULL;
 
-        size_t num_components = cgltf_num_components(accessor->type);
+    if (cgltf_num_components(accessor->type) == components) {
+        if (cgltf_accessor_unpack_floats(accessor, data, components * accessor->count) == components * accessor->count) return data;
+    }
+
+    // Mismatched component count or unreadable view, convert element by element
+    for (size_t i = 0; i < accessor->count; i++) {
+        cgltf_accessor_read_float(accessor, i, &data[i * components], components);
+    }
+    return data;
+}
+
+// Node transform in glTF axes: the local fields for a plain root node, otherwise decomposed from the world matrix
+static void gltf_node_trs(const cgltf_node *node, float translation[3], float rotation[4], float scale[3], bool has[3]) {
+    if (!node->parent && !node->has_matrix) {
+        memcpy(translation, node->translation, sizeof(float) * 3);
+        memcpy(rotation, node->rotation, sizeof(float) * 4);
+        memcpy(scale, node->scale, sizeof(float) * 3);
+        has[0] = node->has_translation;
+        has[1] = node->has_rotation;
+        has[2] = node->has_scale;
+        return;
+    }
+
+    mat4 world, rotation_matrix;
+    vec4 world_translation;
+    cgltf_node_transform_world(node, (float *)world);
+    glm_decompose(world, world_translation, rotation_matrix, scale);
+    glm_mat4_quat(rotation_matrix, rotation);
+    memcpy(translation, world_translation, sizeof(float) * 3);
+
+    // A component counts as set when any node up the chain sets it, like the local fields of a root node
+    has[0] = has[1] = has[2] = false;
+    for (const cgltf_node *current = node; current; current = current->parent) {
+        has[0] |= current->has_translation || current->has_matrix;
+        has[1] |= current->has_rotation || current->has_matrix;
+        has[2] |= current->has_scale || current->has_matrix;
+    }
+}
+
+// Geometry only, no GL calls (safe on worker threads)
+static Mesh *load_mesh_from_gltf(const ModelGltfPrimitive *source, const char *name, bool apply_parent_transform, const Model *model) {
+    const cgltf_primitive *primitive = source->primitive;
+    Mesh *mesh = mesh_create(name);
+    if (!mesh) return NULL;
+
+    // Load vertex data (positions, normals, first texcoord set)
+    for (size_t i = 0; i < primitive->attributes_count; i++) {
+        const cgltf_attribute *attribute = &primitive->attributes[i];
+        const cgltf_accessor *accessor = attribute->data;
+        if (attribute->index != 0) continue;
 
         if (attribute->type == cgltf_attribute_type_position) {
             mesh->vertex_count = accessor->count;
-            mesh->vertices = malloc(sizeof(float) * num_components * accessor->count);
-            for (size_t j = 0; j < accessor->count; j++) {
-                float temp[3];
-                cgltf_accessor_read_float(accessor, j, temp, num_components);
-                for (size_t k = 0; k < num_components; k++) {
-                    mesh->vertices[j * num_components + k] = temp[k];
-                }
-            }
+            mesh->vertices = read_gltf_floats(accessor, 3);
         } else if (attribute->type == cgltf_attribute_type_normal) {
-            mesh->normals = malloc(sizeof(float) * num_components * accessor->count);
-            for (size_t j = 0; j < accessor->count; j++) {
-                float temp[3];
-                cgltf_accessor_read_float(accessor, j, temp, num_components);
-                for (size_t k = 0; k < num_components; k++) {
-                    mesh->normals[j * num_components + k] = temp[k];
-                }
-            }
+            mesh->normals = read_gltf_floats(accessor, 3);
         } else if (attribute->type == cgltf_attribute_type_texcoord) {
-            mesh->texcoords = malloc(sizeof(float) * 2 * accessor->count);
-            for (size_t j = 0; j < accessor->count; j++) {
-                float temp[2];
-                cgltf_accessor_read_float(accessor, j, temp, 2);
-                mesh->texcoords[j * 2 + 0] = temp[0];
-                mesh->texcoords[j * 2 + 1] = temp[1];
-            }
+            mesh->texcoords = read_gltf_floats(accessor, 2);
         }
     }
 
-    // Load indices
+    if (!mesh->vertices) {
+        printf("Mesh %s has no readable positions.\n", name);
+        mesh_free(mesh);
+        return NULL;
+    }
+
+    // Load indices, widened to 32 bits in bulk (sparse index data is read one by one)
     if (primitive->indices) {
-        cgltf_accessor *accessor = primitive->indices;
+        const cgltf_accessor *accessor = primitive->indices;
         mesh->index_count = accessor->count;
         mesh->indices = malloc(sizeof(uint32_t) * accessor->count);
-        for (size_t i = 0; i < accessor->count; i++) {
-            mesh->indices[i] = (uint32_t)cgltf_accessor_read_index(accessor, i);
+        if (!mesh->indices) mesh->index_count = 0;
+        else if (cgltf_accessor_unpack_indices(accessor, mesh->indices, sizeof(uint32_t), accessor->count) != accessor->count) {
+            for (size_t i = 0; i < accessor->count; i++) {
+                mesh->indices[i] = (uint32_t)cgltf_accessor_read_index(accessor, i);
+            }
         }
     }
 
     // Compute bounding box
     for (uint32_t i = 0; i < mesh->vertex_count; i++) {
-        vec3 vertex = {
-            mesh->vertices[i * 3 + 0],
-            mesh->vertices[i * 3 + 1],
-            mesh->vertices[i * 3 + 2]
-        };
-        glm_vec3_minv(vertex, mesh->min_bound, mesh->min_bound);
-        glm_vec3_maxv(vertex, mesh->max_bound, mesh->max_bound);
-    }
-
-    // Set position, scale, and rotation from the node
-    if (node && apply_parent_transform) {
-        if (node->has_translation) {
-            mesh->position[0] = node->translation[0];
-            mesh->position[1] = -node->translation[2];
-            mesh->position[2] = node->translation[1];
-        }
-        if (node->has_scale) {
-            mesh->scale[0] = node->scale[0];
-            mesh->scale[1] = node->scale[2];
-            mesh->scale[2] = node->scale[1];
-        }
-        if (node->has_rotation) {
-            mesh->rotation[0] = node->rotation[1];
-            mesh->rotation[1] = node->rotation[2];
-            mesh->rotation[2] = node->rotation[3];
-            mesh->rotation[3] = node->rotation[0];
-        }
-    } else if (node && !apply_parent_transform) {
-        mesh->position[0] = model->position[0];
-        mesh->position[1] = model->position[1];
-        mesh->position[2] = model->position[2];
-
-        mesh->rotation[0] = model->rotation[1];
-        mesh->rotation[1] = model->rotation[2];
-        mesh->rotation[2] = model->rotation[3];
-        mesh->rotation[3] = model->rotation[0];
-        
-        mesh->scale[0] = model->scale[0];
-        mesh->scale[1] = model->scale[2];
-        mesh->scale[2] = model->scale[1];
+        glm_vec3_minv(&mesh->vertices[i * 3], mesh->min_bound, mesh->min_bound);
+        glm_vec3_maxv(&mesh->vertices[i * 3], mesh->max_bound, mesh->max_bound);
     }
 
-    // Assign material to mesh (if the primitive has a material)
-    if (primitive->material) {
-        Material *material = load_material_from_gltf(primitive->material, model_path);
-        mesh_set_material(mesh, material);
+    // Set position, scale, and rotation from the node (its world transform when it has parents)
+    if (apply_parent_transform) {
+        float translation[3], rotation[4], scale[3];
+        bool has[3];
+        gltf_node_trs(source->node, translation, rotation, scale, has);
+        mesh_set_node_transform(mesh, translation, rotation, scale, has);
+    } else {
+        mesh_copy_model_transform(mesh, model);
     }
 
     // Update transformation matrix
@@ -245,6 +322,63 @@ static Mesh *load_mesh_from_gltf(cgltf_mesh *gltf_mesh, const cgltf_data *gltf_d
     return mesh;
 }
 
+// Depth-first, children after their parent, so the import order is stable between passes
+static void collect_node_primitives(cgltf_node *node, ModelGltfPrimitive *out, uint32_t *count) {
+    if (node->mesh) {
+        for (size_t i = 0; i < node->mesh->primitives_count; i++) {
+            cgltf_primitive *primitive = &node->mesh->primitives[i];
+            if (primitive->type != cgltf_primitive_type_triangles) continue; // Drawn as GL_TRIANGLES only
+
+            if (out) out[*count] = (ModelGltfPrimitive){ node, primitive };
+            (*count)++;
+        }
+    }
+    for (size_t i = 0; i < node->children_count; i++) collect_node_primitives(node->children[i], out, count);
+}
+
+uint32_t model_gltf_primitives(const cgltf_data *gltf_data, ModelGltfPrimitive *out) {
+    uint32_t count = 0;
+    const cgltf_scene *scene = gltf_data->scene ? gltf_data->scene : (gltf_data->scenes_count ? &gltf_data->scenes[0] : NULL);
+    if (scene) {
+        for (size_t i = 0; i < scene->nodes_count; i++) collect_node_primitives(scene->nodes[i], out, &count);
+    } else {
+        // No scene, every root node is part of the model
+        for (size_t i = 0; i < gltf_data->nodes_count; i++) {
+            if (!gltf_data->nodes[i].parent) collect_node_primitives(&gltf_data->nodes[i], out, &count);
+        }
+    }
+    return count;
+}
+
+// Shared by the import jobs, each one fills its own meshes[index]
+typedef struct {
+    Model *model;
+    const cgltf_data *gltf_data;
+    const ModelGltfPrimitive *primitives;
+    const uint32_t *mesh_uses;
+    bool apply_parent_transform;
+} GltfImport;
+
+static void import_mesh_job(void *data, uint32_t index) {
+    GltfImport *import = (GltfImport *)data;
+    const ModelGltfPrimitive *source = &import->primitives[index];
+    const cgltf_mesh *gltf_mesh = source->node->mesh;
+
+    // Meshes are looked up by name, so instanced meshes and extra primitives get the import index appended
+    const char *name = gltf_mesh->name ? gltf_mesh->name : "unknown_or_singular_mesh_type";
+    char unique_name[256];
+    if (gltf_mesh->primitives_count > 1 || import->mesh_uses[cgltf_mesh_index(import->gltf_data, gltf_mesh)] > 1) {
+        snprintf(unique_name, sizeof(unique_name), "%s.%u", name, index);
+        name = unique_name;
+    }
+
+    TRACE_BEGIN_DETAIL("glTF mesh import", name);
+    Mesh *mesh = load_mesh_from_gltf(source, name, import->apply_parent_transform, import->model);
+    TRACE_END();
+    if (mesh && source->primitive->material) mesh->material_index = (uint32_t)cgltf_material_index(import->gltf_data, source->primitive->material);
+    import->model->meshes[index] = mesh;
+}
+
 // Model transformation functions
 void model_set_position(Model *model, vec3 new_position) {
     glm_vec3_copy(new_position, model->position);  // Copy the new position into the model
@@ -265,85 +399,700 @@ void create_rotation_quaternion(versor q, vec3 axis, float angle) {
 
 // Apply transformations to the model's transform matrix and meshes
 void model_apply_transform(Model *model) {
-    // Start with the identity matrix
-    glm_mat4_identity(model->transform_matrix);
+    // Translation, scale, then X/Y/Z rotation (in degrees), composed in one go
+    transform_compose_euler(model->position, model->rotation, model->scale, model->transform_matrix);
 
-    // Apply translation
-    glm_translate(model->transform_matrix, model->position);
+    // Only marks the hierarchy dirty when the matrix actually changed
+    if (model->transforms && model->transform != TRANSFORM_NONE) {
+        transform_set_local_matrix(model->transforms, model->transform, model->transform_matrix);
+    }
+}
 
-    // Apply scale
-    glm_scale(model->transform_matrix, model->scale);
+// Attach the model root and one child node per mesh to a transform hierarchy
+void model_attach_transforms(Model *model, TransformSystem *system, TransformId parent) {
+    if (!model || !system) return;
 
-    // Apply rotation using quaternion (no need to apply axis-by-axis)
-    glm_rotate(model->transform_matrix, glm_rad(model->rotation[0]), (vec3){1.0f, 0.0f, 0.0f});
-    glm_rotate(model->transform_matrix, glm_rad(model->rotation[1]), (vec3){0.0f, 1.0f, 0.0f});
-    glm_rotate(model->transform_matrix, glm_rad(model->rotation[2]), (vec3){0.0f, 0.0f, 1.0f});
+    model->transforms = system;
+    model->transform = transform_create(system, parent);
+    transform_set_local_matrix(system, model->transform, model->transform_matrix);
+
+    for (uint32_t i = 0; i < model->mesh_count; i++) {
+        Mesh *mesh = model->meshes[i];
+        mesh->transform = transform_create(system, model->transform);
+        transform_set_trs(system, mesh->transform, mesh->position, mesh->rotation, mesh->scale);
+    }
 }
 
-// GLTF loading function
-int model_load_gltf(Model *model, const char *file_path, bool apply_parent_transform) {
-    if (!model || !file_path) {
+// cgltf reads the .gltf and its buffers through the VFS, so packed models load like loose ones
+static cgltf_result gltf_vfs_read(const cgltf_memory_options *memory_options, const cgltf_file_options *file_options, const char *path, cgltf_size *size, void **data) {
+    (void)memory_options;
+    (void)file_options;
+
+    size_t file_size;
+    *data = vfs_read(path, &file_size);
+    if (!*data) return cgltf_result_file_not_found;
+
+    *size = file_size;
+    return cgltf_result_success;
+}
+
+static void gltf_vfs_release(const cgltf_memory_options *memory_options, const cgltf_file_options *file_options, void *data) {
+    (void)memory_options;
+    (void)file_options;
+    free(data);
+}
+
+// Parse the glTF file and build the meshes, the materials are left for model_load_gltf_materials
+int model_load_gltf_geometry(Model *model, const char *file_path, bool apply_parent_transform, cgltf_data **gltf_out) {
+    if (!model || !file_path || !gltf_out) {
         printf("Invalid parameters: model or file_path is NULL.\n");
         return -1;
     }
+    *gltf_out = NULL;
 
     cgltf_data *gltf_data = NULL;
     cgltf_options options = {0};
+    options.file.read = gltf_vfs_read;
+    options.file.release = gltf_vfs_release;
+    TRACE_BEGIN_DETAIL("glTF parse", file_path);
     cgltf_result result = cgltf_parse_file(&options, file_path, &gltf_data);
+    TRACE_END();
     if (result != cgltf_result_success) {
         printf("Failed to parse GLTF file: %s\n", file_path);
         return -1;
     }
 
+    TRACE_BEGIN_DETAIL("glTF buffers", file_path);
     result = cgltf_load_buffers(&options, gltf_data, file_path);
+    TRACE_END();
     if (result != cgltf_result_success) {
         cgltf_free(gltf_data);
         printf("Failed to load GLTF buffers: %s\n", file_path);
         return -2;
     }
 
-    model->mesh_count = gltf_data->meshes_count;
-    model->meshes = malloc(sizeof(Mesh *) * model->mesh_count);
-    model->materials = malloc(sizeof(Material *) * model->mesh_count);
+    model->transforms = NULL;
+    model->transform = TRANSFORM_NONE;
+
+    // One mesh per triangle primitive of every node in the scene
+    uint32_t primitive_count = model_gltf_primitives(gltf_data, NULL);
+    ModelGltfPrimitive *primitives = malloc(sizeof(ModelGltfPrimitive) * (primitive_count ? primitive_count : 1));
+    uint32_t *mesh_uses = calloc(gltf_data->meshes_count ? gltf_data->meshes_count : 1, sizeof(uint32_t));
+
+    model->mesh_count = primitive_count;
+    model->meshes = calloc(primitive_count ? primitive_count : 1, sizeof(Mesh *));
+    model->materials = NULL;
+    model->material_count = 0;
 
-    if (!model->meshes || !model->materials) {
+    if (!primitives || !mesh_uses || !model->meshes) {
+        free(primitives);
+        free(mesh_uses);
+        free(model->meshes);
+        model->meshes = NULL;
+        model->mesh_count = 0;
         cgltf_free(gltf_data);
-        printf("Failed to allocate memory for meshes or materials.\n");
+        printf("Failed to allocate memory for meshes.\n");
         return -3;
     }
 
-    for (size_t i = 0; i < gltf_data->meshes_count; i++) {
-        cgltf_mesh *gltf_mesh = &gltf_data->meshes[i];
-        cgltf_node *node = &gltf_data->nodes[i]; // Assume nodes are indexed like meshes for simplicity
+    model_gltf_primitives(gltf_data, primitives);
+    for (size_t i = 0; i < gltf_data->nodes_count; i++) {
+        if (gltf_data->nodes[i].mesh) mesh_uses[cgltf_mesh_index(gltf_data, gltf_data->nodes[i].mesh)]++;
+    }
 
-        model->meshes[i] = load_mesh_from_gltf(gltf_mesh, gltf_data, node, apply_parent_transform, model, file_path);
+    // Meshes are independent, the worker pool (and this thread) imports them in parallel
+    GltfImport import = { model, gltf_data, primitives, mesh_uses, apply_parent_transform };
+    jobs_parallel_for(primitive_count, import_mesh_job, &import);
+    free(primitives);
+    free(mesh_uses);
+
+    for (uint32_t i = 0; i < model->mesh_count; i++) {
         if (!model->meshes[i]) {
-            printf("Failed to load mesh %zu.\n", i);
-            for (size_t j = 0; j < i; j++) {
+            printf("Failed to load mesh %u.\n", i);
+            for (uint32_t j = 0; j < model->mesh_count; j++) {
                 mesh_free(model->meshes[j]);
             }
             free(model->meshes);
+            model->meshes = NULL;
+            model->mesh_count = 0;
             cgltf_free(gltf_data);
             return -4;
         }
+    }
 
-        // Load and assign the material to the model
-        if (gltf_mesh->primitives[0].material) {
-            model->materials[i] = load_material_from_gltf(gltf_mesh->primitives[0].material, file_path);
-        }
+    *gltf_out = gltf_data;
+    return 1;
+}
+
+// Empty material table, filled by the material passes
+static bool model_alloc_material_table(Model *model, uint32_t count) {
+    model->material_count = count;
+    model->materials = calloc(count ? count : 1, sizeof(Material *));
+    if (!model->materials) {
+        model->material_count = 0;
+        printf("Failed to allocate memory for materials.\n");
+        return false;
+    }
+    return true;
+}
+
+// Create the materials (GL textures) of a model built by model_load_gltf_geometry, then free the parsed file
+int model_load_gltf_materials(Model *model, cgltf_data *gltf_data, const char *file_path) {
+    if (!model || !gltf_data) return -1;
+
+    if (!model_alloc_material_table(model, (uint32_t)gltf_data->materials_count)) {
+        cgltf_free(gltf_data);
+        return -1;
+    }
+
+    // Each glTF material is created once, the first time a mesh uses it, and shared by every mesh after that
+    for (uint32_t i = 0; i < model->mesh_count; i++) {
+        uint32_t index = model->meshes[i]->material_index;
+        if (index == MESH_NO_MATERIAL) continue;
+
+        if (!model->materials[index]) model->materials[index] = load_material_from_gltf(&gltf_data->materials[index], file_path);
+        mesh_set_material(model->meshes[i], model->materials[index]);
     }
 
     cgltf_free(gltf_data);
     return 1;
 }
 
+void model_baked_path(const char *gltf_path, char *dest, size_t dest_size) {
+    const char *slash = strrchr(gltf_path, '/');
+    const char *dot = strrchr(gltf_path, '.');
+    int stem = (dot && (!slash || dot > slash)) ? (int)(dot - gltf_path) : (int)strlen(gltf_path);
+    snprintf(dest, dest_size, "%.*s%s", stem, gltf_path, MESH_BAKED_EXTENSION);
+}
+
+// Map the baked file and point the meshes at its vertex and index data
+int model_load_baked_geometry(Model *model, const char *file_path, bool apply_parent_transform) {
+    if (!model || !file_path) {
+        printf("Invalid parameters: model or file_path is NULL.\n");
+        return -1;
+    }
+
+    // Not baked is the common case, callers fall back to the glTF file quietly
+    if (!vfs_open(&model->baked, file_path)) return -1;
+
+    const MeshBakedHeader *header = mesh_baked_validate(model->baked.data, model->baked.size);
+    if (!header) {
+        printf("Invalid baked model (rebake it): %s\n", file_path);
+        vfs_close(&model->baked);
+        return -2;
+    }
+
+    model->transforms = NULL;
+    model->transform = TRANSFORM_NONE;
+
+    model->mesh_count = header->mesh_count;
+    model->meshes = calloc(model->mesh_count ? model->mesh_count : 1, sizeof(Mesh *));
+    model->materials = NULL;
+    model->material_count = 0;
+    if (!model->meshes) {
+        model->mesh_count = 0;
+        vfs_close(&model->baked);
+        printf("Failed to allocate memory for meshes.\n");
+        return -3;
+    }
+
+    const unsigned char *data = model->baked.data;
+    const MeshBakedMesh *baked_meshes = mesh_baked_meshes(header);
+    for (uint32_t i = 0; i < model->mesh_count; i++) {
+        const MeshBakedMesh *baked = &baked_meshes[i];
+
+        Mesh *mesh = mesh_create(mesh_baked_string(header, baked->name));
+        if (!mesh) {
+            for (uint32_t j = 0; j < i; j++) mesh_free(model->meshes[j]);
+            free(model->meshes);
+            model->meshes = NULL;
+            model->mesh_count = 0;
+            vfs_close(&model->baked);
+            return -4;
+        }
+
+        mesh->vertex_count = baked->vertex_count;
+        mesh->vertex_data = data + header->vertex_offset + baked->vertex_offset;
+        mesh->index_count = baked->index_count;
+        mesh->index_size = baked->index_size;
+        mesh->index_data = baked->index_size ? data + header->index_offset + baked->index_offset : NULL;
+        mesh->material_index = baked->material == MESH_BAKED_NO_MATERIAL ? MESH_NO_MATERIAL : baked->material;
+        memcpy(mesh->min_bound, baked->min_bound, sizeof(vec3));
+        memcpy(mesh->max_bound, baked->max_bound, sizeof(vec3));
+
+        // Same choice as load_mesh_from_gltf, the stored node transform is already in engine axes
+        if ((baked->flags & MESH_BAKED_HAS_NODE) && apply_parent_transform) {
+            memcpy(mesh->position, baked->translation, sizeof(vec3));
+            memcpy(mesh->rotation, baked->rotation, sizeof(versor));
+            memcpy(mesh->scale, baked->scale, sizeof(vec3));
+        } else if (baked->flags & MESH_BAKED_HAS_NODE) {
+            mesh_copy_model_transform(mesh, model);
+        }
+
+        mesh_update_transform_matrix(mesh);
+        model->meshes[i] = mesh;
+    }
+
+    return 1;
+}
+
+int model_load_baked_materials(Model *model, const char *file_path) {
+    if (!model) return -1;
+    const MeshBakedHeader *header = mesh_baked_validate(model->baked.data, model->baked.size);
+    if (!header) return -1;
+
+    if (!model_alloc_material_table(model, header->material_count)) return -1;
+
+    // Same sharing as the glTF pass, one material per table entry
+    const MeshBakedMaterial *baked_materials = mesh_baked_materials(header);
+    for (uint32_t i = 0; i < model->mesh_count; i++) {
+        uint32_t index = model->meshes[i]->material_index;
+        if (index == MESH_NO_MATERIAL) continue;
+
+        if (!model->materials[index]) model->materials[index] = load_material_from_baked(header, &baked_materials[index], file_path);
+        mesh_set_material(model->meshes[i], model->materials[index]);
+    }
+    return 1;
+}
+
+int model_load_baked(Model *model, const char *file_path, bool apply_parent_transform) {
+    int result = model_load_baked_geometry(model, file_path, apply_parent_transform);
+    if (result < 0) return result;
+
+    return model_load_baked_materials(model, file_path);
+}
+
+uint32_t model_baked_texture_uris(const Model *model, const char **uris, uint32_t max_uris) {
+    const MeshBakedHeader *header = mesh_baked_validate(model->baked.data, model->baked.size);
+    if (!header) return 0;
+
+    uint32_t count = 0;
+    const MeshBakedMaterial *materials = mesh_baked_materials(header);
+    for (uint32_t i = 0; i < header->material_count; i++) {
+        uint32_t textures[4] = { materials[i].diffuse_texture, materials[i].normal_texture, materials[i].occlusion_texture, materials[i].emissive_texture };
+        for (int t = 0; t < 4; t++) {
+            if (textures[t] && count < max_uris) uris[count++] = mesh_baked_string(header, textures[t]);
+        }
+    }
+    return count;
+}
+
+// GLTF loading function
+int model_load_gltf(Model *model, const char *file_path, bool apply_parent_transform) {
+    // A baked copy next to the file skips parsing and attribute conversion
+    char baked_path[1024];
+    model_baked_path(file_path, baked_path, sizeof(baked_path));
+    if (model_load_baked(model, baked_path, apply_parent_transform) >= 0) return 1;
+
+    cgltf_data *gltf_data = NULL;
+    int result = model_load_gltf_geometry(model, file_path, apply_parent_transform, &gltf_data);
+    if (result < 0) return result;
+
+    return model_load_gltf_materials(model, gltf_data, file_path);
+}
+
+bool model_is_fbx(const char *file_path) {
+    const char *dot = file_path ? strrchr(file_path, '.') : NULL;
+    if (!dot || strlen(dot) != 4) return false;
+    return (dot[1] == 'f' || dot[1] == 'F') && (dot[2] == 'b' || dot[2] == 'B') && (dot[3] == 'x' || dot[3] == 'X');
+}
+
+// Texture path as written in the file (relative to the model), the file name alone when only an absolute path was saved
+static const char *fbx_texture_uri(const ufbx_texture *texture) {
+    if (!texture) return NULL;
+    if (texture->relative_filename.length) return texture->relative_filename.data;
+    if (!texture->absolute_filename.length) return NULL;
+
+    const char *name = texture->absolute_filename.data;
+    for (const char *p = name; *p; p++) {
+        if (*p == '/' || *p == '\\') name = p + 1;
+    }
+    return *name ? name : NULL;
+}
+
+void model_fbx_material_source(const ufbx_material *fbx_material, MaterialSource *source) {
+    // ufbx maps both the classic FBX and the PBR material models to the pbr maps
+    const ufbx_material_pbr_maps *pbr = &fbx_material->pbr;
+    *source = (MaterialSource){
+        .diffuse_texture = fbx_texture_uri(pbr->base_color.texture),
+        .normal_texture = fbx_texture_uri(pbr->normal_map.texture ? pbr->normal_map.texture : fbx_material->fbx.normal_map.texture),
+        .occlusion_texture = fbx_texture_uri(pbr->ambient_occlusion.texture),
+        .emissive_texture = fbx_texture_uri(pbr->emission_color.texture)
+    };
+
+    ufbx_real factor = pbr->emission_factor.has_value ? pbr->emission_factor.value_real : 1.0;
+    source->emissive_color[0] = (float)(pbr->emission_color.value_vec3.x * factor);
+    source->emissive_color[1] = (float)(pbr->emission_color.value_vec3.y * factor);
+    source->emissive_color[2] = (float)(pbr->emission_color.value_vec3.z * factor);
+}
+
+// A material part of a node's mesh, the FBX import creates one mesh for each (like a glTF primitive)
+typedef struct {
+    const ufbx_node *node;
+    const ufbx_mesh_part *part;
+} FbxPart;
+
+// Shared by the import jobs, each one fills its own meshes[index]
+typedef struct {
+    Model *model;
+    const FbxPart *parts;
+    ufbx_matrix to_gltf;      // Axis and unit conversion of the scene (the root node transform)
+    ufbx_matrix from_gltf;
+    bool flip_winding;        // The conversion mirrors, triangles would turn inside out
+    bool apply_parent_transform;
+} FbxImport;
+
+static void collect_fbx_parts(const ufbx_node *node, FbxPart *out, uint32_t *count) {
+    if (node->mesh) {
+        for (size_t i = 0; i < node->mesh->material_parts.count; i++) {
+            const ufbx_mesh_part *part = &node->mesh->material_parts.data[i];
+            if (part->num_triangles == 0) continue; // Points and lines are not drawn
+
+            if (out) out[*count] = (FbxPart){ node, part };
+            (*count)++;
+        }
+    }
+    for (size_t i = 0; i < node->children.count; i++) collect_fbx_parts(node->children.data[i], out, count);
+}
+
+// World transform in glTF space, with the same "set anywhere up the chain" rule as gltf_node_trs.
+// The root holds the conversion C, so the world matrix is C * W and the node gets C * W * C^-1, the way glTF
+// exporters convert Z-up scenes (the vertices get C, see load_mesh_from_fbx).
+static void fbx_node_trs(const ufbx_node *node, const ufbx_matrix *from_gltf, float translation[3], float rotation[4], float scale[3], bool has[3]) {
+    ufbx_matrix world_matrix = ufbx_matrix_mul(&node->node_to_world, from_gltf);
+    ufbx_transform world = ufbx_matrix_to_transform(&world_matrix);
+    translation[0] = (float)world.translation.x;
+    translation[1] = (float)world.translation.y;
+    translation[2] = (float)world.translation.z;
+    rotation[0] = (float)world.rotation.x;
+    rotation[1] = (float)world.rotation.y;
+    rotation[2] = (float)world.rotation.z;
+    rotation[3] = (float)world.rotation.w;
+    scale[0] = (float)world.scale.x;
+    scale[1] = (float)world.scale.y;
+    scale[2] = (float)world.scale.z;
+
+    has[0] = has[1] = has[2] = false;
+    for (const ufbx_node *current = node; current && !current->is_root; current = current->parent) {
+        const ufbx_transform *local = &current->local_transform;
+        has[0] |= local->translation.x != 0.0 || local->translation.y != 0.0 || local->translation.z != 0.0;
+        has[1] |= local->rotation.x != 0.0 || local->rotation.y != 0.0 || local->rotation.z != 0.0 || local->rotation.w != 1.0;
+        has[2] |= local->scale.x != 1.0 || local->scale.y != 1.0 || local->scale.z != 1.0;
+    }
+}
+
+// Geometry only, no GL calls (safe on worker threads).
+// Faces are triangulated by ufbx and the corners welded back into indexed vertices with ufbx_generate_indices.
+static Mesh *load_mesh_from_fbx(const FbxImport *import, const FbxPart *source, const char *name) {
+    const ufbx_mesh *fbx_mesh = source->node->mesh;
+    const ufbx_mesh_part *part = source->part;
+    bool has_normals = fbx_mesh->vertex_normal.exists;
+    bool has_texcoords = fbx_mesh->vertex_uv.exists;
+
+    size_t corner_count = part->num_triangles * 3;
+    MeshBakedVertex *corners = calloc(corner_count, sizeof(MeshBakedVertex));
+    uint32_t *triangle = malloc(sizeof(uint32_t) * fbx_mesh->max_face_triangles * 3);
+    uint32_t *indices = malloc(sizeof(uint32_t) * corner_count);
+    Mesh *mesh = corners && triangle && indices ? mesh_create(name) : NULL;
+    if (!mesh) {
+        free(corners);
+        free(triangle);
+        free(indices);
+        return NULL;
+    }
+
+    size_t corner = 0;
+    for (size_t i = 0; i < part->face_indices.count; i++) {
+        ufbx_face face = fbx_mesh->faces.data[part->face_indices.data[i]];
+        uint32_t triangle_count = ufbx_triangulate_face(triangle, fbx_mesh->max_face_triangles * 3, fbx_mesh, face);
+
+        for (uint32_t j = 0; j < triangle_count * 3 && corner < corner_count; j++, corner++) {
+            MeshBakedVertex *vertex = &corners[corner];
+            uint32_t index = triangle[import->flip_winding ? j - j % 3 + 2 - j % 3 : j];
+            ufbx_vec3 position = ufbx_transform_position(&import->to_gltf, ufbx_get_vertex_vec3(&fbx_mesh->vertex_position, index));
+            vertex->position[0] = (float)position.x;
+            vertex->position[1] = (float)position.y;
+            vertex->position[2] = (float)position.z;
+            if (has_normals) {
+                ufbx_vec3 normal = ufbx_transform_direction(&import->to_gltf, ufbx_get_vertex_vec3(&fbx_mesh->vertex_normal, index));
+                vertex->normal[0] = (float)normal.x;
+                vertex->normal[1] = (float)normal.y;
+                vertex->normal[2] = (float)normal.z;
+                glm_vec3_normalize(vertex->normal);
+            }
+            if (has_texcoords) {
+                // FBX puts v = 0 at the bottom of the image, glTF at the top
+                ufbx_vec2 texcoord = ufbx_get_vertex_vec2(&fbx_mesh->vertex_uv, index);
+                vertex->texcoord[0] = (float)texcoord.x;
+                vertex->texcoord[1] = (float)(1.0 - texcoord.y);
+            }
+        }
+    }
+    free(triangle);
+
+    // Dedupes the corners in place, the first vertex_count entries are the unique vertices
+    ufbx_error error;
+    ufbx_vertex_stream stream = { corners, corner, sizeof(MeshBakedVertex) };
+    size_t vertex_count = ufbx_generate_indices(&stream, 1, indices, corner, NULL, &error);
+    if (error.type != UFBX_ERROR_NONE) {
+        printf("Mesh %s could not be indexed.\n", name);
+        free(corners);
+        free(indices);
+        mesh_free(mesh);
+        return NULL;
+    }
+
+    mesh->vertex_count = (uint32_t)vertex_count;
+    mesh->index_count = (uint32_t)corner;
+    mesh->indices = indices;
+    mesh->vertices = malloc(sizeof(float) * 3 * (vertex_count ? vertex_count : 1));
+    mesh->normals = has_normals ? malloc(sizeof(float) * 3 * (vertex_count ? vertex_count : 1)) : NULL;
+    mesh->texcoords = has_texcoords ? malloc(sizeof(float) * 2 * (vertex_count ? vertex_count : 1)) : NULL;
+    if (!mesh->vertices || (has_normals && !mesh->normals) || (has_texcoords && !mesh->texcoords)) {
+        free(corners);
+        mesh_free(mesh);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < vertex_count; i++) {
+        memcpy(&mesh->vertices[i * 3], corners[i].position, sizeof(float) * 3);
+        if (has_normals) memcpy(&mesh->normals[i * 3], corners[i].normal, sizeof(float) * 3);
+        if (has_texcoords) memcpy(&mesh->texcoords[i * 2], corners[i].texcoord, sizeof(float) * 2);
+
+        glm_vec3_minv(corners[i].position, mesh->min_bound, mesh->min_bound);
+        glm_vec3_maxv(corners[i].position, mesh->max_bound, mesh->max_bound);
+    }
+    free(corners);
+
+    if (import->apply_parent_transform) {
+        float translation[3], rotation[4], scale[3];
+        bool has[3];
+        fbx_node_trs(source->node, &import->from_gltf, translation, rotation, scale, has);
+        mesh_set_node_transform(mesh, translation, rotation, scale, has);
+    } else {
+        mesh_copy_model_transform(mesh, import->model);
+    }
+
+    mesh_update_transform_matrix(mesh);
+    return mesh;
+}
+
+
+static void import_fbx_mesh_job(void *data, uint32_t index) {
+    FbxImport *import = (FbxImport *)data;
+    const FbxPart *source = &import->parts[index];
+    const ufbx_node *node = source->node;
+    const ufbx_mesh *fbx_mesh = node->mesh;
+
+    // Same naming as the glTF import: the node name, with the import index when it would not be unique
+    const char *name = node->name.length ? node->name.data : (fbx_mesh->name.length ? fbx_mesh->name.data : "unknown_or_singular_mesh_type");
+    char unique_name[256];
+    if (fbx_mesh->material_parts.count > 1 || fbx_mesh->instances.count > 1) {
+        snprintf(unique_name, sizeof(unique_name), "%s.%u", name, index);
+        name = unique_name;
+    }
+
+    TRACE_BEGIN_DETAIL("FBX mesh import", name);
+    Mesh *mesh = load_mesh_from_fbx(import, source, name);
+    TRACE_END();
+    if (mesh) {
+        // Instances can override the mesh's materials, the node has the list that applies
+        const ufbx_material_list *materials = node->materials.count ? &node->materials : &fbx_mesh->materials;
+        if (source->part->index < materials->count && materials->data[source->part->index]) {
+            mesh->material_index = materials->data[source->part->index]->typed_id;
+        }
+    }
+    import->model->meshes[index] = mesh;
+}
+
+// ufbx thread pool on the job system. Each batch of tasks runs to completion inside run_fn (the caller helps),
+// which keeps it safe when the model itself is loaded from a job; wait_fn has nothing left to wait for.
+typedef struct {
+    ufbx_thread_pool_context context;
+    uint32_t start_index;
+} FbxTaskBatch;
+
+static void fbx_task_job(void *data, uint32_t index) {
+    FbxTaskBatch *batch = (FbxTaskBatch *)data;
+    ufbx_thread_pool_run_task(batch->context, batch->start_index + index);
+}
+
+static bool fbx_pool_run(void *user, ufbx_thread_pool_context context, uint32_t group, uint32_t start_index, uint32_t count) {
+    (void)user;
+    (void)group;
+    FbxTaskBatch batch = { context, start_index };
+    jobs_parallel_for(count, fbx_task_job, &batch);
+    return true;
+}
+
+static bool fbx_pool_wait(void *user, ufbx_thread_pool_context context, uint32_t group, uint32_t max_index) {
+    (void)user;
+    (void)context;
+    (void)group;
+    (void)max_index;
+    return true;
+}
+
+// Parse the FBX file and build the meshes, the materials are left for model_load_fbx_materials
+int model_load_fbx_geometry(Model *model, const char *file_path, bool apply_parent_transform, ufbx_scene **scene_out) {
+    if (!model || !file_path || !scene_out) {
+        printf("Invalid parameters: model or file_path is NULL.\n");
+        return -1;
+    }
+    *scene_out = NULL;
+
+    VfsFile file;
+    if (!vfs_open(&file, file_path)) {
+        printf("Failed to open FBX file: %s\n", file_path);
+        return -1;
+    }
+
+    // Converted to glTF conventions (right-handed, Y up, meters) so the rest of the import matches model_load_gltf.
+    // ufbx leaves the conversion in the root node, the import applies it to vertices and node transforms.
+    ufbx_load_opts options = {0};
+    options.target_axes = ufbx_axes_right_handed_y_up;
+    options.target_unit_meters = 1.0f;
+    options.space_conversion = UFBX_SPACE_CONVERSION_TRANSFORM_ROOT;
+    options.geometry_transform_handling = UFBX_GEOMETRY_TRANSFORM_HANDLING_MODIFY_GEOMETRY;
+    options.generate_missing_normals = true;
+    options.path_separator = '/';
+    options.filename.data = file_path;
+    options.filename.length = strlen(file_path);
+
+    // Big files are parsed by the worker pool as well
+    if (file.size >= MODEL_FBX_THREADED_SIZE && jobs_worker_count() > 0) {
+        options.thread_opts.pool.run_fn = fbx_pool_run;
+        options.thread_opts.pool.wait_fn = fbx_pool_wait;
+    }
+
+    ufbx_error error;
+    TRACE_BEGIN_DETAIL("FBX parse", file_path);
+    ufbx_scene *scene = ufbx_load_memory(file.data, file.size, &options, &error);
+    TRACE_END();
+    vfs_close(&file);
+    if (!scene) {
+        printf("Failed to parse FBX file: %s (%.*s)\n", file_path, (int)error.description.length, error.description.data);
+        return -1;
+    }
+
+    model->transforms = NULL;
+    model->transform = TRANSFORM_NONE;
+
+    uint32_t part_count = 0;
+    collect_fbx_parts(scene->root_node, NULL, &part_count);
+    FbxPart *parts = malloc(sizeof(FbxPart) * (part_count ? part_count : 1));
+
+    model->mesh_count = part_count;
+    model->meshes = calloc(part_count ? part_count : 1, sizeof(Mesh *));
+    model->materials = NULL;
+    model->material_count = 0;
+
+    if (!parts || !model->meshes) {
+        free(parts);
+        free(model->meshes);
+        model->meshes = NULL;
+        model->mesh_count = 0;
+        ufbx_free_scene(scene);
+        printf("Failed to allocate memory for meshes.\n");
+        return -3;
+    }
+
+    part_count = 0;
+    collect_fbx_parts(scene->root_node, parts, &part_count);
+
+    // Files written on Windows use backslashes in texture paths, the texture loaders expect '/'
+    for (size_t i = 0; i < scene->textures.count; i++) {
+        ufbx_string paths[2] = { scene->textures.data[i]->relative_filename, scene->textures.data[i]->absolute_filename };
+        for (int p = 0; p < 2; p++) {
+            for (char *c = (char *)paths[p].data; c && *c; c++) {
+                if (*c == '\\') *c = '/';
+            }
+        }
+    }
+
+    FbxImport import = {
+        .model = model,
+        .parts = parts,
+        .to_gltf = scene->root_node->node_to_parent,
+        .apply_parent_transform = apply_parent_transform
+    };
+    import.from_gltf = ufbx_matrix_invert(&import.to_gltf);
+    import.flip_winding = ufbx_matrix_determinant(&import.to_gltf) < 0.0;
+    jobs_parallel_for(part_count, import_fbx_mesh_job, &import);
+    free(parts);
+
+    for (uint32_t i = 0; i < model->mesh_count; i++) {
+        if (!model->meshes[i]) {
+            printf("Failed to load mesh %u.\n", i);
+            for (uint32_t j = 0; j < model->mesh_count; j++) {
+                mesh_free(model->meshes[j]);
+            }
+            free(model->meshes);
+            model->meshes = NULL;
+            model->mesh_count = 0;
+            ufbx_free_scene(scene);
+            return -4;
+        }
+    }
+
+    *scene_out = scene;
+    return 1;
+}
+
+// Create the materials of a model built by model_load_fbx_geometry, then free the scene
+int model_load_fbx_materials(Model *model, ufbx_scene *scene, const char *file_path) {
+    if (!model || !scene) return -1;
+
+    if (!model_alloc_material_table(model, (uint32_t)scene->materials.count)) {
+        ufbx_free_scene(scene);
+        return -1;
+    }
+
+    // Same sharing as the glTF pass, one material per table entry
+    for (uint32_t i = 0; i < model->mesh_count; i++) {
+        uint32_t index = model->meshes[i]->material_index;
+        if (index == MESH_NO_MATERIAL) continue;
+
+        if (!model->materials[index]) {
+            MaterialSource source;
+            model_fbx_material_source(scene->materials.data[index], &source);
+            model->materials[index] = load_material(&source, file_path);
+        }
+        mesh_set_material(model->meshes[i], model->materials[index]);
+    }
+
+    ufbx_free_scene(scene);
+    return 1;
+}
+
+int model_load_fbx(Model *model, const char *file_path, bool apply_parent_transform) {
+    // Baked like glTF models ("a/b.fbx" -> "a/b.lmesh")
+    char baked_path[1024];
+    model_baked_path(file_path, baked_path, sizeof(baked_path));
+    if (model_load_baked(model, baked_path, apply_parent_transform) >= 0) return 1;
+
+    ufbx_scene *scene = NULL;
+    int result = model_load_fbx_geometry(model, file_path, apply_parent_transform, &scene);
+    if (result < 0) return result;
+
+    return model_load_fbx_materials(model, scene, file_path);
+}
+
 // Free model resources
 void model_free(Model *model) {
     if (model) {
+        if (model->transforms && model->transform != TRANSFORM_NONE) {
+            transform_destroy(model->transforms, model->transform); // Also drops the mesh nodes
+        }
         for (uint32_t i = 0; i < model->mesh_count; i++) {
             mesh_free(model->meshes[i]);
         }
         free(model->meshes);
+        for (uint32_t i = 0; i < model->material_count; i++) {
+            if (model->materials[i]) material_free(model->materials[i]);
+        }
+        free(model->materials);
+        vfs_close(&model->baked); // After the meshes, they point into it
         free(model);
     }
 }
\ No newline at end of file
@@ -1,27 +1,15 @@
 #include <entities/static/cube.h>
 
 #include <pipeline/shader.h>
+#include <pipeline/resources.h>
 #include <pipeline/buffers.h>
 
 #include <cglm/cglm.h>
 #include <stdbool.h>
 
-#include <qreader.h>
-
 void create_debug_cube_shaders(Cube* cube, const char* vertex_shader, const char* fragment_shader) {
-	// Compile shaders and create shader program
-    char* vertexShaderSource = read_file(vertex_shader);
-    char* fragmentShaderSource = read_file(fragment_shader);
-    if (!vertexShaderSource || !fragmentShaderSource) {
-        fprintf(stderr, "Failed to load debug shader sources!\n");
-        return;
-    }
-
-	ShaderProgram shader;
-
-    shader = shader_create(vertexShaderSource, fragmentShaderSource);
-    free(vertexShaderSource);
-    free(fragmentShaderSource);
+	// Shared program, release it with resources_program_release
+	ShaderProgram shader = resources_program_acquire(vertex_shader, fragment_shader);
 
     if (shader.id == 0) {
         fprintf(stderr, "Debug shader program creation failed!\n");
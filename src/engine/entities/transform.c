@@ -0,0 +1,458 @@
+#include <entities/transform.h>
+#include <cglm/cglm.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+	#include <malloc.h>
+#endif
+
+// Matrices are loaded with aligned SIMD loads, so they need CGLM_ALIGN_MAT storage
+#define TRANSFORM_ALIGNMENT 32
+
+static void *aligned_alloc_matrices(size_t count) {
+#ifdef _WIN32
+    return _aligned_malloc(count * sizeof(mat4), TRANSFORM_ALIGNMENT);
+#else
+    void *ptr = NULL;
+    if (posix_memalign(&ptr, TRANSFORM_ALIGNMENT, count * sizeof(mat4)) != 0) return NULL;
+    return ptr;
+#endif
+}
+
+static void aligned_free_matrices(void *ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+// Compose T * R * S directly: rotation columns scaled by the scale, translation written in place
+void transform_compose(vec3 position, versor rotation, vec3 scale, mat4 dest) {
+    glm_quat_mat4(rotation, dest);
+    glm_vec4_scale(dest[0], scale[0], dest[0]);
+    glm_vec4_scale(dest[1], scale[1], dest[1]);
+    glm_vec4_scale(dest[2], scale[2], dest[2]);
+    glm_vec4_copy((vec4){position[0], position[1], position[2], 1.0f}, dest[3]);
+}
+
+// Compose T * S * Rx * Ry * Rz directly: rotation rows scaled by the scale, translation written in place
+void transform_compose_euler(vec3 position, vec3 euler_degrees, vec3 scale, mat4 dest) {
+    vec3 radians = { glm_rad(euler_degrees[0]), glm_rad(euler_degrees[1]), glm_rad(euler_degrees[2]) };
+    vec4 row_scale = { scale[0], scale[1], scale[2], 1.0f };
+
+    glm_euler_xyz(radians, dest);
+    glm_vec4_mul(dest[0], row_scale, dest[0]);
+    glm_vec4_mul(dest[1], row_scale, dest[1]);
+    glm_vec4_mul(dest[2], row_scale, dest[2]);
+    glm_vec4_copy((vec4){position[0], position[1], position[2], 1.0f}, dest[3]);
+}
+
+// Grow the dense arrays to hold at least `capacity` transforms
+static bool transform_reserve(TransformSystem *system, uint32_t capacity) {
+    if (capacity <= system->capacity) return true;
+
+    mat4 *locals = aligned_alloc_matrices(capacity);
+    mat4 *worlds = aligned_alloc_matrices(capacity);
+    vec3 *positions = realloc(system->positions, sizeof(vec3) * capacity);
+    if (positions) system->positions = positions;
+    versor *rotations = realloc(system->rotations, sizeof(versor) * capacity);
+    if (rotations) system->rotations = rotations;
+    vec3 *scales = realloc(system->scales, sizeof(vec3) * capacity);
+    if (scales) system->scales = scales;
+    uint32_t *parents = realloc(system->parents, sizeof(uint32_t) * capacity);
+    if (parents) system->parents = parents;
+    uint8_t *flags = realloc(system->flags, sizeof(uint8_t) * capacity);
+    if (flags) system->flags = flags;
+    TransformId *dense_to_id = realloc(system->dense_to_id, sizeof(TransformId) * capacity);
+    if (dense_to_id) system->dense_to_id = dense_to_id;
+
+    if (!locals || !worlds || !positions || !rotations || !scales || !parents || !flags || !dense_to_id) {
+        fprintf(stderr, "[TRANSFORM] Failed to grow transform storage to %u entries.\n", capacity);
+        aligned_free_matrices(locals);
+        aligned_free_matrices(worlds);
+        return false;
+    }
+
+    if (system->count) {
+        memcpy(locals, system->locals, sizeof(mat4) * system->count);
+        memcpy(worlds, system->worlds, sizeof(mat4) * system->count);
+    }
+    aligned_free_matrices(system->locals);
+    aligned_free_matrices(system->worlds);
+    system->locals = locals;
+    system->worlds = worlds;
+    system->capacity = capacity;
+    return true;
+}
+
+static void mark_dirty(TransformSystem *system, uint32_t dense) {
+    system->flags[dense] |= TRANSFORM_FLAG_DIRTY;
+    if (dense < system->dirty_min) system->dirty_min = dense;
+}
+
+static uint32_t dense_index(const TransformSystem *system, TransformId id) {
+    if (id == TRANSFORM_NONE || id >= system->id_capacity) return TRANSFORM_NONE;
+    return system->id_to_dense[id];
+}
+
+void transform_system_init(TransformSystem *system, uint32_t initial_capacity) {
+    memset(system, 0, sizeof(TransformSystem));
+    transform_reserve(system, initial_capacity ? initial_capacity : 64);
+}
+
+void transform_system_free(TransformSystem *system) {
+    if (!system) return;
+
+    aligned_free_matrices(system->locals);
+    aligned_free_matrices(system->worlds);
+    free(system->positions);
+    free(system->rotations);
+    free(system->scales);
+    free(system->parents);
+    free(system->flags);
+    free(system->dense_to_id);
+    free(system->id_to_dense);
+    free(system->free_ids);
+    memset(system, 0, sizeof(TransformSystem));
+}
+
+TransformId transform_create(TransformSystem *system, TransformId parent) {
+    uint32_t parent_dense = TRANSFORM_NONE;
+    if (parent != TRANSFORM_NONE) {
+        parent_dense = dense_index(system, parent);
+        if (parent_dense == TRANSFORM_NONE) {
+            fprintf(stderr, "[TRANSFORM] Invalid parent transform %u.\n", parent);
+            return TRANSFORM_NONE;
+        }
+    }
+
+    if (system->count >= system->capacity && !transform_reserve(system, system->capacity * 2)) {
+        return TRANSFORM_NONE;
+    }
+
+    // Reuse a handle if one was released, otherwise grow the handle table
+    TransformId id;
+    if (system->free_count) {
+        id = system->free_ids[--system->free_count];
+    } else {
+        if (system->id_capacity % 64 == 0) {
+            uint32_t *id_to_dense = realloc(system->id_to_dense, sizeof(uint32_t) * (system->id_capacity + 64));
+            TransformId *free_ids = realloc(system->free_ids, sizeof(TransformId) * (system->id_capacity + 64));
+            if (id_to_dense) system->id_to_dense = id_to_dense;
+            if (free_ids) system->free_ids = free_ids;
+            if (!id_to_dense || !free_ids) {
+                fprintf(stderr, "[TRANSFORM] Failed to grow transform handle table.\n");
+                return TRANSFORM_NONE;
+            }
+        }
+        id = system->id_capacity++;
+    }
+
+    // Appending keeps the topological order since the parent already exists
+    uint32_t dense = system->count++;
+    system->id_to_dense[id] = dense;
+    system->dense_to_id[dense] = id;
+    system->parents[dense] = parent_dense;
+    system->flags[dense] = 0;
+
+    glm_vec3_zero(system->positions[dense]);
+    glm_quat_identity(system->rotations[dense]);
+    glm_vec3_one(system->scales[dense]);
+    glm_mat4_identity(system->locals[dense]);
+    glm_mat4_identity(system->worlds[dense]);
+
+    mark_dirty(system, dense);
+    return id;
+}
+
+// Reorder every array so that dense index `i` moves to `order_inverse[i]`
+static void transform_permute(TransformSystem *system, const uint32_t *order) {
+    uint32_t count = system->count;
+    uint32_t *inverse = malloc(sizeof(uint32_t) * count);
+    mat4 *locals = aligned_alloc_matrices(count);
+    mat4 *worlds = aligned_alloc_matrices(count);
+    vec3 *positions = malloc(sizeof(vec3) * count);
+    versor *rotations = malloc(sizeof(versor) * count);
+    vec3 *scales = malloc(sizeof(vec3) * count);
+    uint32_t *parents = malloc(sizeof(uint32_t) * count);
+    uint8_t *flags = malloc(sizeof(uint8_t) * count);
+    TransformId *dense_to_id = malloc(sizeof(TransformId) * count);
+
+    if (!inverse || !locals || !worlds || !positions || !rotations || !scales || !parents || !flags || !dense_to_id) {
+        fprintf(stderr, "[TRANSFORM] Failed to allocate memory while re-sorting the hierarchy.\n");
+        goto cleanup;
+    }
+
+    for (uint32_t i = 0; i < count; i++) inverse[order[i]] = i;
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t src = order[i];
+        glm_mat4_copy(system->locals[src], locals[i]);
+        glm_mat4_copy(system->worlds[src], worlds[i]);
+        glm_vec3_copy(system->positions[src], positions[i]);
+        glm_quat_copy(system->rotations[src], rotations[i]);
+        glm_vec3_copy(system->scales[src], scales[i]);
+        parents[i] = system->parents[src] == TRANSFORM_NONE ? TRANSFORM_NONE : inverse[system->parents[src]];
+        flags[i] = system->flags[src];
+        dense_to_id[i] = system->dense_to_id[src];
+        system->id_to_dense[dense_to_id[i]] = i;
+    }
+
+    memcpy(system->locals, locals, sizeof(mat4) * count);
+    memcpy(system->worlds, worlds, sizeof(mat4) * count);
+    memcpy(system->positions, positions, sizeof(vec3) * count);
+    memcpy(system->rotations, rotations, sizeof(versor) * count);
+    memcpy(system->scales, scales, sizeof(vec3) * count);
+    memcpy(system->parents, parents, sizeof(uint32_t) * count);
+    memcpy(system->flags, flags, sizeof(uint8_t) * count);
+    memcpy(system->dense_to_id, dense_to_id, sizeof(TransformId) * count);
+
+    // Positions moved around, so the next update has to look at everything
+    system->dirty_min = 0;
+    system->changed_min = 0;
+
+cleanup:
+    free(inverse);
+    aligned_free_matrices(locals);
+    aligned_free_matrices(worlds);
+    free(positions);
+    free(rotations);
+    free(scales);
+    free(parents);
+    free(flags);
+    free(dense_to_id);
+}
+
+// Rebuild the topological order (pre-order walk from the roots, keeping sibling order stable)
+static void transform_sort(TransformSystem *system) {
+    uint32_t count = system->count;
+    uint32_t *child_start = calloc(count + 1, sizeof(uint32_t));
+    uint32_t *children = malloc(sizeof(uint32_t) * count);
+    uint32_t *order = malloc(sizeof(uint32_t) * count);
+    uint32_t *stack = malloc(sizeof(uint32_t) * count);
+
+    if (!child_start || !children || !order || !stack) {
+        fprintf(stderr, "[TRANSFORM] Failed to allocate memory while sorting the hierarchy.\n");
+        goto cleanup;
+    }
+
+    // Bucket children by parent (CSR layout)
+    for (uint32_t i = 0; i < count; i++) {
+        if (system->parents[i] != TRANSFORM_NONE) child_start[system->parents[i] + 1]++;
+    }
+    for (uint32_t i = 0; i < count; i++) child_start[i + 1] += child_start[i];
+    uint32_t *fill = stack; // Reuse the stack as a temporary fill cursor
+    memcpy(fill, child_start, sizeof(uint32_t) * count);
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t parent = system->parents[i];
+        if (parent != TRANSFORM_NONE) children[fill[parent]++] = i;
+    }
+
+    // Depth-first walk from every root
+    uint32_t written = 0;
+    for (uint32_t root = 0; root < count; root++) {
+        if (system->parents[root] != TRANSFORM_NONE) continue;
+
+        uint32_t top = 0;
+        stack[top++] = root;
+        while (top) {
+            uint32_t node = stack[--top];
+            order[written++] = node;
+            // Push in reverse so the first child is visited first
+            for (uint32_t c = child_start[node + 1]; c > child_start[node]; c--) {
+                stack[top++] = children[c - 1];
+            }
+        }
+    }
+
+    transform_permute(system, order);
+
+cleanup:
+    free(child_start);
+    free(children);
+    free(order);
+    free(stack);
+}
+
+void transform_set_parent(TransformSystem *system, TransformId id, TransformId parent) {
+    uint32_t dense = dense_index(system, id);
+    if (dense == TRANSFORM_NONE) {
+        fprintf(stderr, "[TRANSFORM] Invalid transform %u.\n", id);
+        return;
+    }
+
+    uint32_t parent_dense = TRANSFORM_NONE;
+    if (parent != TRANSFORM_NONE) {
+        parent_dense = dense_index(system, parent);
+        if (parent_dense == TRANSFORM_NONE) {
+            fprintf(stderr, "[TRANSFORM] Invalid parent transform %u.\n", parent);
+            return;
+        }
+
+        // Reject cycles: the new parent must not live in this node's subtree
+        for (uint32_t p = parent_dense; p != TRANSFORM_NONE; p = system->parents[p]) {
+            if (p == dense) {
+                fprintf(stderr, "[TRANSFORM] Cannot parent transform %u to its own descendant %u.\n", id, parent);
+                return;
+            }
+        }
+    }
+
+    if (system->parents[dense] == parent_dense) return;
+
+    system->parents[dense] = parent_dense;
+    mark_dirty(system, dense);
+
+    if (parent_dense != TRANSFORM_NONE && parent_dense > dense) {
+        transform_sort(system);
+    }
+}
+
+void transform_destroy(TransformSystem *system, TransformId id) {
+    uint32_t dense = dense_index(system, id);
+    if (dense == TRANSFORM_NONE) {
+        fprintf(stderr, "[TRANSFORM] Invalid transform %u.\n", id);
+        return;
+    }
+
+    // Descendants always come after their parent, so one forward pass finds the whole subtree
+    uint32_t *remap = malloc(sizeof(uint32_t) * system->count);
+    if (!remap) {
+        fprintf(stderr, "[TRANSFORM] Failed to allocate memory while destroying transform %u.\n", id);
+        return;
+    }
+
+    uint32_t write = dense;
+    for (uint32_t i = 0; i < dense; i++) remap[i] = i;
+    for (uint32_t i = dense; i < system->count; i++) {
+        uint32_t parent = system->parents[i];
+        bool removed = (i == dense) || (parent != TRANSFORM_NONE && parent >= dense && remap[parent] == TRANSFORM_NONE);
+
+        if (removed) {
+            remap[i] = TRANSFORM_NONE;
+            TransformId freed = system->dense_to_id[i];
+            system->id_to_dense[freed] = TRANSFORM_NONE;
+            system->free_ids[system->free_count++] = freed;
+            continue;
+        }
+
+        // Compact in place, preserving order
+        remap[i] = write;
+        if (write != i) {
+            glm_mat4_copy(system->locals[i], system->locals[write]);
+            glm_mat4_copy(system->worlds[i], system->worlds[write]);
+            glm_vec3_copy(system->positions[i], system->positions[write]);
+            glm_quat_copy(system->rotations[i], system->rotations[write]);
+            glm_vec3_copy(system->scales[i], system->scales[write]);
+            system->flags[write] = system->flags[i];
+            system->dense_to_id[write] = system->dense_to_id[i];
+            system->id_to_dense[system->dense_to_id[write]] = write;
+        }
+        system->parents[write] = parent == TRANSFORM_NONE ? TRANSFORM_NONE : remap[parent];
+        write++;
+    }
+
+    system->count = write;
+    if (system->dirty_min > dense) system->dirty_min = dense;
+    if (system->changed_min > dense) system->changed_min = dense;
+    free(remap);
+}
+
+void transform_set_position(TransformSystem *system, TransformId id, vec3 position) {
+    uint32_t dense = dense_index(system, id);
+    if (dense == TRANSFORM_NONE || glm_vec3_eqv(system->positions[dense], position)) return;
+
+    glm_vec3_copy(position, system->positions[dense]);
+    mark_dirty(system, dense);
+}
+
+void transform_set_rotation(TransformSystem *system, TransformId id, versor rotation) {
+    uint32_t dense = dense_index(system, id);
+    if (dense == TRANSFORM_NONE || glm_vec4_eqv(system->rotations[dense], rotation)) return;
+
+    glm_quat_copy(rotation, system->rotations[dense]);
+    mark_dirty(system, dense);
+}
+
+void transform_set_scale(TransformSystem *system, TransformId id, vec3 scale) {
+    uint32_t dense = dense_index(system, id);
+    if (dense == TRANSFORM_NONE || glm_vec3_eqv(system->scales[dense], scale)) return;
+
+    glm_vec3_copy(scale, system->scales[dense]);
+    mark_dirty(system, dense);
+}
+
+void transform_set_trs(TransformSystem *system, TransformId id, vec3 position, versor rotation, vec3 scale) {
+    transform_set_position(system, id, position);
+    transform_set_rotation(system, id, rotation);
+    transform_set_scale(system, id, scale);
+}
+
+void transform_set_local_matrix(TransformSystem *system, TransformId id, mat4 local) {
+    uint32_t dense = dense_index(system, id);
+    if (dense == TRANSFORM_NONE) return;
+
+    uint8_t flags = system->flags[dense];
+    if ((flags & TRANSFORM_FLAG_LOCAL_MATRIX) && memcmp(system->locals[dense], local, sizeof(mat4)) == 0) return;
+
+    glm_mat4_copy(local, system->locals[dense]);
+    system->flags[dense] = flags | TRANSFORM_FLAG_LOCAL_MATRIX;
+    mark_dirty(system, dense);
+}
+
+void transform_system_update(TransformSystem *system) {
+    uint32_t start = system->dirty_min < system->changed_min ? system->dirty_min : system->changed_min;
+    uint32_t count = system->count;
+    uint32_t changed_min = count;
+
+    // Nothing moved and no change flags left to clear
+    if (start >= count) return;
+
+    mat4 *locals = system->locals;
+    mat4 *worlds = system->worlds;
+    uint32_t *parents = system->parents;
+    uint8_t *flags = system->flags;
+
+    for (uint32_t i = start; i < count; i++) {
+        uint8_t f = flags[i] & ~TRANSFORM_FLAG_CHANGED;
+        uint32_t parent = parents[i];
+
+        // Parents were already visited this pass, so their CHANGED bit is current
+        bool rebuild = (f & TRANSFORM_FLAG_DIRTY) || (parent != TRANSFORM_NONE && (flags[parent] & TRANSFORM_FLAG_CHANGED));
+
+        if (rebuild) {
+            if ((f & TRANSFORM_FLAG_DIRTY) && !(f & TRANSFORM_FLAG_LOCAL_MATRIX)) {
+                transform_compose(system->positions[i], system->rotations[i], system->scales[i], locals[i]);
+            }
+
+            if (parent == TRANSFORM_NONE) {
+                glm_mat4_copy(locals[i], worlds[i]);
+            } else {
+                glm_mat4_mul(worlds[parent], locals[i], worlds[i]);
+            }
+
+            f |= TRANSFORM_FLAG_CHANGED;
+            if (changed_min == count) changed_min = i;
+        }
+
+        flags[i] = f & ~TRANSFORM_FLAG_DIRTY;
+    }
+
+    system->dirty_min = count;
+    system->changed_min = changed_min;
+}
+
+vec4 *transform_world(TransformSystem *system, TransformId id) {
+    uint32_t dense = dense_index(system, id);
+    if (dense == TRANSFORM_NONE) return NULL;
+    return system->worlds[dense];
+}
+
+bool transform_changed(const TransformSystem *system, TransformId id) {
+    uint32_t dense = dense_index(system, id);
+    if (dense == TRANSFORM_NONE) return false;
+    return (system->flags[dense] & TRANSFORM_FLAG_CHANGED) != 0;
+}
@@ -0,0 +1,89 @@
+#include <output/audio.h>
+#include <output/voices.h>
+#include <output/stream.h>
+
+#include <string.h>
+
+enum {
+    CACHED_POSITION = 1u << AUDIO_FLOAT_PARAMS,
+    CACHED_BUFFER = CACHED_POSITION << 1,
+    CACHED_LOOPING = CACHED_POSITION << 2,
+    CACHED_RELATIVE = CACHED_POSITION << 3
+};
+
+static const ALenum float_params[AUDIO_FLOAT_PARAMS] = {
+    AL_GAIN, AL_PITCH, AL_REFERENCE_DISTANCE, AL_MAX_DISTANCE, AL_ROLLOFF_FACTOR
+};
+
+static float listener_position[3];
+static float listener_orientation[6];
+static bool listener_valid = false;
+
+void audio_source_setf(AudioSourceCache* cache, ALuint source, AudioFloatParam param, float value) {
+    uint32_t bit = 1u << param;
+    if ((cache->valid & bit) && cache->floats[param] == value) return;
+    alSourcef(source, float_params[param], value);
+    cache->floats[param] = value;
+    cache->valid |= bit;
+}
+
+void audio_source_set_position(AudioSourceCache* cache, ALuint source, const float position[3]) {
+    if ((cache->valid & CACHED_POSITION) && memcmp(cache->position, position, sizeof(cache->position)) == 0) return;
+    alSourcefv(source, AL_POSITION, position);
+    memcpy(cache->position, position, sizeof(cache->position));
+    cache->valid |= CACHED_POSITION;
+}
+
+void audio_source_set_buffer(AudioSourceCache* cache, ALuint source, ALuint buffer) {
+    if ((cache->valid & CACHED_BUFFER) && cache->buffer == buffer) return;
+    alSourcei(source, AL_BUFFER, (ALint)buffer);
+    cache->buffer = buffer;
+    cache->valid |= CACHED_BUFFER;
+}
+
+void audio_source_set_looping(AudioSourceCache* cache, ALuint source, bool looping) {
+    if ((cache->valid & CACHED_LOOPING) && cache->looping == looping) return;
+    alSourcei(source, AL_LOOPING, looping ? AL_TRUE : AL_FALSE);
+    cache->looping = looping;
+    cache->valid |= CACHED_LOOPING;
+}
+
+void audio_source_set_relative(AudioSourceCache* cache, ALuint source, bool relative) {
+    if ((cache->valid & CACHED_RELATIVE) && cache->relative == relative) return;
+    alSourcei(source, AL_SOURCE_RELATIVE, relative ? AL_TRUE : AL_FALSE);
+    cache->relative = relative;
+    cache->valid |= CACHED_RELATIVE;
+}
+
+void audio_source_invalidate(AudioSourceCache* cache) {
+    cache->valid = 0;
+}
+
+void audio_listener_set(const float position[3], const float forward[3], const float up[3]) {
+    float orientation[6] = { forward[0], forward[1], forward[2], up[0], up[1], up[2] };
+
+    if (!listener_valid || memcmp(listener_position, position, sizeof(listener_position)) != 0) {
+        alListener3f(AL_POSITION, position[0], position[1], position[2]);
+        memcpy(listener_position, position, sizeof(listener_position));
+    }
+    if (!listener_valid || memcmp(listener_orientation, orientation, sizeof(listener_orientation)) != 0) {
+        alListenerfv(AL_ORIENTATION, orientation);
+        memcpy(listener_orientation, orientation, sizeof(listener_orientation));
+    }
+    listener_valid = true;
+}
+
+const float* audio_listener_position() {
+    return listener_position;
+}
+
+void audio_reset() {
+    memset(listener_position, 0, sizeof(listener_position));
+    listener_valid = false;
+}
+
+void audio_update(const float listener_pos[3], const float listener_dir[3], const float listener_up[3]) {
+    audio_listener_set(listener_pos, listener_dir, listener_up);
+    sound_voices_update();
+    sound_streams_update();
+}
@@ -0,0 +1,477 @@
+#include <output/mixer.h>
+#include <jobs/thread.h>
+#include <jobs/trace.h>
+#include <wav.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdatomic.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define MIXER_SSE2 1
+#endif
+
+enum { EVENT_PLAY, EVENT_SET, EVENT_STOP };
+
+typedef struct {
+    uint32_t type;
+    MixerVoice voice;
+    MixerClip clip;
+    float volume, pan, attenuation;
+    uint64_t time_ns;         // When the game asked, for latency
+} MixerEvent;
+
+typedef struct {
+    float* samples;           // Mono, at the mixer rate
+    uint32_t frame_count;
+} Clip;
+
+// Audio thread only
+typedef struct {
+    MixerVoice handle;        // 0 when free
+    MixerClip clip;
+    uint32_t position;        // Next frame
+    uint64_t order;           // Start order, the oldest voice is replaced when all are busy
+    float gain[2];            // Left / right gain reached at the end of the last block
+    float target[2];
+    bool stopping;            // Ramps to silence over one block, then frees
+} Voice;
+
+static Clip clips[MIXER_MAX_CLIPS];
+static _Atomic int clip_count = 0;
+
+// Single-producer single-consumer ring, tail written by the game thread and head by the audio thread
+static MixerEvent events[MIXER_QUEUE_SIZE];
+static _Atomic uint32_t event_head = 0, event_tail = 0;
+static MixerVoice next_handle = 0;
+
+static Voice voices[MIXER_MAX_VOICES];
+static uint64_t voice_order = 0;
+static float mix_left[MIXER_BLOCK_FRAMES], mix_right[MIXER_BLOCK_FRAMES];
+static int16_t block_output[MIXER_BLOCK_FRAMES * 2];
+
+static MixerOutput* output = NULL;
+static uint32_t mixer_rate = 0;
+static Thread audio_thread;
+static _Atomic bool running = false;
+static _Atomic bool failed = false; // The output failed, nothing drains the queue any more
+static bool threaded = false;
+
+static struct {
+    _Atomic uint64_t blocks, frames, mix_ns, triggers, dropped, latency_ns_total, latency_ns_max;
+    _Atomic uint32_t voices_peak;
+} stats;
+
+// ----------------------------------------------------------------------------
+// Kernels
+// ----------------------------------------------------------------------------
+
+// Add samples with the gain ramping linearly from start to end over the block, so changes never click
+static void mix_voice(const float* samples, uint32_t frames, const float start[2], const float end[2]) {
+    float step_left = (end[0] - start[0]) / MIXER_BLOCK_FRAMES;
+    float step_right = (end[1] - start[1]) / MIXER_BLOCK_FRAMES;
+    uint32_t i = 0;
+#ifdef MIXER_SSE2
+    __m128 ramp = _mm_setr_ps(1.0f, 2.0f, 3.0f, 4.0f);
+    __m128 gain_left = _mm_add_ps(_mm_set1_ps(start[0]), _mm_mul_ps(ramp, _mm_set1_ps(step_left)));
+    __m128 gain_right = _mm_add_ps(_mm_set1_ps(start[1]), _mm_mul_ps(ramp, _mm_set1_ps(step_right)));
+    __m128 advance_left = _mm_set1_ps(step_left * 4.0f);
+    __m128 advance_right = _mm_set1_ps(step_right * 4.0f);
+    for (; i + 4 <= frames; i += 4) {
+        __m128 sample = _mm_loadu_ps(samples + i);
+        _mm_storeu_ps(mix_left + i, _mm_add_ps(_mm_loadu_ps(mix_left + i), _mm_mul_ps(sample, gain_left)));
+        _mm_storeu_ps(mix_right + i, _mm_add_ps(_mm_loadu_ps(mix_right + i), _mm_mul_ps(sample, gain_right)));
+        gain_left = _mm_add_ps(gain_left, advance_left);
+        gain_right = _mm_add_ps(gain_right, advance_right);
+    }
+#endif
+    for (; i < frames; i++) {
+        mix_left[i] += samples[i] * (start[0] + step_left * (float)(i + 1));
+        mix_right[i] += samples[i] * (start[1] + step_right * (float)(i + 1));
+    }
+}
+
+// Clamp and interleave the block into 16-bit stereo
+static void mix_to_s16(int16_t* dest) {
+    uint32_t i = 0;
+#ifdef MIXER_SSE2
+    const __m128 scale = _mm_set1_ps(32767.0f), one = _mm_set1_ps(1.0f), minus_one = _mm_set1_ps(-1.0f);
+    for (; i + 8 <= MIXER_BLOCK_FRAMES; i += 8) {
+        __m128i l0 = _mm_cvtps_epi32(_mm_mul_ps(_mm_max_ps(_mm_min_ps(_mm_loadu_ps(mix_left + i), one), minus_one), scale));
+        __m128i l1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_max_ps(_mm_min_ps(_mm_loadu_ps(mix_left + i + 4), one), minus_one), scale));
+        __m128i r0 = _mm_cvtps_epi32(_mm_mul_ps(_mm_max_ps(_mm_min_ps(_mm_loadu_ps(mix_right + i), one), minus_one), scale));
+        __m128i r1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_max_ps(_mm_min_ps(_mm_loadu_ps(mix_right + i + 4), one), minus_one), scale));
+        __m128i left = _mm_packs_epi32(l0, l1), right = _mm_packs_epi32(r0, r1);
+        _mm_storeu_si128((__m128i*)(dest + i * 2), _mm_unpacklo_epi16(left, right));
+        _mm_storeu_si128((__m128i*)(dest + i * 2 + 8), _mm_unpackhi_epi16(left, right));
+    }
+#endif
+    for (; i < MIXER_BLOCK_FRAMES; i++) {
+        float left = mix_left[i] > 1.0f ? 1.0f : mix_left[i] < -1.0f ? -1.0f : mix_left[i];
+        float right = mix_right[i] > 1.0f ? 1.0f : mix_right[i] < -1.0f ? -1.0f : mix_right[i];
+        dest[i * 2] = (int16_t)lrintf(left * 32767.0f);
+        dest[i * 2 + 1] = (int16_t)lrintf(right * 32767.0f);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Audio thread
+// ----------------------------------------------------------------------------
+
+static void pan_gains(float volume, float pan, float attenuation, float gains[2]) {
+    // Equal power, so a sound keeps its loudness while it moves across
+    float angle = (pan < -1.0f ? -1.0f : pan > 1.0f ? 1.0f : pan) * 0.25f * 3.14159265f + 0.25f * 3.14159265f;
+    float gain = volume * attenuation;
+    gains[0] = gain * cosf(angle);
+    gains[1] = gain * sinf(angle);
+}
+
+static Voice* find_voice(MixerVoice handle) {
+    for (int i = 0; i < MIXER_MAX_VOICES; i++) {
+        if (voices[i].handle == handle) return &voices[i];
+    }
+    return NULL;
+}
+
+// Apply queued events, returns how many voices started and the sum and minimum of their trigger times
+static uint32_t drain_events(uint64_t* time_sum, uint64_t* time_min) {
+    uint32_t started = 0;
+    uint32_t head = atomic_load_explicit(&event_head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&event_tail, memory_order_acquire);
+
+    for (; head != tail; head++) {
+        const MixerEvent* event = &events[head & (MIXER_QUEUE_SIZE - 1)];
+        Voice* voice = event->type == EVENT_PLAY ? NULL : find_voice(event->voice);
+
+        if (event->type == EVENT_PLAY) {
+            // A free voice, else the oldest one
+            Voice* slot = &voices[0];
+            for (int i = 0; i < MIXER_MAX_VOICES; i++) {
+                if (!voices[i].handle) {
+                    slot = &voices[i];
+                    break;
+                }
+                if (voices[i].order < slot->order) slot = &voices[i];
+            }
+            if (slot->handle) atomic_fetch_add(&stats.dropped, 1);
+
+            *slot = (Voice){ .handle = event->voice, .clip = event->clip, .position = 0, .order = ++voice_order };
+            pan_gains(event->volume, event->pan, event->attenuation, slot->target);
+            slot->gain[0] = slot->target[0]; // Starts at full level, hits need their transient
+            slot->gain[1] = slot->target[1];
+
+            started++;
+            *time_sum += event->time_ns;
+            if (event->time_ns < *time_min) *time_min = event->time_ns;
+        } else if (voice && event->type == EVENT_SET) {
+            pan_gains(event->volume, event->pan, event->attenuation, voice->target);
+        } else if (voice) {
+            voice->target[0] = voice->target[1] = 0.0f;
+            voice->stopping = true;
+        }
+    }
+    atomic_store_explicit(&event_head, head, memory_order_release);
+    return started;
+}
+
+static bool mix_block() {
+    uint64_t time_sum = 0, time_min = UINT64_MAX;
+    uint32_t started = drain_events(&time_sum, &time_min);
+
+    uint64_t mix_start = clock_now_ns();
+    memset(mix_left, 0, sizeof(mix_left));
+    memset(mix_right, 0, sizeof(mix_right));
+
+    uint32_t active = 0;
+    int count = atomic_load_explicit(&clip_count, memory_order_acquire);
+    for (int i = 0; i < MIXER_MAX_VOICES; i++) {
+        Voice* voice = &voices[i];
+        if (!voice->handle) continue;
+        if (voice->clip < 0 || voice->clip >= count) {
+            voice->handle = 0;
+            continue;
+        }
+
+        const Clip* clip = &clips[voice->clip];
+        uint32_t frames = clip->frame_count - voice->position;
+        if (frames > MIXER_BLOCK_FRAMES) frames = MIXER_BLOCK_FRAMES;
+        mix_voice(clip->samples + voice->position, frames, voice->gain, voice->target);
+        voice->gain[0] = voice->target[0];
+        voice->gain[1] = voice->target[1];
+        voice->position += frames;
+        active++;
+
+        if (voice->position >= clip->frame_count || voice->stopping) voice->handle = 0;
+    }
+    mix_to_s16(block_output);
+
+    uint64_t mix_end = clock_now_ns();
+    atomic_fetch_add(&stats.mix_ns, mix_end - mix_start);
+    atomic_fetch_add(&stats.blocks, 1);
+    atomic_fetch_add(&stats.frames, MIXER_BLOCK_FRAMES);
+    if (active > atomic_load(&stats.voices_peak)) atomic_store(&stats.voices_peak, active);
+
+    bool ok = output->write(output, block_output, MIXER_BLOCK_FRAMES);
+
+    // Latency runs up to the block leaving the mixer, plus what the output still holds in front of it
+    if (started) {
+        uint64_t written = clock_now_ns() + (uint64_t)output->latency_frames * 1000000000ull / mixer_rate;
+        atomic_fetch_add(&stats.latency_ns_total, written * started - time_sum);
+        if (written - time_min > atomic_load(&stats.latency_ns_max)) atomic_store(&stats.latency_ns_max, written - time_min);
+    }
+    return ok;
+}
+
+static void audio_main(void* arg) {
+    (void)arg;
+    TRACE_THREAD_NAME("Audio mixer");
+    while (atomic_load_explicit(&running, memory_order_acquire)) {
+        if (!mix_block()) {
+            fprintf(stderr, "[MIXER] Output failed, stopping the mixer\n");
+            atomic_store_explicit(&failed, true, memory_order_release);
+            break;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Game thread
+// ----------------------------------------------------------------------------
+
+static bool mixer_open(MixerOutput* target, uint32_t sample_rate) {
+    if (output) return false;
+    if (!target->open(target, sample_rate)) {
+        fprintf(stderr, "[MIXER] Failed to open the output\n");
+        return false;
+    }
+
+    output = target;
+    mixer_rate = sample_rate;
+    memset(voices, 0, sizeof(voices));
+    memset(&stats, 0, sizeof(stats));
+    atomic_store(&event_head, 0);
+    atomic_store(&event_tail, 0);
+    atomic_store(&failed, false);
+    return true;
+}
+
+static void mixer_close() {
+    output->close(output);
+    output = NULL;
+
+    int count = atomic_load(&clip_count);
+    for (int i = 0; i < count; i++) free(clips[i].samples);
+    atomic_store(&clip_count, 0);
+}
+
+bool mixer_start(MixerOutput* target, uint32_t sample_rate) {
+    if (!mixer_open(target, sample_rate)) return false;
+
+    atomic_store(&running, true);
+    threaded = thread_create(&audio_thread, audio_main, NULL);
+    if (!threaded) {
+        fprintf(stderr, "[MIXER] Failed to start the audio thread\n");
+        atomic_store(&running, false);
+        mixer_close();
+        return false;
+    }
+    return true;
+}
+
+void mixer_stop() {
+    if (!output || !threaded) return;
+    atomic_store_explicit(&running, false, memory_order_release);
+    thread_join(audio_thread);
+    threaded = false;
+    mixer_close();
+}
+
+bool mixer_stopping() {
+    return threaded && !atomic_load_explicit(&running, memory_order_relaxed);
+}
+
+bool mixer_render_begin(MixerOutput* target, uint32_t sample_rate) {
+    return mixer_open(target, sample_rate);
+}
+
+void mixer_render(uint32_t block_count) {
+    for (uint32_t i = 0; i < block_count && output; i++) {
+        if (!mix_block()) {
+            atomic_store_explicit(&failed, true, memory_order_release);
+            break;
+        }
+    }
+}
+
+void mixer_render_end() {
+    if (output && !threaded) mixer_close();
+}
+
+MixerClip mixer_clip_add(const int16_t* samples, size_t frame_count, uint32_t sample_rate) {
+    int index = atomic_load(&clip_count);
+    if (!output || index == MIXER_MAX_CLIPS || frame_count == 0 || sample_rate == 0) return -1;
+
+    // Resampled once here, voices then play the clip frame for frame
+    size_t count = wav_resampled_frames(frame_count, sample_rate, mixer_rate);
+    int16_t* resampled = NULL;
+    if (sample_rate != mixer_rate) {
+        resampled = malloc(count * sizeof(int16_t));
+        if (!resampled) return -1;
+        wav_resample_s16(samples, frame_count, sample_rate, mixer_rate, resampled);
+        samples = resampled;
+    }
+
+    float* converted = malloc(count * sizeof(float));
+    if (!converted) {
+        free(resampled);
+        return -1;
+    }
+    for (size_t i = 0; i < count; i++) converted[i] = samples[i] / 32768.0f;
+    free(resampled);
+
+    clips[index] = (Clip){ converted, (uint32_t)count };
+    atomic_store_explicit(&clip_count, index + 1, memory_order_release);
+    return index;
+}
+
+static bool push_event(MixerEvent* event) {
+    if (atomic_load_explicit(&failed, memory_order_acquire)) return false;
+    uint32_t tail = atomic_load_explicit(&event_tail, memory_order_relaxed);
+    if (tail - atomic_load_explicit(&event_head, memory_order_acquire) == MIXER_QUEUE_SIZE) {
+        atomic_fetch_add(&stats.dropped, 1);
+        return false;
+    }
+    events[tail & (MIXER_QUEUE_SIZE - 1)] = *event;
+    atomic_store_explicit(&event_tail, tail + 1, memory_order_release);
+    return true;
+}
+
+MixerVoice mixer_play(MixerClip clip, float volume, float pan, float attenuation) {
+    if (!output || clip < 0) return 0;
+    if (++next_handle == 0) next_handle = 1;
+
+    MixerEvent event = { EVENT_PLAY, next_handle, clip, volume, pan, attenuation, clock_now_ns() };
+    if (!push_event(&event)) return 0;
+    atomic_fetch_add(&stats.triggers, 1);
+    return event.voice;
+}
+
+void mixer_voice_set(MixerVoice voice, float volume, float pan, float attenuation) {
+    if (!output || !voice) return;
+    MixerEvent event = { EVENT_SET, voice, -1, volume, pan, attenuation, 0 };
+    push_event(&event);
+}
+
+void mixer_voice_stop(MixerVoice voice) {
+    if (!output || !voice) return;
+    MixerEvent event = { EVENT_STOP, voice, -1, 0.0f, 0.0f, 0.0f, 0 };
+    push_event(&event);
+}
+
+void mixer_get_stats(MixerStats* result) {
+    result->blocks = atomic_load(&stats.blocks);
+    result->frames = atomic_load(&stats.frames);
+    result->mix_ns = atomic_load(&stats.mix_ns);
+    result->triggers = atomic_load(&stats.triggers);
+    result->dropped = atomic_load(&stats.dropped);
+    result->latency_ns_total = atomic_load(&stats.latency_ns_total);
+    result->latency_ns_max = atomic_load(&stats.latency_ns_max);
+    result->voices_peak = atomic_load(&stats.voices_peak);
+}
+
+// ----------------------------------------------------------------------------
+// Outputs
+// ----------------------------------------------------------------------------
+
+typedef struct {
+    char path[256];
+    FILE* file;
+    uint32_t data_size;
+} WavOutput;
+
+static void wav_write_header(FILE* file, uint32_t sample_rate, uint32_t data_size) {
+    uint32_t riff_size = 36 + data_size, fmt_size = 16, byte_rate = sample_rate * 4;
+    uint16_t format = 1, channels = 2, block_align = 4, bits = 16;
+    fwrite("RIFF", 1, 4, file); fwrite(&riff_size, 4, 1, file); fwrite("WAVE", 1, 4, file);
+    fwrite("fmt ", 1, 4, file); fwrite(&fmt_size, 4, 1, file);
+    fwrite(&format, 2, 1, file); fwrite(&channels, 2, 1, file); fwrite(&sample_rate, 4, 1, file);
+    fwrite(&byte_rate, 4, 1, file); fwrite(&block_align, 2, 1, file); fwrite(&bits, 2, 1, file);
+    fwrite("data", 1, 4, file); fwrite(&data_size, 4, 1, file);
+}
+
+static bool wav_open(MixerOutput* self, uint32_t sample_rate) {
+    WavOutput* state = self->state;
+    state->file = fopen(state->path, "wb");
+    if (!state->file) return false;
+    state->data_size = 0;
+    wav_write_header(state->file, sample_rate, 0); // Sizes are patched on close
+    return true;
+}
+
+static bool wav_write(MixerOutput* self, const int16_t* frames, uint32_t frame_count) {
+    WavOutput* state = self->state;
+    size_t bytes = (size_t)frame_count * 2 * sizeof(int16_t);
+    if (fwrite(frames, 1, bytes, state->file) != bytes) return false;
+    state->data_size += (uint32_t)bytes;
+    return true;
+}
+
+static void wav_close(MixerOutput* self) {
+    WavOutput* state = self->state;
+    if (!state->file) return;
+    fseek(state->file, 0, SEEK_SET);
+    wav_write_header(state->file, mixer_rate, state->data_size);
+    fclose(state->file);
+    state->file = NULL;
+}
+
+MixerOutput* mixer_output_wav(const char* path) {
+    static WavOutput state;
+    static MixerOutput result;
+    memset(&state, 0, sizeof(state));
+    snprintf(state.path, sizeof(state.path), "%s", path);
+    result = (MixerOutput){ wav_open, wav_write, wav_close, 0, &state };
+    return &result;
+}
+
+typedef struct {
+    bool realtime;
+    uint64_t block_ns;
+    uint64_t deadline;
+} NullOutput;
+
+static bool null_open(MixerOutput* self, uint32_t sample_rate) {
+    NullOutput* state = self->state;
+    state->block_ns = (uint64_t)MIXER_BLOCK_FRAMES * 1000000000ull / sample_rate;
+    state->deadline = clock_now_ns();
+    return true;
+}
+
+static bool null_write(MixerOutput* self, const int16_t* frames, uint32_t frame_count) {
+    (void)frames;
+    (void)frame_count;
+    NullOutput* state = self->state;
+    if (!state->realtime) return true;
+
+    // Consume a block per block duration like a device would, sleeping while more than a millisecond ahead
+    state->deadline += state->block_ns;
+    for (uint64_t now = clock_now_ns(); now < state->deadline; now = clock_now_ns()) {
+        if (state->deadline - now > 1500000) thread_sleep_ms(1);
+    }
+    return true;
+}
+
+static void null_close(MixerOutput* self) {
+    (void)self;
+}
+
+MixerOutput* mixer_output_null(bool realtime) {
+    static NullOutput state;
+    static MixerOutput result;
+    state = (NullOutput){ realtime, 0, 0 };
+    result = (MixerOutput){ null_open, null_write, null_close, 0, &state };
+    return &result;
+}
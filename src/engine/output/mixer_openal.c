@@ -0,0 +1,80 @@
+#include <output/mixer.h>
+#include <jobs/thread.h>
+#include <AL/al.h>
+
+#include <string.h>
+
+// OpenAL output, kept apart from the mixer so tools and benchmarks that mix to a file or the null sink do not link
+// against OpenAL
+
+#define MIXER_MAX_OPENAL_BUFFERS 16
+
+typedef struct {
+    ALuint source;
+    ALuint buffers[MIXER_MAX_OPENAL_BUFFERS];
+    ALuint free_buffers[MIXER_MAX_OPENAL_BUFFERS];
+    uint32_t buffer_count, free_count;
+    uint32_t sample_rate;
+} OpenALOutput;
+
+static bool openal_open(MixerOutput* self, uint32_t sample_rate) {
+    OpenALOutput* state = self->state;
+    alGetError();
+    alGenSources(1, &state->source);
+    alGenBuffers((ALsizei)state->buffer_count, state->buffers);
+    if (alGetError() != AL_NO_ERROR) return false;
+
+    // Already spatialized by the mixer, the source just plays at the listener
+    alSourcei(state->source, AL_SOURCE_RELATIVE, AL_TRUE);
+    alSourcef(state->source, AL_ROLLOFF_FACTOR, 0.0f);
+    memcpy(state->free_buffers, state->buffers, sizeof(ALuint) * state->buffer_count);
+    state->free_count = state->buffer_count;
+    state->sample_rate = sample_rate;
+    return true;
+}
+
+static bool openal_write(MixerOutput* self, const int16_t* frames, uint32_t frame_count) {
+    OpenALOutput* state = self->state;
+
+    // Wait for the source to finish a buffer, a block is only a few milliseconds
+    while (state->free_count == 0) {
+        ALint processed = 0;
+        alGetSourcei(state->source, AL_BUFFERS_PROCESSED, &processed);
+        if (processed > 0) {
+            alSourceUnqueueBuffers(state->source, processed, state->free_buffers);
+            state->free_count = (uint32_t)processed;
+            break;
+        }
+        thread_sleep_ms(1);
+        if (mixer_stopping()) return true;
+    }
+
+    ALuint buffer = state->free_buffers[--state->free_count];
+    alBufferData(buffer, AL_FORMAT_STEREO16, frames, (ALsizei)(frame_count * 2 * sizeof(int16_t)), (ALsizei)state->sample_rate);
+    alSourceQueueBuffers(state->source, 1, &buffer);
+
+    // Start once the queue is primed, restart after an underrun
+    ALint source_state;
+    alGetSourcei(state->source, AL_SOURCE_STATE, &source_state);
+    if (source_state != AL_PLAYING && state->free_count == 0) alSourcePlay(state->source);
+    return alGetError() == AL_NO_ERROR;
+}
+
+static void openal_close(MixerOutput* self) {
+    OpenALOutput* state = self->state;
+    alSourceStop(state->source);
+    alSourcei(state->source, AL_BUFFER, 0);
+    alDeleteSources(1, &state->source);
+    alDeleteBuffers((ALsizei)state->buffer_count, state->buffers);
+}
+
+MixerOutput* mixer_output_openal(uint32_t buffer_count) {
+    static OpenALOutput state;
+    static MixerOutput result;
+    if (buffer_count < 2) buffer_count = 2;
+    if (buffer_count > MIXER_MAX_OPENAL_BUFFERS) buffer_count = MIXER_MAX_OPENAL_BUFFERS;
+    memset(&state, 0, sizeof(state));
+    state.buffer_count = buffer_count;
+    result = (MixerOutput){ openal_open, openal_write, openal_close, buffer_count * MIXER_BLOCK_FRAMES, &state };
+    return &result;
+}
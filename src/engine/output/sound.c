@@ -1,6 +1,8 @@
 #include <AL/al.h>
 #include <AL/alc.h>
 #include <output/sound.h>
+#include <output/voices.h>
+#include <output/stream.h>
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -31,42 +33,48 @@ bool sound_initialize() {
     }
 
     fprintf(stdout, "OpenAL initialized successfully. Device: %s\n", deviceName);
+
+    // Sources for the voice pool are created once, here
+    audio_reset();
+    voices_init();
     return true;
 }
 
 void sound_cleanup() {
+    sound_streams_cleanup();
+    voices_cleanup();
     alcMakeContextCurrent(NULL); // Detach current context
     if (context) alcDestroyContext(context);
     if (device) alcCloseDevice(device);
 }
 
 void sound_attach_buffer(Sound* sound) {
-	alSourcei(sound->source, AL_BUFFER, sound->buffer);
+	audio_source_set_buffer(&sound->cache, sound->source, sound->buffer);
 }
 
 void sound_play_once(Sound* sound) {
     if (sound->is_muted) return;
-    alSourcei(sound->source, AL_LOOPING, AL_FALSE); // Disable looping
+    audio_source_set_looping(&sound->cache, sound->source, false); // Disable looping
     alSourcePlay(sound->source);
     sound->is_playing = true;
 }
 
 void sound_play_repeat(Sound* sound) {
     if (sound->is_muted) return;
-    alSourcei(sound->source, AL_LOOPING, AL_TRUE); // Enable looping
+    audio_source_set_looping(&sound->cache, sound->source, true); // Enable looping
     alSourcePlay(sound->source);
     sound->is_playing = true;
 }
 
 void sound_mute(Sound* sound, bool mute) {
     sound->is_muted = mute;
-    alSourcef(sound->source, AL_GAIN, mute ? 0.0f : sound->volume);
+    audio_source_setf(&sound->cache, sound->source, AUDIO_GAIN, mute ? 0.0f : sound->volume);
 }
 
 void sound_set_volume(Sound* sound, float volume) {
     sound->volume = volume;
     if (!sound->is_muted) {
-        alSourcef(sound->source, AL_GAIN, volume);
+        audio_source_setf(&sound->cache, sound->source, AUDIO_GAIN, volume);
     }
 }
 
@@ -84,56 +92,27 @@ void sound_resume(Sound* sound) {
     }
 }
 
-void sound_play_once_rtwp(Sound* sound, float sound_pos[3], float listener_pos[3], float listener_dir[3], float listener_up[3]) {
-    // Update listener position
-    alListener3f(AL_POSITION, listener_pos[0], listener_pos[1], listener_pos[2]);
-
-    // Correct listener orientation: forward direction (listener_dir) and up direction (assumed Y axis: 0,1,0)
-    float listener_orientation[] = { 
-        listener_dir[0], listener_dir[1], listener_dir[2], // forward direction
-        listener_up[0], listener_up[1], listener_up[2]  // up direction (Y-axis)
-    };
-    alListenerfv(AL_ORIENTATION, listener_orientation); // Set listener orientation
-
-    // Set attenuation for the source (this controls how the sound fades with distance)
-    // AL_ROLLOFF_FACTOR: 1.0 means the sound will gradually fade with distance
-    alSourcef(sound->source, AL_ROLLOFF_FACTOR, 1.0f);  // Attenuate sound over distance
-    alSourcef(sound->source, AL_REFERENCE_DISTANCE, 5.0f);  // Sound at full volume within 5 units
-    alSourcef(sound->source, AL_MAX_DISTANCE, 50.0f);      // Maximum audible distance is 50 units
-
-    // Update sound source position (this moves the sound in 3D space)
-    alSourcefv(sound->source, AL_POSITION, sound_pos);
+// Attenuation and position, only values that changed since the last call are sent
+static void sound_place(Sound* sound, const float sound_pos[3]) {
+    audio_source_setf(&sound->cache, sound->source, AUDIO_ROLLOFF_FACTOR, 1.0f);     // Attenuate sound over distance
+    audio_source_setf(&sound->cache, sound->source, AUDIO_REFERENCE_DISTANCE, 5.0f); // Sound at full volume within 5 units
+    audio_source_setf(&sound->cache, sound->source, AUDIO_MAX_DISTANCE, 50.0f);      // Maximum audible distance is 50 units
+    audio_source_set_position(&sound->cache, sound->source, sound_pos);
+}
 
-    // Check if the sound is already playing
-    ALint state;
-    alGetSourcei(sound->source, AL_SOURCE_STATE, &state);
+void sound_play_once_rtwp(Sound* sound, const float sound_pos[3]) {
+    sound_place(sound, sound_pos);
 
-    // Play the sound only if it's not already playing
-    if (state != AL_PLAYING && !sound->played) {
+    // Played a single time, tracked here instead of asking the source for its state every call
+    if (!sound->played && !sound->is_playing) {
         sound_play_once(sound);
-		sound->played = true;
+        sound->played = true;
     }
 }
 
-void sound_play_repeat_rtwp(Sound* sound, float sound_pos[3], float listener_pos[3], float listener_dir[3], float listener_up[3]) {
-    // Update listener position
-    alListener3f(AL_POSITION, listener_pos[0], listener_pos[1], listener_pos[2]);
-
-    // Correct listener orientation: forward direction (listener_dir) and up direction (assumed Y axis: 0,1,0)
-    float listener_orientation[] = { 
-        listener_dir[0], listener_dir[1], listener_dir[2], // forward direction
-        listener_up[0], listener_up[1], listener_up[2]  // up direction (Y-axis)
-    };
-    alListenerfv(AL_ORIENTATION, listener_orientation); // Set listener orientation
-
-    // Set attenuation for the source
-    alSourcef(sound->source, AL_ROLLOFF_FACTOR, 1.0f);  // Attenuate sound over distance
-    alSourcef(sound->source, AL_REFERENCE_DISTANCE, 5.0f);  // Sound at full volume within 5 units
-    alSourcef(sound->source, AL_MAX_DISTANCE, 50.0f);      // Maximum audible distance is 50 units
-
-    // Set sound source position
-    alSourcefv(sound->source, AL_POSITION, sound_pos);
+void sound_play_repeat_rtwp(Sound* sound, const float sound_pos[3]) {
+    sound_place(sound, sound_pos);
 
-    // Play the sound on repeat (looping)
-    sound_play_repeat(sound); // This already handles looping
+    // Already looping: keep going instead of restarting from the beginning every call
+    if (!sound->is_playing) sound_play_repeat(sound);
 }
@@ -0,0 +1,320 @@
+#include <output/stream.h>
+#include <jobs/thread.h>
+#include <jobs/trace.h>
+#include <io/vfs.h>
+#include <wav.h>
+#include <AL/al.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+enum {
+    STREAM_OPENING,  // Waiting for the decoder to open the file
+    STREAM_DECODING,
+    STREAM_EOF,      // Every chunk of the file has been decoded
+    STREAM_FAILED
+};
+
+struct SoundStream {
+    char path[256];
+    bool looping;
+
+    // Main thread
+    ALuint source;
+    ALuint buffers[SOUND_STREAM_CHUNKS];
+    ALuint free_buffers[SOUND_STREAM_CHUNKS]; // Not queued on the source
+    int free_buffer_count;
+    int read_index;                           // Next chunk to queue
+    bool finished;
+
+    // Decoder thread, format fields are published by the first full chunk
+    VfsFile file;
+    WavInfo info;
+    ALenum format;
+    size_t position;                          // Frames into the samples
+    int write_index;                          // Next chunk to fill
+
+    _Atomic int state;
+    _Atomic bool chunk_full[SOUND_STREAM_CHUNKS];
+    size_t chunk_sizes[SOUND_STREAM_CHUNKS];
+    unsigned char* chunks[SOUND_STREAM_CHUNKS];
+    size_t chunk_capacity;
+
+    bool closing;                             // Freed by the decoder, guarded by stream_mutex
+    SoundStream* next;
+};
+
+// The list is guarded by stream_mutex, held only for list changes, never while decoding
+static SoundStream* streams = NULL;
+static Mutex stream_mutex;
+static CondVar stream_wake;
+static Thread decoder;
+static bool decoder_running = false;
+static bool sync_ready = false;
+
+static void stream_free(SoundStream* stream) {
+    if (stream->file.data) vfs_close(&stream->file);
+    for (int i = 0; i < SOUND_STREAM_CHUNKS; i++) free(stream->chunks[i]);
+    free(stream);
+}
+
+// Decoder side: parse the file and size the chunks to it
+static void stream_open_file(SoundStream* stream) {
+    TRACE_BEGIN_DETAIL("Stream open", stream->path);
+    bool ok = vfs_open(&stream->file, stream->path);
+    if (!ok) fprintf(stderr, "Failed to open audio stream: %s\n", stream->path);
+    else if (!wav_parse(stream->file.data, stream->file.size, &stream->info)) {
+        fprintf(stderr, "Invalid WAV file: %s\n", stream->path);
+        ok = false;
+    }
+
+    // Every encoding is converted to 16-bit, keeping mono or stereo
+    if (ok) {
+        const WavInfo* info = &stream->info;
+        ok = wav_supported(info) && info->num_channels <= 2;
+        if (!ok) fprintf(stderr, "Unsupported WAV format for streaming: %s\n", stream->path);
+        else stream->format = info->num_channels == 2 ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16;
+    }
+
+    if (ok) {
+        stream->chunk_capacity = (size_t)SOUND_STREAM_CHUNK_FRAMES * stream->info.num_channels * sizeof(int16_t);
+        for (int i = 0; i < SOUND_STREAM_CHUNKS && ok; i++) {
+            stream->chunks[i] = malloc(stream->chunk_capacity);
+            ok = stream->chunks[i] != NULL;
+        }
+    }
+
+    // An empty data chunk has nothing to decode, looping or not
+    int state = ok ? STREAM_DECODING : STREAM_FAILED;
+    if (ok && stream->info.samples_size == 0) state = STREAM_EOF;
+    atomic_store(&stream->state, state);
+    TRACE_END();
+}
+
+// Decoder side: decode the next free chunk, wrapping around for loops
+static void stream_fill_chunk(SoundStream* stream) {
+    int index = stream->write_index;
+    int16_t* chunk = (int16_t*)stream->chunks[index];
+    const WavInfo* info = &stream->info;
+    size_t total_frames = info->samples_size / info->block_align;
+    size_t filled = 0; // Frames
+
+    while (filled < SOUND_STREAM_CHUNK_FRAMES) {
+        size_t remaining = total_frames - stream->position;
+        if (remaining == 0) {
+            if (!stream->looping || total_frames == 0) break;
+            stream->position = 0;
+            continue;
+        }
+        size_t count = SOUND_STREAM_CHUNK_FRAMES - filled < remaining ? SOUND_STREAM_CHUNK_FRAMES - filled : remaining;
+        wav_convert_s16(info, info->samples + stream->position * info->block_align, count, chunk + filled * info->num_channels);
+        filled += count;
+        stream->position += count;
+    }
+
+    bool end = !stream->looping && stream->position == total_frames;
+    if (filled > 0) {
+        stream->chunk_sizes[index] = filled * info->num_channels * sizeof(int16_t);
+        stream->write_index = (index + 1) % SOUND_STREAM_CHUNKS;
+        atomic_store_explicit(&stream->chunk_full[index], true, memory_order_release);
+    }
+    if (end) atomic_store(&stream->state, STREAM_EOF);
+}
+
+static bool stream_needs_work(SoundStream* stream) {
+    int state = atomic_load(&stream->state);
+    if (state == STREAM_OPENING) return true;
+    return state == STREAM_DECODING && !atomic_load_explicit(&stream->chunk_full[stream->write_index], memory_order_acquire);
+}
+
+static void decoder_main(void* arg) {
+    (void)arg;
+    TRACE_THREAD_NAME("Audio decoder");
+
+    mutex_lock(&stream_mutex);
+    for (;;) {
+        // Closed streams are freed here, the decoder is the only thread that could be using them
+        SoundStream* work = NULL;
+        for (SoundStream** link = &streams; *link;) {
+            SoundStream* stream = *link;
+            if (stream->closing) {
+                *link = stream->next;
+                stream_free(stream);
+                continue;
+            }
+            if (!work && stream_needs_work(stream)) work = stream;
+            link = &stream->next;
+        }
+
+        if (!decoder_running) break;
+        if (!work) {
+            cond_wait(&stream_wake, &stream_mutex);
+            continue;
+        }
+
+        // Streams are only unlinked by this thread, so work stays valid without the lock
+        mutex_unlock(&stream_mutex);
+        if (atomic_load(&work->state) == STREAM_OPENING) stream_open_file(work);
+        else stream_fill_chunk(work);
+        mutex_lock(&stream_mutex);
+    }
+    mutex_unlock(&stream_mutex);
+}
+
+SoundStream* sound_stream_open(const char* path, bool looping, float volume) {
+    SoundStream* stream = calloc(1, sizeof(SoundStream));
+    if (!stream) return NULL;
+    snprintf(stream->path, sizeof(stream->path), "%s", path);
+    stream->looping = looping;
+    atomic_init(&stream->state, STREAM_OPENING);
+    for (int i = 0; i < SOUND_STREAM_CHUNKS; i++) atomic_init(&stream->chunk_full[i], false);
+
+    alGetError();
+    alGenSources(1, &stream->source);
+    alGenBuffers(SOUND_STREAM_CHUNKS, stream->buffers);
+    if (alGetError() != AL_NO_ERROR) {
+        fprintf(stderr, "Failed to create audio stream source: %s\n", path);
+        alDeleteSources(1, &stream->source);
+        alDeleteBuffers(SOUND_STREAM_CHUNKS, stream->buffers);
+        free(stream);
+        return NULL;
+    }
+
+    // Music plays at the listener
+    alSourcei(stream->source, AL_SOURCE_RELATIVE, AL_TRUE);
+    alSource3f(stream->source, AL_POSITION, 0.0f, 0.0f, 0.0f);
+    alSourcef(stream->source, AL_ROLLOFF_FACTOR, 0.0f);
+    alSourcef(stream->source, AL_GAIN, volume);
+    for (int i = 0; i < SOUND_STREAM_CHUNKS; i++) stream->free_buffers[i] = stream->buffers[i];
+    stream->free_buffer_count = SOUND_STREAM_CHUNKS;
+
+    if (!sync_ready) {
+        mutex_init(&stream_mutex);
+        cond_init(&stream_wake);
+        sync_ready = true;
+    }
+
+    mutex_lock(&stream_mutex);
+    if (!decoder_running) {
+        decoder_running = true;
+        if (!thread_create(&decoder, decoder_main, NULL)) {
+            fprintf(stderr, "Failed to start the audio decoder thread\n");
+            decoder_running = false;
+        }
+    }
+    // Nothing will ever decode it, it shows up as finished like a file that failed to open
+    if (!decoder_running) atomic_store(&stream->state, STREAM_FAILED);
+    stream->next = streams;
+    streams = stream;
+    cond_signal(&stream_wake);
+    mutex_unlock(&stream_mutex);
+    return stream;
+}
+
+void sound_stream_close(SoundStream* stream) {
+    if (!stream) return;
+    alSourceStop(stream->source);
+    alSourcei(stream->source, AL_BUFFER, 0);
+    alDeleteSources(1, &stream->source);
+    alDeleteBuffers(SOUND_STREAM_CHUNKS, stream->buffers);
+
+    mutex_lock(&stream_mutex);
+    stream->closing = true;
+    if (!decoder_running) {
+        // No decoder to free it, and none can be using it
+        SoundStream** link = &streams;
+        while (*link != stream) link = &(*link)->next;
+        *link = stream->next;
+        stream_free(stream);
+    }
+    cond_signal(&stream_wake);
+    mutex_unlock(&stream_mutex);
+}
+
+void sound_stream_set_volume(SoundStream* stream, float volume) {
+    alSourcef(stream->source, AL_GAIN, volume);
+}
+
+bool sound_stream_finished(const SoundStream* stream) {
+    return stream->finished;
+}
+
+static bool stream_update(SoundStream* stream) {
+    int state = atomic_load(&stream->state);
+    if (state == STREAM_FAILED) {
+        stream->finished = true;
+        return false;
+    }
+    if (stream->finished || state == STREAM_OPENING) return false;
+
+    // Buffers the source is done with come back for refilling
+    ALint processed = 0;
+    alGetSourcei(stream->source, AL_BUFFERS_PROCESSED, &processed);
+    if (processed > 0) {
+        alSourceUnqueueBuffers(stream->source, processed, stream->free_buffers + stream->free_buffer_count);
+        stream->free_buffer_count += processed;
+    }
+
+    // alBufferData copies, so a chunk is free for the decoder again as soon as it is queued
+    bool consumed = false;
+    while (stream->free_buffer_count > 0 && atomic_load_explicit(&stream->chunk_full[stream->read_index], memory_order_acquire)) {
+        ALuint buffer = stream->free_buffers[--stream->free_buffer_count];
+        int index = stream->read_index;
+        alBufferData(buffer, stream->format, stream->chunks[index], (ALsizei)stream->chunk_sizes[index], (ALsizei)stream->info.sample_rate);
+        alSourceQueueBuffers(stream->source, 1, &buffer);
+        atomic_store_explicit(&stream->chunk_full[index], false, memory_order_release);
+        stream->read_index = (index + 1) % SOUND_STREAM_CHUNKS;
+        consumed = true;
+    }
+
+    // Start, or restart after running dry (the decoder fell behind or the game stalled)
+    ALint source_state, queued = 0;
+    alGetSourcei(stream->source, AL_SOURCE_STATE, &source_state);
+    alGetSourcei(stream->source, AL_BUFFERS_QUEUED, &queued);
+    if (source_state != AL_PLAYING && source_state != AL_PAUSED && queued > 0) {
+        alSourcePlay(stream->source);
+    } else if (queued == 0 && state == STREAM_EOF && !atomic_load(&stream->chunk_full[stream->read_index])) {
+        stream->finished = true;
+    }
+    return consumed;
+}
+
+void sound_streams_update() {
+    if (!sync_ready) return;
+
+    bool wake = false;
+    mutex_lock(&stream_mutex);
+    for (SoundStream* stream = streams; stream; stream = stream->next) {
+        if (!stream->closing && stream_update(stream)) wake = true;
+    }
+    if (wake) cond_signal(&stream_wake);
+    mutex_unlock(&stream_mutex);
+}
+
+void sound_streams_cleanup() {
+    if (!sync_ready) return;
+
+    mutex_lock(&stream_mutex);
+    for (SoundStream* stream = streams; stream; stream = stream->next) {
+        if (stream->closing) continue;
+        alSourceStop(stream->source);
+        alSourcei(stream->source, AL_BUFFER, 0);
+        alDeleteSources(1, &stream->source);
+        alDeleteBuffers(SOUND_STREAM_CHUNKS, stream->buffers);
+        stream->closing = true;
+    }
+    bool join = decoder_running;
+    decoder_running = false;
+    cond_signal(&stream_wake);
+    mutex_unlock(&stream_mutex);
+
+    // The decoder frees the closed streams on its way out, without one they are freed here
+    if (join) thread_join(decoder);
+    while (streams) {
+        SoundStream* next = streams->next;
+        stream_free(streams);
+        streams = next;
+    }
+}
@@ -0,0 +1,287 @@
+#include <output/voices.h>
+#include <output/audio.h>
+#include <jobs/thread.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define VOICE_INDEX_BITS 8 // SOUND_MAX_VOICES must fit, the rest of a handle is the generation
+
+typedef struct {
+    char name[64];
+    ALuint buffer;
+    float duration;         // Seconds at pitch 1
+} Clip;
+
+typedef struct {
+    bool active;
+    uint32_t generation;    // Bumped on release, so handles of earlier plays stop matching
+    SoundClip clip;
+    int source;             // Index in sources, -1 while virtual
+    SoundParams params;
+    uint64_t start_ns;      // Playback position is derived from this when a virtual voice becomes real
+    uint64_t end_ns;        // UINT64_MAX for loops
+} Voice;
+
+static Clip clips[SOUND_MAX_CLIPS];
+static int clip_count = 0;
+
+static ALuint sources[SOUND_MAX_SOURCES];
+static AudioSourceCache source_cache[SOUND_MAX_SOURCES]; // Parameters last sent to each source
+static int source_owner[SOUND_MAX_SOURCES]; // Voice index, -1 when free
+static int free_sources[SOUND_MAX_SOURCES]; // Stack of free source indices
+static int source_count = 0, free_source_count = 0;
+
+static Voice voices[SOUND_MAX_VOICES];
+static int free_voices[SOUND_MAX_VOICES];
+static int free_voice_count = 0;
+
+static int bytes_per_frame(ALenum format) {
+    switch (format) {
+        case AL_FORMAT_MONO8: return 1;
+        case AL_FORMAT_MONO16: return 2;
+        case AL_FORMAT_STEREO8: return 2;
+        case AL_FORMAT_STEREO16: return 4;
+        default: return 0;
+    }
+}
+
+bool voices_init() {
+    // Devices cap the number of sources, take what we get
+    source_count = 0;
+    while (source_count < SOUND_MAX_SOURCES) {
+        alGetError();
+        alGenSources(1, &sources[source_count]);
+        if (alGetError() != AL_NO_ERROR) break;
+        source_count++;
+    }
+
+    free_source_count = 0;
+    for (int i = source_count - 1; i >= 0; i--) {
+        source_owner[i] = -1;
+        source_cache[i] = (AudioSourceCache){ 0 };
+        free_sources[free_source_count++] = i;
+    }
+
+    free_voice_count = 0;
+    for (int i = SOUND_MAX_VOICES - 1; i >= 0; i--) {
+        voices[i] = (Voice){ 0 };
+        voices[i].generation = 1;
+        free_voices[free_voice_count++] = i;
+    }
+
+    // Linear falloff reaches silence at the max distance, where voices turn virtual without a jump in volume
+    alDistanceModel(AL_LINEAR_DISTANCE_CLAMPED);
+
+    printf("[SOUND] Voice pool: %d sources, %d voices\n", source_count, SOUND_MAX_VOICES);
+    return source_count > 0;
+}
+
+void voices_cleanup() {
+    for (int i = 0; i < source_count; i++) alSourceStop(sources[i]);
+    if (source_count) alDeleteSources(source_count, sources);
+    for (int i = 0; i < clip_count; i++) alDeleteBuffers(1, &clips[i].buffer);
+    source_count = free_source_count = free_voice_count = clip_count = 0;
+}
+
+SoundClip sound_bank_find(const char* name) {
+    for (int i = 0; i < clip_count; i++) {
+        if (strcmp(clips[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+SoundClip sound_bank_add(const char* name, ALenum format, const void* data, ALsizei size, ALsizei frequency) {
+    SoundClip existing = sound_bank_find(name);
+    if (existing >= 0) return existing;
+
+    if (clip_count == SOUND_MAX_CLIPS) {
+        fprintf(stderr, "[SOUND] Sound bank full, cannot add %s\n", name);
+        return -1;
+    }
+    int frame_size = bytes_per_frame(format);
+    if (frame_size == 0 || frequency <= 0) {
+        fprintf(stderr, "[SOUND] Unsupported sample format for %s\n", name);
+        return -1;
+    }
+
+    Clip* clip = &clips[clip_count];
+    alGetError();
+    alGenBuffers(1, &clip->buffer);
+    alBufferData(clip->buffer, format, data, size, frequency);
+    if (alGetError() != AL_NO_ERROR) {
+        fprintf(stderr, "[SOUND] Failed to upload %s\n", name);
+        alDeleteBuffers(1, &clip->buffer);
+        return -1;
+    }
+
+    snprintf(clip->name, sizeof(clip->name), "%s", name);
+    clip->duration = (float)size / (float)(frame_size * frequency);
+    return clip_count++;
+}
+
+static Voice* voice_lookup(SoundVoice handle) {
+    uint32_t index = handle & ((1u << VOICE_INDEX_BITS) - 1);
+    if (handle == 0 || index >= SOUND_MAX_VOICES) return NULL;
+    Voice* voice = &voices[index];
+    return voice->active && voice->generation == handle >> VOICE_INDEX_BITS ? voice : NULL;
+}
+
+// Volume after distance falloff, 0 when out of range
+static float voice_audibility(const Voice* voice) {
+    if (!voice->params.positional) return voice->params.volume;
+
+    const float* listener = audio_listener_position();
+    float dx = voice->params.position[0] - listener[0];
+    float dy = voice->params.position[1] - listener[1];
+    float dz = voice->params.position[2] - listener[2];
+    float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+    float max_distance = voice->params.max_distance;
+    if (distance <= SOUND_REFERENCE_DISTANCE) return voice->params.volume;
+    if (distance >= max_distance) return 0.0f;
+    return voice->params.volume * (1.0f - (distance - SOUND_REFERENCE_DISTANCE) / (max_distance - SOUND_REFERENCE_DISTANCE));
+}
+
+// Whether a is a better voice to give up than b: finished first, then lower priority, quieter, older
+static bool voice_steal_before(const Voice* a, const Voice* b, uint64_t now) {
+    bool a_done = a->end_ns <= now, b_done = b->end_ns <= now;
+    if (a_done != b_done) return a_done;
+    if (a->params.priority != b->params.priority) return a->params.priority < b->params.priority;
+    float a_gain = voice_audibility(a), b_gain = voice_audibility(b);
+    if (a_gain != b_gain) return a_gain < b_gain;
+    return a->start_ns < b->start_ns;
+}
+
+static void voice_unbind(Voice* voice) {
+    if (voice->source < 0) return;
+    alSourceStop(sources[voice->source]);
+    source_owner[voice->source] = -1;
+    free_sources[free_source_count++] = voice->source;
+    voice->source = -1;
+}
+
+static void voice_release(Voice* voice) {
+    voice_unbind(voice);
+    voice->active = false;
+    voice->generation++;
+    if (voice->generation >> (32 - VOICE_INDEX_BITS)) voice->generation = 1;
+    free_voices[free_voice_count++] = (int)(voice - voices);
+}
+
+// Start a voice on a free source at the position its clock says it should be at
+static void voice_bind(Voice* voice, uint64_t now) {
+    int source_index = free_sources[--free_source_count];
+    ALuint source = sources[source_index];
+    source_owner[source_index] = (int)(voice - voices);
+    voice->source = source_index;
+
+    const SoundParams* params = &voice->params;
+    const Clip* clip = &clips[voice->clip];
+    float offset = (float)((double)(now - voice->start_ns) / 1e9) * params->pitch;
+    if (params->looping && clip->duration > 0.0f) offset = fmodf(offset, clip->duration);
+
+    // Only what differs from the source's previous voice is sent
+    static const float origin[3] = { 0.0f, 0.0f, 0.0f };
+    AudioSourceCache* cache = &source_cache[source_index];
+    audio_source_set_buffer(cache, source, clip->buffer);
+    audio_source_set_looping(cache, source, params->looping);
+    audio_source_setf(cache, source, AUDIO_GAIN, params->volume);
+    audio_source_setf(cache, source, AUDIO_PITCH, params->pitch);
+    audio_source_set_relative(cache, source, !params->positional);
+    audio_source_set_position(cache, source, params->positional ? params->position : origin);
+    audio_source_setf(cache, source, AUDIO_REFERENCE_DISTANCE, SOUND_REFERENCE_DISTANCE);
+    audio_source_setf(cache, source, AUDIO_MAX_DISTANCE, params->max_distance);
+    audio_source_setf(cache, source, AUDIO_ROLLOFF_FACTOR, 1.0f);
+    if (offset > 0.0f) alSourcef(source, AL_SEC_OFFSET, offset);
+    alSourcePlay(source);
+}
+
+SoundVoice sound_trigger(SoundClip clip, const SoundParams* params) {
+    if (clip < 0 || clip >= clip_count || source_count == 0) return 0;
+
+    uint64_t now = clock_now_ns();
+    Voice candidate = { 0 };
+    candidate.clip = clip;
+    candidate.source = -1;
+    candidate.params = *params;
+    if (candidate.params.pitch <= 0.0f) candidate.params.pitch = 1.0f;
+    if (candidate.params.max_distance <= SOUND_REFERENCE_DISTANCE) candidate.params.max_distance = SOUND_DEFAULT_MAX_DISTANCE;
+    candidate.start_ns = now;
+    candidate.end_ns = candidate.params.looping ? UINT64_MAX : now + (uint64_t)(clips[clip].duration / candidate.params.pitch * 1e9);
+
+    // Every voice taken: replace the one most worth dropping, unless the new one ranks below it
+    if (free_voice_count == 0) {
+        Voice* victim = &voices[0];
+        for (int i = 1; i < SOUND_MAX_VOICES; i++) {
+            if (voice_steal_before(&voices[i], victim, now)) victim = &voices[i];
+        }
+        if (victim->end_ns > now && victim->params.priority > candidate.params.priority) return 0;
+        voice_release(victim);
+    }
+
+    Voice* voice = &voices[free_voices[--free_voice_count]];
+    candidate.generation = voice->generation;
+    candidate.active = true;
+    *voice = candidate;
+    SoundVoice handle = voice->generation << VOICE_INDEX_BITS | (uint32_t)(voice - voices);
+
+    // Out of range voices start virtual
+    if (voice_audibility(voice) <= 0.0f) return handle;
+
+    // No free source: take one from a real voice ranking at or below this one, that voice carries on virtually
+    if (free_source_count == 0) {
+        Voice* victim = NULL;
+        for (int i = 0; i < source_count; i++) {
+            Voice* owner = &voices[source_owner[i]];
+            if (!victim || voice_steal_before(owner, victim, now)) victim = owner;
+        }
+        if (victim->end_ns > now && victim->params.priority > voice->params.priority) return handle;
+        if (victim->end_ns <= now) voice_release(victim);
+        else voice_unbind(victim);
+    }
+
+    voice_bind(voice, now);
+    return handle;
+}
+
+void sound_voice_stop(SoundVoice handle) {
+    Voice* voice = voice_lookup(handle);
+    if (voice) voice_release(voice);
+}
+
+void sound_voice_set_position(SoundVoice handle, const float position[3]) {
+    Voice* voice = voice_lookup(handle);
+    if (!voice) return;
+    memcpy(voice->params.position, position, sizeof(voice->params.position)); // Sent by the next update
+}
+
+bool sound_voice_active(SoundVoice handle) {
+    return voice_lookup(handle) != NULL;
+}
+
+void sound_voices_update() {
+    // Reclaim finished voices, drop sources of voices that went out of range and send moved positions.
+    // Only voices whose clock says they are done ask the source for its state, loops never do.
+    uint64_t now = clock_now_ns();
+    for (int i = 0; i < SOUND_MAX_VOICES; i++) {
+        Voice* voice = &voices[i];
+        if (!voice->active) continue;
+
+        if (voice->source >= 0) {
+            ALint state = AL_PLAYING;
+            if (voice->end_ns <= now) alGetSourcei(sources[voice->source], AL_SOURCE_STATE, &state);
+            if (state == AL_STOPPED) voice_release(voice);
+            else if (voice_audibility(voice) <= 0.0f) voice_unbind(voice);
+            else if (voice->params.positional) audio_source_set_position(&source_cache[voice->source], sources[voice->source], voice->params.position);
+        } else if (voice->end_ns <= now) {
+            voice_release(voice);
+        }
+    }
+
+    // Virtual voices back in range take any source left free
+    for (int i = 0; i < SOUND_MAX_VOICES && free_source_count > 0; i++) {
+        Voice* voice = &voices[i];
+        if (voice->active && voice->source < 0 && voice_audibility(voice) > 0.0f) voice_bind(voice, now);
+    }
+}
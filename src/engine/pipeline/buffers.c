@@ -30,6 +30,15 @@ GLuint buffers_create_ebo(const unsigned int* indices, size_t index_count) {
     return EBO;
 }
 
+// Creates and returns an immutable buffer; the data is copied by the driver, nothing has to be converted first
+GLuint buffers_create_storage(GLenum target, const void* data, size_t size) {
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(target, buffer);
+    glBufferStorage(target, (GLsizeiptr)size, data, 0);
+    return buffer;
+}
+
 // Initializes an empty VAO, VBO, and optionally an EBO for your own data
 Buffers buffers_create_empty() {
     Buffers buffers = {0};
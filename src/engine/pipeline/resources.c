@@ -0,0 +1,274 @@
+#include <pipeline/resources.h>
+#include <pipeline/texture_registry.h>
+#include <qreader.h>
+#include <hash.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    char **keys;             // "vertex\nfragment" canonical path pairs resolving to this program
+    uint32_t key_count;
+    uint64_t source_hash;    // 0 when unknown
+    ShaderProgram program;
+    uint32_t refs;
+} ProgramEntry;
+
+typedef struct {
+    char *path;              // Canonical
+    float size, spacing;
+    GLuint shader_program;
+    Font *font;
+    uint32_t refs;
+} FontEntry;
+
+static ProgramEntry *programs = NULL;
+static uint32_t program_count = 0, program_capacity = 0;
+
+static FontEntry *fonts = NULL;
+static uint32_t font_count = 0, font_capacity = 0;
+
+static Font blank_font; // Handed out when a font entry cannot be allocated
+
+// ----------------------------------------------------------------------------
+// Programs
+// ----------------------------------------------------------------------------
+
+uint64_t resources_source_hash(const char *vertex_source, const char *fragment_source) {
+    uint64_t hash = hash_bytes(vertex_source, strlen(vertex_source));
+    hash ^= hash_bytes(fragment_source, strlen(fragment_source)) * 0x9e3779b97f4a7c15ull;
+    return hash ? hash : 1;
+}
+
+static bool program_key(const char *vertex_path, const char *fragment_path, char *dest, size_t dest_size) {
+    // Paths that do not resolve on disk (packed files) still get their normalized form
+    char vertex[TEXTURE_PATH_MAX], fragment[TEXTURE_PATH_MAX];
+    texture_path_canonical(vertex_path, vertex, sizeof(vertex));
+    texture_path_canonical(fragment_path, fragment, sizeof(fragment));
+    return snprintf(dest, dest_size, "%s\n%s", vertex, fragment) < (int)dest_size;
+}
+
+static ProgramEntry *program_by_key(const char *key) {
+    for (uint32_t i = 0; i < program_count; i++) {
+        for (uint32_t k = 0; k < programs[i].key_count; k++) {
+            if (strcmp(programs[i].keys[k], key) == 0) return &programs[i];
+        }
+    }
+    return NULL;
+}
+
+static ProgramEntry *program_by_hash(uint64_t source_hash) {
+    if (!source_hash) return NULL;
+    for (uint32_t i = 0; i < program_count; i++) {
+        if (programs[i].source_hash == source_hash) return &programs[i];
+    }
+    return NULL;
+}
+
+static ProgramEntry *program_by_id(GLuint id) {
+    for (uint32_t i = 0; i < program_count; i++) {
+        if (programs[i].program.id == id) return &programs[i];
+    }
+    return NULL;
+}
+
+static void program_add_key(ProgramEntry *entry, const char *key) {
+    char **keys = realloc(entry->keys, (entry->key_count + 1) * sizeof(char *));
+    if (!keys) return; // Still shared, only found through the source hash
+    entry->keys = keys;
+    entry->keys[entry->key_count] = strdup(key);
+    if (entry->keys[entry->key_count]) entry->key_count++;
+}
+
+ShaderProgram resources_program_find(const char *vertex_path, const char *fragment_path, uint64_t source_hash) {
+    char key[TEXTURE_PATH_MAX * 2 + 2];
+    bool has_key = program_key(vertex_path, fragment_path, key, sizeof(key));
+
+    ProgramEntry *entry = has_key ? program_by_key(key) : NULL;
+    if (!entry) {
+        entry = program_by_hash(source_hash);
+        if (!entry) return (ShaderProgram){ 0 };
+        if (has_key) program_add_key(entry, key);
+    }
+    entry->refs++;
+    return entry->program;
+}
+
+ShaderProgram resources_program_add(const char *vertex_path, const char *fragment_path, uint64_t source_hash, ShaderProgram program) {
+    if (!program.id) return program;
+
+    ShaderProgram existing = resources_program_find(vertex_path, fragment_path, source_hash);
+    if (existing.id) {
+        if (existing.id != program.id) shader_destroy(&program);
+        return existing;
+    }
+
+    if (program_count == program_capacity) {
+        uint32_t capacity = program_capacity ? program_capacity * 2 : 16;
+        ProgramEntry *grown = realloc(programs, capacity * sizeof(ProgramEntry));
+        if (!grown) return program; // Works, just not shared
+        programs = grown;
+        program_capacity = capacity;
+    }
+
+    ProgramEntry *entry = &programs[program_count++];
+    *entry = (ProgramEntry){ NULL, 0, source_hash, program, 1 };
+    char key[TEXTURE_PATH_MAX * 2 + 2];
+    if (program_key(vertex_path, fragment_path, key, sizeof(key))) program_add_key(entry, key);
+    return program;
+}
+
+ShaderProgram resources_program_acquire(const char *vertex_path, const char *fragment_path) {
+    ProgramBuild build;
+    resources_program_begin(&build, vertex_path, fragment_path);
+    return resources_program_finish(&build);
+}
+
+bool resources_program_begin(ProgramBuild *build, const char *vertex_path, const char *fragment_path) {
+    memset(build, 0, sizeof(ProgramBuild));
+    build->vertex_path = vertex_path;
+    build->fragment_path = fragment_path;
+    build->shared = resources_program_find(vertex_path, fragment_path, 0);
+    if (build->shared.id) return true;
+
+    char *vertex_source = read_file(vertex_path);
+    char *fragment_source = read_file(fragment_path);
+    if (!vertex_source || !fragment_source) {
+        fprintf(stderr, "Failed to load shader sources: %s, %s\n", vertex_path, fragment_path);
+        free(vertex_source);
+        free(fragment_source);
+        return false;
+    }
+
+    // The same sources may already be registered under other paths
+    build->source_hash = resources_source_hash(vertex_source, fragment_source);
+    build->shared = resources_program_find(vertex_path, fragment_path, build->source_hash);
+    if (!build->shared.id) shader_build_begin(&build->build, vertex_source, fragment_source);
+    free(vertex_source);
+    free(fragment_source);
+    return true;
+}
+
+ShaderProgram resources_program_finish(ProgramBuild *build) {
+    if (build->shared.id || !build->build.program) return build->shared;
+
+    // Another build of the same program may have been registered in between, add hands that one out instead
+    ShaderProgram program = shader_build_finish(&build->build);
+    return resources_program_add(build->vertex_path, build->fragment_path, build->source_hash, program);
+}
+
+void resources_program_cancel(ProgramBuild *build) {
+    resources_program_release(&build->shared);
+    shader_build_cancel(&build->build);
+}
+
+void resources_program_release(ShaderProgram *program) {
+    if (!program->id) return;
+
+    ProgramEntry *entry = program_by_id(program->id);
+    if (!entry) {
+        shader_destroy(program);
+        program->id = 0;
+        return;
+    }
+    program->id = 0;
+    if (--entry->refs > 0) return;
+
+    shader_destroy(&entry->program);
+    for (uint32_t k = 0; k < entry->key_count; k++) free(entry->keys[k]);
+    free(entry->keys);
+    *entry = programs[--program_count];
+}
+
+// ----------------------------------------------------------------------------
+// Fonts
+// ----------------------------------------------------------------------------
+
+Font *resources_font_acquire(const char *path, float size, float spacing, GLuint shader_program) {
+    char canonical[TEXTURE_PATH_MAX];
+    texture_path_canonical(path, canonical, sizeof(canonical));
+
+    for (uint32_t i = 0; i < font_count; i++) {
+        FontEntry *entry = &fonts[i];
+        if (entry->size == size && entry->spacing == spacing && entry->shader_program == shader_program &&
+            strcmp(entry->path, canonical) == 0) {
+            entry->refs++;
+            return entry->font;
+        }
+    }
+
+    if (font_count == font_capacity) {
+        uint32_t capacity = font_capacity ? font_capacity * 2 : 8;
+        FontEntry *grown = realloc(fonts, capacity * sizeof(FontEntry));
+        if (!grown) return &blank_font;
+        fonts = grown;
+        font_capacity = capacity;
+    }
+
+    Font *font = malloc(sizeof(Font));
+    char *interned = strdup(canonical);
+    if (!font || !interned) {
+        free(font);
+        free(interned);
+        return &blank_font;
+    }
+
+    // A font that fails to load stays registered as a blank one, it is not retried by every user
+    font_init(font, path, size, spacing, shader_program);
+    fonts[font_count++] = (FontEntry){ interned, size, spacing, shader_program, font, 1 };
+    return font;
+}
+
+void resources_font_release(Font *font) {
+    if (!font || font == &blank_font) return;
+
+    for (uint32_t i = 0; i < font_count; i++) {
+        FontEntry *entry = &fonts[i];
+        if (entry->font != font) continue;
+        if (--entry->refs > 0) return;
+
+        font_cleanup(entry->font);
+        free(entry->font);
+        free(entry->path);
+        *entry = fonts[--font_count];
+        return;
+    }
+    fprintf(stderr, "[RESOURCES] Released a font that is not registered.\n");
+}
+
+// ----------------------------------------------------------------------------
+// Reporting and shutdown
+// ----------------------------------------------------------------------------
+
+void resources_report() {
+    printf("[RESOURCES] %u programs, %u fonts\n", program_count, font_count);
+    for (uint32_t i = 0; i < program_count; i++) {
+        printf("  program #%u refs=%u paths=%u\n", programs[i].program.id, programs[i].refs, programs[i].key_count);
+    }
+    for (uint32_t i = 0; i < font_count; i++) {
+        printf("  font %.0fpx refs=%u %s\n", fonts[i].size, fonts[i].refs, fonts[i].path);
+    }
+}
+
+void resources_shutdown() {
+    for (uint32_t i = 0; i < program_count; i++) {
+        ProgramEntry *entry = &programs[i];
+        printf("[RESOURCES] Program %u still has %u references at shutdown.\n", entry->program.id, entry->refs);
+        shader_destroy(&entry->program);
+        for (uint32_t k = 0; k < entry->key_count; k++) free(entry->keys[k]);
+        free(entry->keys);
+    }
+    for (uint32_t i = 0; i < font_count; i++) {
+        FontEntry *entry = &fonts[i];
+        printf("[RESOURCES] Font %s still has %u references at shutdown.\n", entry->path, entry->refs);
+        font_cleanup(entry->font);
+        free(entry->font);
+        free(entry->path);
+    }
+    free(programs);
+    free(fonts);
+    programs = NULL;
+    fonts = NULL;
+    program_count = program_capacity = font_count = font_capacity = 0;
+}
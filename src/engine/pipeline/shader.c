@@ -1,64 +1,261 @@
 #include <pipeline/shader.h>
+#include <hash.h>
+#include <io/mapped_file.h>
+#include <io/cache.h>
+#include <jobs/trace.h>
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define SHADER_CACHE_MAGIC 0x4348534Cu // "LSHC"
+#define SHADER_CACHE_VERSION 1
+
+// GL_KHR_parallel_shader_compile / GL_ARB_parallel_shader_compile (same values), not part of the glad profile
+#define GL_COMPLETION_STATUS 0x91B1
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSPROC)(GLuint count);
+
+// Cache file: this header, then the glGetProgramBinary blob
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;       // Sources + driver identity, also the file name
+    uint64_t checksum;  // Hash of the blob, catches truncated or damaged files
+    uint32_t format;    // Binary format reported by the driver
+    uint32_t size;
+} ShaderCacheHeader;
+
+static bool parallel_compile = false; // Completion can be polled without blocking
+static int cache_state = 0;       // 0 not checked yet, 1 enabled, -1 unsupported
+static uint64_t driver_hash = 0;  // Vendor, renderer and version strings
+
+// The cache needs GL 4.1 program binaries and a driver exposing at least one format
+static bool shader_cache_enabled() {
+    if (cache_state != 0) return cache_state > 0;
+    cache_state = -1;
+
+    GLint formats = 0;
+    if (GLAD_GL_VERSION_4_1) glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0) {
+        printf("[SHADER] Program binaries unsupported, compiling from source\n");
+        return false;
+    }
+
+    // A driver update changes the version string and invalidates every entry
+    const char* identity[3] = {
+        (const char*)glGetString(GL_VENDOR),
+        (const char*)glGetString(GL_RENDERER),
+        (const char*)glGetString(GL_VERSION)
+    };
+    uint64_t hashes[3];
+    for (int i = 0; i < 3; i++) {
+        hashes[i] = identity[i] ? hash_bytes(identity[i], strlen(identity[i])) : 0;
+    }
+    driver_hash = hash_bytes(hashes, sizeof(hashes));
+    cache_state = 1;
+    return true;
+}
+
+static uint64_t shader_cache_key(const char* vertexSrc, const char* fragmentSrc) {
+    uint64_t hashes[3] = {
+        driver_hash,
+        hash_bytes(vertexSrc, strlen(vertexSrc)),
+        hash_bytes(fragmentSrc, strlen(fragmentSrc))
+    };
+    return hash_bytes(hashes, sizeof(hashes));
+}
+
+// Returns the linked program, or 0 when there is no usable entry (a bad one is deleted so it gets rewritten)
+static GLuint shader_cache_load(uint64_t key) {
+    char path[256];
+    cache_entry_path("shaders", key, ".bin", path, sizeof(path));
+
+    MappedFile file;
+    if (!mapped_file_open(&file, path)) return 0;
+
+    const ShaderCacheHeader* header = (const ShaderCacheHeader*)file.data;
+    bool valid = file.size >= sizeof(ShaderCacheHeader) &&
+                 header->magic == SHADER_CACHE_MAGIC &&
+                 header->version == SHADER_CACHE_VERSION &&
+                 header->key == key &&
+                 header->size == file.size - sizeof(ShaderCacheHeader) &&
+                 header->checksum == hash_bytes(file.data + sizeof(ShaderCacheHeader), header->size);
+
+    GLuint program = 0;
+    if (valid) {
+        program = glCreateProgram();
+        glProgramBinary(program, header->format, file.data + sizeof(ShaderCacheHeader), (GLsizei)header->size);
+
+        // Drivers reject binaries from other builds by failing the link status
+        GLint success;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success) {
+            glDeleteProgram(program);
+            program = 0;
+            valid = false;
+        }
+    }
+    mapped_file_close(&file);
+
+    if (!valid) {
+        fprintf(stderr, "[SHADER] Discarding stale or corrupt cached program %s\n", path);
+        remove(path);
+    }
+    return program;
+}
+
+static void shader_cache_store(uint64_t key, GLuint program) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    void* blob = malloc((size_t)length);
+    if (!blob) return;
+
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, blob);
+    if (written <= 0) {
+        free(blob);
+        return;
+    }
+
+    ShaderCacheHeader header = {
+        SHADER_CACHE_MAGIC, SHADER_CACHE_VERSION, key,
+        hash_bytes(blob, (size_t)written), format, (uint32_t)written
+    };
+
+    char path[256];
+    cache_entry_path("shaders", key, ".bin", path, sizeof(path));
+    cache_write(path, &header, sizeof(header), blob, (size_t)written);
+    free(blob);
+}
 
-// Helper function to compile a shader and check for errors
-static GLuint compile_shader(const char* source, GLenum shaderType) {
+static bool has_extension(const char* extension) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++) {
+        const char* name = (const char*)glGetStringi(GL_EXTENSIONS, i);
+        if (name && strcmp(name, extension) == 0) return true;
+    }
+    return false;
+}
+
+void shader_init(GLADloadproc load) {
+    const char* threads_function = NULL;
+    if (has_extension("GL_KHR_parallel_shader_compile")) threads_function = "glMaxShaderCompilerThreadsKHR";
+    else if (has_extension("GL_ARB_parallel_shader_compile")) threads_function = "glMaxShaderCompilerThreadsARB";
+    parallel_compile = threads_function != NULL;
+    if (!parallel_compile) return;
+
+    // 0xFFFFFFFF lets the driver pick its own thread count
+    PFNGLMAXSHADERCOMPILERTHREADSPROC max_threads = (PFNGLMAXSHADERCOMPILERTHREADSPROC)load(threads_function);
+    if (max_threads) max_threads(0xFFFFFFFFu);
+    printf("[SHADER] Parallel shader compilation enabled\n");
+}
+
+static GLuint issue_shader(const char* source, GLenum shaderType) {
     GLuint shader = glCreateShader(shaderType);
     glShaderSource(shader, 1, &source, NULL);
     glCompileShader(shader);
+    return shader;
+}
 
-    // Check for compilation errors
+// Check a compile issued by issue_shader, this waits for the driver
+static bool check_shader(GLuint shader, const char* stage) {
     GLint success;
     glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
     if (!success) {
         char infoLog[512];
         glGetShaderInfoLog(shader, sizeof(infoLog), NULL, infoLog);
-        fprintf(stderr, "Shader compilation failed: %s\n", infoLog);
-        glDeleteShader(shader);
-        return 0;
+        fprintf(stderr, "%s shader compilation failed: %s\n", stage, infoLog);
     }
+    return success;
+}
 
-    return shader;
+void shader_build_begin(ShaderBuild* build, const char* vertexSrc, const char* fragmentSrc) {
+    memset(build, 0, sizeof(ShaderBuild));
+    TRACE_BEGIN("Shader issue");
+
+    // Reuse the driver's binary from an earlier run when the sources and driver are unchanged
+    if (shader_cache_enabled()) {
+        build->cache_key = shader_cache_key(vertexSrc, fragmentSrc);
+        build->program = shader_cache_load(build->cache_key);
+        if (build->program) {
+            TRACE_END();
+            return;
+        }
+    }
+
+    // Compile and link without reading any status, so the driver is free to work on it in the background
+    build->vertex_shader = issue_shader(vertexSrc, GL_VERTEX_SHADER);
+    build->fragment_shader = issue_shader(fragmentSrc, GL_FRAGMENT_SHADER);
+    build->program = glCreateProgram();
+    glAttachShader(build->program, build->vertex_shader);
+    glAttachShader(build->program, build->fragment_shader);
+    if (build->cache_key) glProgramParameteri(build->program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(build->program);
+    TRACE_END();
 }
 
-// Create a shader program from vertex and fragment shader sources
-ShaderProgram shader_create(const char* vertexSrc, const char* fragmentSrc) {
-    ShaderProgram shaderProgram = {0};
+bool shader_build_ready(const ShaderBuild* build) {
+    if (!parallel_compile || !build->program) return true;
 
-    GLuint vertexShader = compile_shader(vertexSrc, GL_VERTEX_SHADER);
-    if (vertexShader == 0) return shaderProgram;
+    GLint done = GL_TRUE;
+    glGetProgramiv(build->program, GL_COMPLETION_STATUS, &done);
+    return done == GL_TRUE;
+}
 
-    GLuint fragmentShader = compile_shader(fragmentSrc, GL_FRAGMENT_SHADER);
-    if (fragmentShader == 0) {
-        glDeleteShader(vertexShader);
-        return shaderProgram;
-    }
+ShaderProgram shader_build_finish(ShaderBuild* build) {
+    ShaderProgram shaderProgram = { build->program };
+    TRACE_BEGIN("Shader collect");
 
-    // Link shaders into a program
-    shaderProgram.id = glCreateProgram();
-    glAttachShader(shaderProgram.id, vertexShader);
-    glAttachShader(shaderProgram.id, fragmentShader);
-    glLinkProgram(shaderProgram.id);
+    // Programs from the binary cache were already checked when loaded
+    if (build->vertex_shader) {
+        bool compiled = check_shader(build->vertex_shader, "Vertex");
+        compiled = check_shader(build->fragment_shader, "Fragment") && compiled;
 
-    // Check for linking errors
-    GLint success;
-    glGetProgramiv(shaderProgram.id, GL_LINK_STATUS, &success);
-    if (!success) {
-        char infoLog[512];
-        glGetProgramInfoLog(shaderProgram.id, sizeof(infoLog), NULL, infoLog);
-        fprintf(stderr, "Shader program linking failed: %s\n", infoLog);
-        glDeleteProgram(shaderProgram.id);
-        shaderProgram.id = 0;
-    }
+        // Check for linking errors (only worth reporting when both stages compiled)
+        GLint success = GL_FALSE;
+        if (compiled) glGetProgramiv(shaderProgram.id, GL_LINK_STATUS, &success);
+        if (compiled && !success) {
+            char infoLog[512];
+            glGetProgramInfoLog(shaderProgram.id, sizeof(infoLog), NULL, infoLog);
+            fprintf(stderr, "Shader program linking failed: %s\n", infoLog);
+        }
+
+        if (!success) {
+            glDeleteProgram(shaderProgram.id);
+            shaderProgram.id = 0;
+        } else if (build->cache_key) {
+            shader_cache_store(build->cache_key, shaderProgram.id);
+        }
 
-    // Clean up shaders as they're no longer needed after linking
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+        // Clean up shaders as they're no longer needed after linking
+        glDeleteShader(build->vertex_shader);
+        glDeleteShader(build->fragment_shader);
+    }
 
+    memset(build, 0, sizeof(ShaderBuild));
+    TRACE_END();
     return shaderProgram;
 }
 
+void shader_build_cancel(ShaderBuild* build) {
+    if (build->vertex_shader) glDeleteShader(build->vertex_shader);
+    if (build->fragment_shader) glDeleteShader(build->fragment_shader);
+    if (build->program) glDeleteProgram(build->program);
+    memset(build, 0, sizeof(ShaderBuild));
+}
+
+// Create a shader program from vertex and fragment shader sources
+ShaderProgram shader_create(const char* vertexSrc, const char* fragmentSrc) {
+    ShaderBuild build;
+    shader_build_begin(&build, vertexSrc, fragmentSrc);
+    return shader_build_finish(&build);
+}
+
 // Use the shader program
 void shader_use(const ShaderProgram* shader) {
 	if (shader->id == 0) {
@@ -1,11 +1,22 @@
 #include <pipeline/texture.h>
+#include <io/vfs.h>
+#include <jobs/trace.h>
+#include <stb_image.h>
 #include <stdio.h>
+#include <string.h>
+
+// Not part of the core profile headers
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+	#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+	#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
 
 // Create a texture with raw pixel data (e.g., grayscale or RGB data)
 Texture texture_create(const unsigned char* data, int width, int height, GLenum format) {
     Texture texture = {0};
     texture.width = width;
     texture.height = height;
+    texture.gpu_bytes = (size_t)width * height * (format == GL_RED ? 1 : 4);
 
     glGenTextures(1, &texture.id);
     glBindTexture(GL_TEXTURE_2D, texture.id);
@@ -23,6 +34,142 @@ Texture texture_create(const unsigned char* data, int width, int height, GLenum
     return texture;
 }
 
+unsigned char* texture_load_pixels(const char* path, int* width, int* height, int* channels, int desired_channels) {
+    VfsFile file;
+    if (!vfs_open(&file, path)) return NULL;
+
+    TRACE_BEGIN_DETAIL("Image decode", path);
+    unsigned char* pixels = stbi_load_from_memory(file.data, (int)file.size, width, height, channels, desired_channels);
+    TRACE_END();
+    vfs_close(&file);
+    return pixels;
+}
+
+void texture_baked_path(const char* source_path, char* dest, size_t dest_size) {
+    const char* slash = strrchr(source_path, '/');
+    const char* dot = strrchr(source_path, '.');
+    int stem = (dot && (!slash || dot > slash)) ? (int)(dot - source_path) : (int)strlen(source_path);
+    snprintf(dest, dest_size, "%.*s%s", stem, source_path, TEXTURE_BAKED_EXTENSION);
+}
+
+static bool has_s3tc() {
+    static int supported = -1;
+    if (supported < 0) {
+        supported = 0;
+
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; i++) {
+            const char* name = (const char*)glGetStringi(GL_EXTENSIONS, i);
+            if (name && strcmp(name, "GL_EXT_texture_compression_s3tc") == 0) {
+                supported = 1;
+                break;
+            }
+        }
+    }
+    return supported == 1;
+}
+
+// Internal format and, for uncompressed levels, the pixel format
+static GLenum baked_internal_format(uint32_t format, GLenum* pixel_format) {
+    *pixel_format = GL_NONE;
+    switch (format) {
+        case TEXTURE_BAKED_RGB8: *pixel_format = GL_RGB; return GL_RGB8;
+        case TEXTURE_BAKED_RGBA8: *pixel_format = GL_RGBA; return GL_RGBA8;
+        case TEXTURE_BAKED_BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case TEXTURE_BAKED_BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case TEXTURE_BAKED_BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        default: return GL_NONE;
+    }
+}
+
+bool texture_baked_supported(const TextureBakedHeader* header) {
+    switch (header->format) {
+        case TEXTURE_BAKED_BC1:
+        case TEXTURE_BAKED_BC3: return has_s3tc();
+        case TEXTURE_BAKED_BC7: return GLAD_GL_VERSION_4_2;
+        default: return header->format < TEXTURE_BAKED_FORMAT_COUNT;
+    }
+}
+
+bool texture_baked_allocate(GLenum target, const TextureBakedHeader* header) {
+    GLenum pixel_format;
+    GLenum internal_format = baked_internal_format(header->format, &pixel_format);
+    if (internal_format == GL_NONE || !texture_baked_supported(header)) return false;
+
+    glTexStorage2D(target, (GLsizei)header->level_count, internal_format, (GLsizei)header->width, (GLsizei)header->height);
+    return true;
+}
+
+void texture_baked_upload(GLenum target, const TextureBakedHeader* header) {
+    GLenum pixel_format;
+    GLenum internal_format = baked_internal_format(header->format, &pixel_format);
+    const unsigned char* data = (const unsigned char*)header;
+    const TextureBakedLevel* levels = texture_baked_levels(header);
+
+    // RGB rows are tightly packed
+    GLint alignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    for (uint32_t i = 0; i < header->level_count; i++) {
+        GLsizei width = (GLsizei)texture_baked_level_dimension(header->width, i);
+        GLsizei height = (GLsizei)texture_baked_level_dimension(header->height, i);
+        const void* pixels = data + levels[i].offset;
+
+        if (texture_baked_compressed(header->format)) {
+            glCompressedTexSubImage2D(target, (GLint)i, 0, 0, width, height, internal_format, (GLsizei)levels[i].size, pixels);
+        } else {
+            glTexSubImage2D(target, (GLint)i, 0, 0, width, height, pixel_format, GL_UNSIGNED_BYTE, pixels);
+        }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+}
+
+Texture texture_create_baked(const char* path, bool flip) {
+    Texture texture = {0};
+
+    VfsFile file;
+    if (!vfs_open(&file, path)) return texture;
+
+    const TextureBakedHeader* header = texture_baked_validate(file.data, file.size);
+    if (!header) {
+        fprintf(stderr, "Invalid baked texture %s\n", path);
+        vfs_close(&file);
+        return texture;
+    }
+    if (((header->flags & TEXTURE_BAKED_FLIPPED) != 0) != flip) {
+        fprintf(stderr, "Baked texture %s has the wrong orientation, rebake it%s\n", path, flip ? " with --flip" : " without --flip");
+        vfs_close(&file);
+        return texture;
+    }
+
+    glGenTextures(1, &texture.id);
+    glBindTexture(GL_TEXTURE_2D, texture.id);
+
+    if (!texture_baked_allocate(GL_TEXTURE_2D, header)) {
+        fprintf(stderr, "Baked texture format of %s is not supported by this GL\n", path);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDeleteTextures(1, &texture.id);
+        vfs_close(&file);
+        texture.id = 0;
+        return texture;
+    }
+    texture_baked_upload(GL_TEXTURE_2D, header);
+
+    // Sample the stored chain, if there is one
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, header->level_count > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    texture.width = (int)header->width;
+    texture.height = (int)header->height;
+    texture.gpu_bytes = texture_baked_gpu_bytes(header);
+    vfs_close(&file);
+    return texture;
+}
+
 // Bind the texture to a specified texture unit (e.g., GL_TEXTURE0)
 void texture_bind(const Texture* texture, GLenum textureUnit) {
     glActiveTexture(textureUnit);
@@ -0,0 +1,472 @@
+#include <pipeline/texture_registry.h>
+#include <io/vfs.h>
+#include <hash.h>
+#include <jobs/thread.h>
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define REGISTRY_NONE UINT32_MAX
+
+typedef struct {
+    GLuint id;
+    uint64_t content_hash;   // 0 when the texture has no backing file (e.g. built-in fallbacks)
+    char **paths;            // Canonical paths resolving to this texture
+    uint32_t path_count;
+    atomic_uint refs;
+    size_t gpu_bytes;
+    int width, height;
+} TextureEntry;
+
+// Open-addressing hash map (linear probing, backward-shift deletion) from a 64-bit key hash to an entry slot.
+// A stored hash of 0 marks an empty bucket, key hashes are never 0.
+typedef struct {
+    uint64_t *hashes;
+    uint32_t *values;
+    uint32_t capacity;
+    uint32_t count;
+} RegistryMap;
+
+typedef bool (*MapMatch)(const TextureEntry *entry, const void *key);
+
+// Everything below is guarded by registry_lock; it covers table changes (path copies, rehashes), never GL calls
+static Mutex registry_lock;
+static bool lock_ready = false;
+
+static TextureEntry **entries = NULL;
+static uint32_t entry_capacity = 0;
+static uint32_t *free_slots = NULL;
+static uint32_t free_count = 0;
+static uint32_t live_count = 0;
+static size_t total_gpu_bytes = 0;
+
+static RegistryMap path_map;     // Canonical path -> entry
+static RegistryMap content_map;  // File content hash -> entry
+static RegistryMap id_map;       // GL texture name -> entry
+
+static void registry_lock_acquire() {
+    mutex_lock(&registry_lock);
+}
+
+static void registry_lock_release() {
+    mutex_unlock(&registry_lock);
+}
+
+// ----------------------------------------------------------------------------
+// Hashing
+// ----------------------------------------------------------------------------
+
+static uint64_t hash_string(const char *text) {
+    uint64_t hash = 0xcbf29ce484222325ull; // FNV-1a
+    for (; *text; text++) {
+        hash ^= (unsigned char)*text;
+        hash *= 0x100000001b3ull;
+    }
+    return hash ? hash : 1;
+}
+
+static uint64_t hash_id(GLuint id) {
+    uint64_t hash = hash_mix64((uint64_t)id + 0x9e3779b97f4a7c15ull);
+    return hash ? hash : 1;
+}
+
+bool texture_path_canonical(const char *path, char *dest, size_t dest_size) {
+    if (!path || !dest || dest_size == 0) return false;
+
+#ifdef _WIN32
+    if (!_fullpath(dest, path, dest_size)) {
+        snprintf(dest, dest_size, "%s", path);
+        return false;
+    }
+
+    // NTFS is case-insensitive, fold so different spellings share one key
+    for (char *p = dest; *p; p++) {
+        *p = (*p == '\\') ? '/' : (char)tolower((unsigned char)*p);
+    }
+    return true;
+#else
+    // Packed files have no real path, their normalized name is still unique
+    char *resolved = realpath(path, NULL);
+    if (!resolved) {
+        vfs_normalize_path(path, dest, dest_size);
+        return false;
+    }
+
+    snprintf(dest, dest_size, "%s", resolved);
+    free(resolved);
+    return true;
+#endif
+}
+
+size_t texture_gpu_bytes(int width, int height, int channels, bool mipmapped) {
+    size_t texel_bytes = channels == 3 ? 4 : (size_t)channels;
+    size_t bytes = (size_t)width * (size_t)height * texel_bytes;
+    return mipmapped ? bytes + bytes / 3 : bytes;
+}
+
+// ----------------------------------------------------------------------------
+// Hash map
+// ----------------------------------------------------------------------------
+
+static uint32_t map_find(const RegistryMap *map, uint64_t hash, MapMatch match, const void *key) {
+    if (!map->capacity) return REGISTRY_NONE;
+
+    uint32_t mask = map->capacity - 1;
+    for (uint32_t i = (uint32_t)hash & mask;; i = (i + 1) & mask) {
+        if (!map->hashes[i]) return REGISTRY_NONE;
+        if (map->hashes[i] == hash && match(entries[map->values[i]], key)) return map->values[i];
+    }
+}
+
+static bool map_insert(RegistryMap *map, uint64_t hash, uint32_t value);
+
+static bool map_grow(RegistryMap *map) {
+    RegistryMap grown = {0};
+    grown.capacity = map->capacity ? map->capacity * 2 : 64;
+    grown.hashes = calloc(grown.capacity, sizeof(uint64_t));
+    grown.values = malloc(sizeof(uint32_t) * grown.capacity);
+    if (!grown.hashes || !grown.values) {
+        free(grown.hashes);
+        free(grown.values);
+        fprintf(stderr, "[TEXTURES] Failed to grow the registry map!\n");
+        return false;
+    }
+
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        if (map->hashes[i]) map_insert(&grown, map->hashes[i], map->values[i]);
+    }
+
+    free(map->hashes);
+    free(map->values);
+    *map = grown;
+    return true;
+}
+
+static bool map_insert(RegistryMap *map, uint64_t hash, uint32_t value) {
+    // Keep the load factor under 3/4
+    if ((map->count + 1) * 4 > map->capacity * 3 && !map_grow(map)) return false;
+
+    uint32_t mask = map->capacity - 1;
+    uint32_t i = (uint32_t)hash & mask;
+    while (map->hashes[i]) i = (i + 1) & mask;
+
+    map->hashes[i] = hash;
+    map->values[i] = value;
+    map->count++;
+    return true;
+}
+
+static void map_remove(RegistryMap *map, uint64_t hash, uint32_t value) {
+    if (!map->capacity) return;
+
+    uint32_t mask = map->capacity - 1;
+    uint32_t i = (uint32_t)hash & mask;
+    while (map->hashes[i] && !(map->hashes[i] == hash && map->values[i] == value)) i = (i + 1) & mask;
+    if (!map->hashes[i]) return;
+
+    // Shift the following run back so probes never stop at a hole
+    uint32_t j = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (!map->hashes[j]) break;
+
+        uint32_t home = (uint32_t)map->hashes[j] & mask;
+        bool movable = (i <= j) ? (home <= i || home > j) : (home <= i && home > j);
+        if (movable) {
+            map->hashes[i] = map->hashes[j];
+            map->values[i] = map->values[j];
+            i = j;
+        }
+    }
+
+    map->hashes[i] = 0;
+    map->count--;
+}
+
+static void map_free(RegistryMap *map) {
+    free(map->hashes);
+    free(map->values);
+    memset(map, 0, sizeof(RegistryMap));
+}
+
+// Dying entries (last reference dropped, removal pending) never match
+static bool match_path(const TextureEntry *entry, const void *key) {
+    if (atomic_load(&entry->refs) == 0) return false;
+    for (uint32_t i = 0; i < entry->path_count; i++) {
+        if (strcmp(entry->paths[i], (const char *)key) == 0) return true;
+    }
+    return false;
+}
+
+static bool match_content(const TextureEntry *entry, const void *key) {
+    return atomic_load(&entry->refs) != 0 && entry->content_hash == *(const uint64_t *)key;
+}
+
+static bool match_id(const TextureEntry *entry, const void *key) {
+    return entry->id == *(const GLuint *)key;
+}
+
+// ----------------------------------------------------------------------------
+// Entries
+// ----------------------------------------------------------------------------
+
+// Take a reference unless the entry is already on its way out
+static bool entry_try_retain(TextureEntry *entry) {
+    unsigned int refs = atomic_load(&entry->refs);
+    while (refs != 0) {
+        if (atomic_compare_exchange_weak(&entry->refs, &refs, refs + 1)) return true;
+    }
+    return false;
+}
+
+static bool entry_add_path(TextureEntry *entry, uint32_t slot, const char *path) {
+    char **paths = realloc(entry->paths, sizeof(char *) * (entry->path_count + 1));
+    if (!paths) return false;
+    entry->paths = paths;
+
+    entry->paths[entry->path_count] = strdup(path);
+    if (!entry->paths[entry->path_count]) return false;
+
+    if (!map_insert(&path_map, hash_string(path), slot)) {
+        free(entry->paths[entry->path_count]);
+        return false;
+    }
+    entry->path_count++;
+    return true;
+}
+
+static uint32_t entry_slot(const TextureEntry *entry) {
+    GLuint id = entry->id;
+    return map_find(&id_map, hash_id(id), match_id, &id);
+}
+
+static uint32_t entry_alloc_slot() {
+    if (free_count) return free_slots[--free_count];
+
+    uint32_t capacity = entry_capacity ? entry_capacity * 2 : 64;
+    TextureEntry **grown = realloc(entries, sizeof(TextureEntry *) * capacity);
+    uint32_t *grown_free = realloc(free_slots, sizeof(uint32_t) * capacity);
+    if (grown) entries = grown;
+    if (grown_free) free_slots = grown_free;
+    if (!grown || !grown_free) return REGISTRY_NONE;
+
+    // Hand out the new slots from the lowest index
+    memset(entries + entry_capacity, 0, sizeof(TextureEntry *) * (capacity - entry_capacity));
+    for (uint32_t i = capacity; i > entry_capacity + 1; i--) free_slots[free_count++] = i - 1;
+    uint32_t slot = entry_capacity;
+    entry_capacity = capacity;
+    return slot;
+}
+
+// Remove every key of the entry and free it (lock held)
+static void entry_remove(uint32_t slot) {
+    TextureEntry *entry = entries[slot];
+
+    for (uint32_t i = 0; i < entry->path_count; i++) {
+        map_remove(&path_map, hash_string(entry->paths[i]), slot);
+        free(entry->paths[i]);
+    }
+    free(entry->paths);
+
+    if (entry->content_hash) map_remove(&content_map, entry->content_hash, slot);
+    map_remove(&id_map, hash_id(entry->id), slot);
+
+    total_gpu_bytes -= entry->gpu_bytes;
+    live_count--;
+
+    free(entry);
+    entries[slot] = NULL;
+    free_slots[free_count++] = slot;
+}
+
+// Look up by path, then by content (lock held). Returns the slot with a new reference, or REGISTRY_NONE.
+static uint32_t registry_lookup(const char *canonical_path, uint64_t content_hash) {
+    uint32_t slot = map_find(&path_map, hash_string(canonical_path), match_path, canonical_path);
+    if (slot != REGISTRY_NONE && entry_try_retain(entries[slot])) return slot;
+
+    if (!content_hash) return REGISTRY_NONE;
+
+    slot = map_find(&content_map, content_hash, match_content, &content_hash);
+    if (slot == REGISTRY_NONE || !entry_try_retain(entries[slot])) return REGISTRY_NONE;
+
+    // Same file under another name, remember this path too
+    entry_add_path(entries[slot], slot, canonical_path);
+    return slot;
+}
+
+// ----------------------------------------------------------------------------
+// Public API
+// ----------------------------------------------------------------------------
+
+GLuint texture_registry_find(const char *canonical_path, uint64_t content_hash) {
+    if (!canonical_path) return 0;
+
+    registry_lock_acquire();
+    uint32_t slot = registry_lookup(canonical_path, content_hash);
+    GLuint id = slot != REGISTRY_NONE ? entries[slot]->id : 0;
+    registry_lock_release();
+    return id;
+}
+
+GLuint texture_registry_add(const char *canonical_path, uint64_t content_hash, GLuint texture_id, int width, int height, size_t gpu_bytes) {
+    if (!canonical_path || !texture_id) return texture_id;
+
+    registry_lock_acquire();
+
+    // Someone else uploaded the same texture while this one was being decoded
+    uint32_t existing = registry_lookup(canonical_path, content_hash);
+    if (existing != REGISTRY_NONE) {
+        GLuint id = entries[existing]->id;
+        registry_lock_release();
+
+        if (id != texture_id) glDeleteTextures(1, &texture_id);
+        return id;
+    }
+
+    uint32_t slot = entry_alloc_slot();
+    TextureEntry *entry = slot != REGISTRY_NONE ? calloc(1, sizeof(TextureEntry)) : NULL;
+    if (!entry) {
+        if (slot != REGISTRY_NONE) free_slots[free_count++] = slot;
+        registry_lock_release();
+        fprintf(stderr, "[TEXTURES] Failed to register %s, it will not be shared.\n", canonical_path);
+        return texture_id;
+    }
+
+    entry->id = texture_id;
+    entry->content_hash = content_hash;
+    entry->width = width;
+    entry->height = height;
+    entry->gpu_bytes = gpu_bytes;
+    atomic_init(&entry->refs, 1);
+    entries[slot] = entry;
+
+    entry_add_path(entry, slot, canonical_path);
+    if (content_hash) map_insert(&content_map, content_hash, slot);
+    map_insert(&id_map, hash_id(texture_id), slot);
+
+    total_gpu_bytes += gpu_bytes;
+    live_count++;
+
+    registry_lock_release();
+    return texture_id;
+}
+
+void texture_registry_retain(GLuint texture_id) {
+    if (!texture_id) return;
+
+    registry_lock_acquire();
+    uint32_t slot = map_find(&id_map, hash_id(texture_id), match_id, &texture_id);
+    if (slot != REGISTRY_NONE) entry_try_retain(entries[slot]); // Not an entry whose last release is deleting it
+    registry_lock_release();
+}
+
+void texture_registry_release(GLuint texture_id) {
+    if (!texture_id) return;
+
+    // The caller's reference keeps the entry alive until the decrement
+    registry_lock_acquire();
+    uint32_t slot = map_find(&id_map, hash_id(texture_id), match_id, &texture_id);
+    TextureEntry *entry = slot != REGISTRY_NONE ? entries[slot] : NULL;
+    registry_lock_release();
+
+    if (!entry) {
+        fprintf(stderr, "[TEXTURES] Released texture %u that is not registered.\n", texture_id);
+        return;
+    }
+    if (atomic_fetch_sub(&entry->refs, 1) != 1) return;
+
+    // Last reference: nothing can retain it any more (lookups skip dead entries), unregister and delete
+    registry_lock_acquire();
+    entry_remove(entry_slot(entry));
+    registry_lock_release();
+
+    glDeleteTextures(1, &texture_id);
+}
+
+uint32_t texture_registry_refcount(GLuint texture_id) {
+    registry_lock_acquire();
+    uint32_t slot = map_find(&id_map, hash_id(texture_id), match_id, &texture_id);
+    uint32_t refs = slot != REGISTRY_NONE ? atomic_load(&entries[slot]->refs) : 0;
+    registry_lock_release();
+    return refs;
+}
+
+bool texture_registry_size(GLuint texture_id, int *width, int *height) {
+    registry_lock_acquire();
+    uint32_t slot = map_find(&id_map, hash_id(texture_id), match_id, &texture_id);
+    if (slot != REGISTRY_NONE) {
+        *width = entries[slot]->width;
+        *height = entries[slot]->height;
+    }
+    registry_lock_release();
+    return slot != REGISTRY_NONE;
+}
+
+size_t texture_registry_gpu_bytes(GLuint texture_id) {
+    registry_lock_acquire();
+    uint32_t slot = map_find(&id_map, hash_id(texture_id), match_id, &texture_id);
+    size_t bytes = slot != REGISTRY_NONE ? entries[slot]->gpu_bytes : 0;
+    registry_lock_release();
+    return bytes;
+}
+
+size_t texture_registry_total_gpu_bytes() {
+    registry_lock_acquire();
+    size_t bytes = total_gpu_bytes;
+    registry_lock_release();
+    return bytes;
+}
+
+uint32_t texture_registry_count() {
+    registry_lock_acquire();
+    uint32_t count = live_count;
+    registry_lock_release();
+    return count;
+}
+
+void texture_registry_report() {
+    registry_lock_acquire();
+    printf("[TEXTURES] %u textures, %.2f MiB of GPU memory\n", live_count, total_gpu_bytes / (1024.0 * 1024.0));
+    for (uint32_t i = 0; i < entry_capacity; i++) {
+        TextureEntry *entry = entries[i];
+        if (!entry) continue;
+
+        printf("  #%u %dx%d %8.1f KiB refs=%u %s\n", entry->id, entry->width, entry->height,
+               entry->gpu_bytes / 1024.0, atomic_load(&entry->refs), entry->path_count ? entry->paths[0] : "");
+    }
+    registry_lock_release();
+}
+
+void texture_registry_init() {
+    if (lock_ready) return;
+    mutex_init(&registry_lock);
+    lock_ready = true;
+}
+
+void texture_registry_shutdown() {
+    registry_lock_acquire();
+    for (uint32_t i = 0; i < entry_capacity; i++) {
+        TextureEntry *entry = entries[i];
+        if (!entry) continue;
+
+        printf("[TEXTURES] Texture %u (%s) still has %u references at shutdown.\n",
+               entry->id, entry->path_count ? entry->paths[0] : "", atomic_load(&entry->refs));
+        glDeleteTextures(1, &entry->id);
+        entry_remove(i);
+    }
+
+    free(entries);
+    free(free_slots);
+    entries = NULL;
+    free_slots = NULL;
+    entry_capacity = free_count = live_count = 0;
+    total_gpu_bytes = 0;
+
+    map_free(&path_map);
+    map_free(&content_map);
+    map_free(&id_map);
+    registry_lock_release();
+}
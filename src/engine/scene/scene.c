@@ -1,5 +1,7 @@
 #include <scenes/scene.h>
 
+#include <stdio.h>
+
 // Create a new scene
 Scene *scene_create(const char *name, GLFWwindow *window) {
     Scene *scene = (Scene *)malloc(sizeof(Scene));
@@ -7,8 +9,8 @@ Scene *scene_create(const char *name, GLFWwindow *window) {
 
     scene->name = strdup(name);
     scene->window = window;
-    scene->state.data = NULL;
-    scene->state.count = 0;
+    scene->state = (SceneState){ 0 };
+    scene->resident = false;
     scene->update = NULL;
     scene->render = NULL;
     scene->cleanup = NULL;
@@ -24,48 +26,126 @@ void scene_destroy(Scene *scene) {
 
     // Free state data
     for (size_t i = 0; i < scene->state.count; i++) {
-        free(scene->state.data[i].key);
-        free(scene->state.data[i].value);
+        free(scene->state.keys[i]);
     }
-    free(scene->state.data);
+    free(scene->state.keys);
+    free(scene->state.values);
 
     free(scene);
 }
 
-// Set a key-value pair in the scene state
-bool scene_state_set(SceneState *state, const char *key, const char *value) {
-    if (!state || !key || !value) return false;
+// Find the slot of a registered key, only meant for setup
+StateSlot scene_state_find(const SceneState *state, const char *key) {
+    if (!state || !key) return -1;
 
-    // Check if key already exists
     for (size_t i = 0; i < state->count; i++) {
-        if (strcmp(state->data[i].key, key) == 0) {
-            free(state->data[i].value);
-            state->data[i].value = strdup(value);
-            return true;
+        if (strcmp(state->keys[i], key) == 0) {
+            return (StateSlot)i;
         }
     }
+    return -1;
+}
+
+// Register a typed value, starting at zero
+StateSlot scene_state_register(SceneState *state, const char *key, StateType type) {
+    if (!state || !key) return -1;
+
+    StateSlot existing = scene_state_find(state, key);
+    if (existing >= 0) {
+        if (state->values[existing].type == type) return existing;
+        fprintf(stderr, "Scene state key %s is already registered with another type\n", key);
+        return -1;
+    }
+
+    if (state->count == state->capacity) {
+        size_t capacity = state->capacity ? state->capacity * 2 : 8;
+        char **keys = (char **)realloc(state->keys, capacity * sizeof(char *));
+        if (!keys) return -1;
+        state->keys = keys;
+        StateValue *values = (StateValue *)realloc(state->values, capacity * sizeof(StateValue));
+        if (!values) return -1;
+        state->values = values;
+        state->capacity = capacity;
+    }
+
+    char *interned = strdup(key);
+    if (!interned) return -1;
+    state->keys[state->count] = interned;
+    state->values[state->count] = (StateValue){ .type = type, .version = 1 };
+    return (StateSlot)state->count++;
+}
 
-    // Add a new key-value pair
-    KeyValuePair *new_data = (KeyValuePair *)realloc(state->data, (state->count + 1) * sizeof(KeyValuePair));
-    if (!new_data) return false;
+// Value of the slot when it holds the type, NULL otherwise
+static StateValue *state_value(const SceneState *state, StateSlot slot, StateType type) {
+    if (!state || slot < 0 || (size_t)slot >= state->count) return NULL;
+    StateValue *value = &state->values[slot];
+    return value->type == type ? value : NULL;
+}
 
-    state->data = new_data;
-    state->data[state->count].key = strdup(key);
-    state->data[state->count].value = strdup(value);
-    state->count++;
+bool scene_state_set_int(SceneState *state, StateSlot slot, int value) {
+    StateValue *entry = state_value(state, slot, STATE_INT);
+    if (!entry) return false;
+    if (entry->i != value) {
+        entry->i = value;
+        entry->version++;
+    }
     return true;
 }
 
-// Get a value from the scene state by key
-const char *scene_state_get(const SceneState *state, const char *key) {
-    if (!state || !key) return NULL;
+bool scene_state_set_float(SceneState *state, StateSlot slot, float value) {
+    StateValue *entry = state_value(state, slot, STATE_FLOAT);
+    if (!entry) return false;
+    if (entry->f != value) {
+        entry->f = value;
+        entry->version++;
+    }
+    return true;
+}
 
-    for (size_t i = 0; i < state->count; i++) {
-        if (strcmp(state->data[i].key, key) == 0) {
-            return state->data[i].value;
-        }
+bool scene_state_set_bool(SceneState *state, StateSlot slot, bool value) {
+    StateValue *entry = state_value(state, slot, STATE_BOOL);
+    if (!entry) return false;
+    if (entry->b != value) {
+        entry->b = value;
+        entry->version++;
     }
-    return NULL;
+    return true;
+}
+
+bool scene_state_set_vec4(SceneState *state, StateSlot slot, const float value[4]) {
+    StateValue *entry = state_value(state, slot, STATE_VEC4);
+    if (!entry) return false;
+    if (memcmp(entry->v, value, sizeof(entry->v)) != 0) {
+        memcpy(entry->v, value, sizeof(entry->v));
+        entry->version++;
+    }
+    return true;
+}
+
+int scene_state_get_int(const SceneState *state, StateSlot slot) {
+    const StateValue *entry = state_value(state, slot, STATE_INT);
+    return entry ? entry->i : 0;
+}
+
+float scene_state_get_float(const SceneState *state, StateSlot slot) {
+    const StateValue *entry = state_value(state, slot, STATE_FLOAT);
+    return entry ? entry->f : 0.0f;
+}
+
+bool scene_state_get_bool(const SceneState *state, StateSlot slot) {
+    const StateValue *entry = state_value(state, slot, STATE_BOOL);
+    return entry ? entry->b : false;
+}
+
+const float *scene_state_get_vec4(const SceneState *state, StateSlot slot) {
+    static const float zero[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    const StateValue *entry = state_value(state, slot, STATE_VEC4);
+    return entry ? entry->v : zero;
+}
+
+uint32_t scene_state_version(const SceneState *state, StateSlot slot) {
+    if (!state || slot < 0 || (size_t)slot >= state->count) return 0;
+    return state->values[slot].version;
 }
 
 // Call the update function of the scene
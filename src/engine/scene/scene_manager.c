@@ -0,0 +1,136 @@
+#include <loaders/assets.h>
+#include <scenes/scene_manager.h>
+#include <jobs/trace.h>
+
+#include <stdio.h>
+
+typedef enum { OP_PUSH, OP_REPLACE, OP_POP } SceneOp;
+
+typedef struct {
+    SceneOp op;
+    Scene *scene;           // NULL for pop
+    SceneTransition state;
+} PendingTransition;
+
+static Scene *stack[SCENE_MANAGER_MAX_DEPTH];
+static int depth = 0;
+
+static PendingTransition pending[SCENE_MANAGER_MAX_PENDING];
+static int pending_count = 0;
+
+static bool top_shown = false; // The current scene ran at least one frame, setups wait for it
+
+// Everything the scene's setup queued has been finalized (assets finalize in request order)
+static void on_scene_resident(Asset *asset, void *user) {
+    (void)asset;
+    ((Scene *)user)->resident = true;
+}
+
+static bool queue_transition(SceneOp op, Scene *scene) {
+    if (pending_count == SCENE_MANAGER_MAX_PENDING) {
+        fprintf(stderr, "[SCENE] Transition queue full, dropping %s\n", scene ? scene->name : "pop");
+        return false;
+    }
+    pending[pending_count++] = (PendingTransition){ op, scene, SCENE_TRANSITION_PENDING };
+    return true;
+}
+
+bool scene_manager_push(Scene *scene) {
+    return scene && queue_transition(OP_PUSH, scene);
+}
+
+bool scene_manager_replace(Scene *scene) {
+    return scene && queue_transition(OP_REPLACE, scene);
+}
+
+bool scene_manager_pop() {
+    return queue_transition(OP_POP, NULL);
+}
+
+// Run the scene's setup and mark where its loads end
+static void start_setup(PendingTransition *transition) {
+    Scene *scene = transition->scene;
+    TRACE_BEGIN_DETAIL("Scene setup", scene->name);
+    scene->resident = false;
+    if (scene->render) scene->render(scene);
+
+    // Nothing queued at all: resident now, otherwise when the barrier behind its loads is reached
+    if (assets_idle()) scene->resident = true;
+    else assets_after(on_scene_resident, scene);
+    TRACE_END();
+
+    transition->state = scene->resident ? SCENE_TRANSITION_READY : SCENE_TRANSITION_LOADING;
+}
+
+// Switch to the transition's scene, false when the stack cannot take it
+static bool apply(const PendingTransition *transition) {
+    switch (transition->op) {
+        case OP_PUSH:
+            if (depth == SCENE_MANAGER_MAX_DEPTH) {
+                fprintf(stderr, "[SCENE] Scene stack full, cannot push %s\n", transition->scene->name);
+                return false;
+            }
+            stack[depth++] = transition->scene;
+            break;
+        case OP_REPLACE:
+            if (depth > 0) scene_cleanup(stack[--depth]);
+            stack[depth++] = transition->scene;
+            break;
+        case OP_POP:
+            if (depth > 0) scene_cleanup(stack[--depth]);
+            break;
+    }
+    top_shown = false;
+    printf("[SCENE] Now running %s\n", depth > 0 ? stack[depth - 1]->name : "nothing");
+    return true;
+}
+
+void scene_manager_update() {
+    // At most one setup per frame, and only after the current scene got a frame, so setups never pile up
+    // into one long frame and a loading screen is on screen before the next scene starts loading
+    if (top_shown || depth == 0) {
+        for (int i = 0; i < pending_count; i++) {
+            if (pending[i].op != OP_POP && pending[i].state == SCENE_TRANSITION_PENDING) {
+                start_setup(&pending[i]);
+                break;
+            }
+        }
+    }
+
+    // Apply finished transitions in request order
+    while (pending_count > 0) {
+        PendingTransition *next = &pending[0];
+        if (next->state == SCENE_TRANSITION_LOADING && next->scene->resident) next->state = SCENE_TRANSITION_READY;
+        if (next->op != OP_POP && next->state != SCENE_TRANSITION_READY) break;
+
+        if (!apply(next)) scene_cleanup(next->scene);
+        pending_count--;
+        for (int i = 0; i < pending_count; i++) pending[i] = pending[i + 1];
+    }
+
+    if (depth > 0) {
+        scene_update(stack[depth - 1]);
+        top_shown = true;
+    }
+}
+
+Scene *scene_manager_current() {
+    return depth > 0 ? stack[depth - 1] : NULL;
+}
+
+SceneTransition scene_manager_transition() {
+    if (pending_count == 0) return SCENE_TRANSITION_NONE;
+    const PendingTransition *next = &pending[0];
+    if (next->state == SCENE_TRANSITION_LOADING && next->scene->resident) return SCENE_TRANSITION_READY;
+    return next->state;
+}
+
+void scene_manager_shutdown() {
+    // Top of the stack first, then scenes that were set up but never switched to
+    while (depth > 0) scene_cleanup(stack[--depth]);
+    for (int i = 0; i < pending_count; i++) {
+        if (pending[i].op != OP_POP && pending[i].state != SCENE_TRANSITION_PENDING) scene_cleanup(pending[i].scene);
+    }
+    pending_count = 0;
+    top_shown = false;
+}
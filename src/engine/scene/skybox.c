@@ -1,6 +1,7 @@
 #include <scenes/skybox.h>
 #include <pipeline/shader.h>
 #include <pipeline/buffers.h>
+#include <pipeline/texture.h>
 
 #include <stdio.h>
 #include <string.h>
@@ -65,7 +66,7 @@ GLuint loadCubemap(const char* faces[6]) {
     for (GLuint i = 0; i < 6; i++) {
         char path[1024];
         snprintf(path, sizeof(path), "%s", faces[i]);  // Construct the path for each face
-        unsigned char *data = stbi_load(path, &width, &height, &nrChannels, 0);
+        unsigned char *data = texture_load_pixels(path, &width, &height, &nrChannels, 0);
         if (data) {
             glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
             stbi_image_free(data);
@@ -85,12 +86,16 @@ GLuint loadCubemap(const char* faces[6]) {
 }
 
 void skybox_init(Skybox* skybox, const char* source[6], size_t program_id) {
-    // Store the program ID and texture faces
-    skybox->program_id = program_id;
+    // Store the texture faces
     memcpy(skybox->faces, source, sizeof(skybox->faces));
 
     // Load skybox textures (6 images for each side of the cube)
     GLuint texture_id = loadCubemap(skybox->faces); // Helper function to load cubemap textures
+    skybox_init_from_texture(skybox, texture_id, program_id);
+}
+
+void skybox_init_from_texture(Skybox* skybox, GLuint texture_id, size_t program_id) {
+    skybox->program_id = program_id;
     skybox->texture_id = texture_id;
 
 	// Initialize the buffers for the mesh
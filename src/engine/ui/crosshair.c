@@ -2,7 +2,7 @@
 
 #include <glad/glad.h>
 #include <pipeline/shader.h>
-#include <qreader.h>
+#include <pipeline/resources.h>
 
 // Vertex data for a plus-shaped crosshair
 static const float crosshairVertices[] = {
@@ -30,18 +30,9 @@ void crosshair_init(Crosshair *crosshair, float size, float thickness, vec4 colo
     buffers_unbind_vbo();
     buffers_unbind_vao();
 
-    // Initialize the shader once during crosshair setup
-    char* vertexShaderSource = read_file("resources/shaders/crosshair/vertex.glsl");
-    char* fragmentShaderSource = read_file("resources/shaders/crosshair/fragment.glsl");
-    if (!vertexShaderSource || !fragmentShaderSource) {
-        fprintf(stderr, "Failed to load crosshair shader sources!\n");
-        return;
-    }
-    crosshair->shader = shader_create(vertexShaderSource, fragmentShaderSource);
-
-    // Free shader source memory after creating the shader
-    free(vertexShaderSource);
-    free(fragmentShaderSource);
+    // Shared with every other crosshair, compiled by the first one
+    crosshair->shader = resources_program_acquire("resources/shaders/crosshair/vertex.glsl", "resources/shaders/crosshair/fragment.glsl");
+    if (!crosshair->shader.id) fprintf(stderr, "Crosshair shader program creation failed!\n");
 }
 
 void crosshair_render(Crosshair *crosshair, int screenWidth, int screenHeight) {
@@ -74,5 +65,5 @@ void crosshair_render(Crosshair *crosshair, int screenWidth, int screenHeight) {
 // Clean up crosshair resources, including the shader
 void crosshair_destroy(Crosshair *crosshair) {
     buffers_destroy(&crosshair->buffers);
-    shader_destroy(&crosshair->shader); // Properly release the shader here
+    resources_program_release(&crosshair->shader); // Destroyed with the last crosshair
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #include <stb_image.h>
 #include <pipeline/buffers.h>
+#include <pipeline/texture.h>
+#include <pipeline/texture_registry.h>
 #include <input/kbd.h>
 #include <cglm/cglm.h>
 
@@ -25,17 +27,53 @@ static GLuint create_texture_from_data(unsigned char *data, int width, int heigh
 }
 
 void image_init(Image *image, const char *image_path, GLuint shader_program) {
+    // Images of the same file share one texture, whichever scene loaded it first
+    char canonical_path[TEXTURE_PATH_MAX];
+    texture_path_canonical(image_path, canonical_path, sizeof(canonical_path));
+    GLuint shared = texture_registry_find(canonical_path, 0);
+    int width, height;
+    if (shared && texture_registry_size(shared, &width, &height)) {
+        image_init_from_texture(image, shared, width, height, shader_program);
+        image->registry_texture = true;
+        return;
+    }
+
+    // Prefer the baked container next to the image, it needs no decoding
+    char baked_path[1024];
+    texture_baked_path(image_path, baked_path, sizeof(baked_path));
+    Texture baked = texture_create_baked(baked_path, false);
+    if (baked.id) {
+        glBindTexture(GL_TEXTURE_2D, baked.id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        GLuint texture_id = texture_registry_add(canonical_path, 0, baked.id, baked.width, baked.height, baked.gpu_bytes);
+        image_init_from_texture(image, texture_id, baked.width, baked.height, shader_program);
+        image->registry_texture = texture_registry_refcount(texture_id) > 0; // Not when registering failed
+        return;
+    }
+
     // Load the image
-    int width, height, nrChannels;
-    unsigned char *data = stbi_load(image_path, &width, &height, &nrChannels, 0);
+    int nrChannels;
+    unsigned char *data = texture_load_pixels(image_path, &width, &height, &nrChannels, 0);
     if (!data) {
         fprintf(stderr, "Failed to load image: %s\n", image_path);
         return;
     }
 
-    // Create the texture
+    // Create the texture and the quad
+    GLuint texture_id = create_texture_from_data(data, width, height, nrChannels);
+    texture_id = texture_registry_add(canonical_path, 0, texture_id, width, height, texture_gpu_bytes(width, height, nrChannels, false));
+    image_init_from_texture(image, texture_id, width, height, shader_program);
+    image->registry_texture = texture_registry_refcount(texture_id) > 0;
+
+    // Cleanup
+    stbi_image_free(data);
+}
+
+void image_init_from_texture(Image *image, GLuint texture_id, int width, int height, GLuint shader_program) {
     image->shader_program = shader_program;
-    image->texture_id = create_texture_from_data(data, width, height, nrChannels);
+    image->texture_id = texture_id;
+    image->registry_texture = false;
     image->width = width;
     image->height = height;
 
@@ -69,9 +107,6 @@ void image_init(Image *image, const char *image_path, GLuint shader_program) {
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 4, (void*)(sizeof(float) * 2));
     glEnableVertexAttribArray(1);
-
-    // Cleanup
-    stbi_image_free(data);
 }
 
 void image_set_dimensions(Image *image, int new_width, int new_height) {
@@ -260,7 +295,8 @@ void image_render(Image *image, float x, float y) {
 }
 
 void image_cleanup(Image *image) {
-    glDeleteTextures(1, &image->texture_id);
+    if (image->registry_texture) texture_registry_release(image->texture_id);
+    else glDeleteTextures(1, &image->texture_id);
     glDeleteBuffers(1, &image->buffers.VBO);
     if (image->buffers.EBO != 0) {
         glDeleteBuffers(1, &image->buffers.EBO);
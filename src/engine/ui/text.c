@@ -1,140 +1,615 @@
 #include <ui/text.h>
 #include <input/kbd.h>
+#include <io/vfs.h>
+#include <io/cache.h>
+#include <jobs/jobs.h>
+#include <jobs/trace.h>
+#include <hash.h>
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 
 #include <stb_truetype.h>
 
-void font_get_text_dimensions(Font *font, const char *text, float *width, float *height) {
-    *width = 0.0f;
-    *height = 0.0f;
+#define FONT_ATLAS_SIZE 1024       // Square GL_R8 atlas shared by every size of a font
+#define FONT_MAX_SHELVES 128
+#define FONT_SHELF_ROUNDING 8       // Shelf heights are rounded up so similar glyphs share shelves
+#define FONT_PRELOAD_FIRST 33       // Printable ASCII is generated up front (and cached), the rest on first use
+#define FONT_PRELOAD_LAST 126
+#define FONT_SDF_ON_EDGE 128        // Distance field value on the glyph outline (the shader's 0.5)
+#define FONT_CACHE_MAGIC 0x544E464Cu // "LFNT"
+#define FONT_CACHE_VERSION 2
+
+// Glyph metrics in atlas pixels (scaled by size / FONT_SDF_PIXEL_HEIGHT when drawn)
+typedef struct {
+    uint32_t codepoint;       // 0 marks an empty hash slot
+    int glyph_index;          // In the font, kerning is looked up by glyph
+    float u0, v0, u1, v1;     // Atlas texture coordinates
+    float x_offset, y_offset; // Quad corner from the pen position, padding included
+    float width, height;      // Quad size, padding included (0 for blank glyphs)
+    float advance;
+    int shelf;                // -1 when the glyph has no bitmap
+} FontGlyph;
+
+typedef struct {
+    int y, height;
+    int x;                    // Next free column
+    uint32_t last_used;       // Newest use of any glyph on it, the oldest shelf is evicted when the atlas is full
+} FontShelf;
+
+typedef struct {
+    uint32_t key;             // Glyph pair + 1, 0 marks an empty slot
+    int advance;              // Font units
+} FontKerning;
+
+struct FontAtlas {
+    uint64_t key;             // Hash of the font file
+    uint32_t references;
+    unsigned char *font_data; // Own copy, glyphs are generated on demand
+    stbtt_fontinfo info;
+    float scale;              // Font units to atlas pixels
+
+    GLuint texture;           // GL_R8 distance field
+    unsigned char *pixels;    // CPU copy, for the initial upload and clearing evicted shelves
+    FontShelf shelves[FONT_MAX_SHELVES];
+    int shelf_count;
+    int shelf_bottom;         // First row below the last shelf
+    uint32_t clock;           // Bumped by every measure / draw call
+
+    // Open-addressing hash maps (linear probing), codepoint -> glyph and glyph pair -> kerning
+    FontGlyph *glyphs;
+    uint32_t glyph_capacity, glyph_count;
+    FontKerning *kerning;
+    uint32_t kerning_capacity, kerning_count;
+    bool kerning_complete;    // Every pair came from the kern table, missing pairs are 0 without asking the font
+
+    FontAtlas *next;
+};
+
+// Cache file: this header, then per preloaded glyph a FontCacheGlyph and its width * height distance values
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint64_t checksum;        // Hash of everything after the header
+    uint32_t glyph_count;
+    float pixel_height;
+    uint32_t padding;
+    uint32_t reserved;
+} FontCacheHeader;
+
+typedef struct {
+    uint32_t codepoint;
+    int16_t width, height;
+    int16_t x_offset, y_offset;
+} FontCacheGlyph;
+
+// Loaded atlases, fonts are created, measured, drawn and destroyed on the main thread only
+static FontAtlas *atlases = NULL;
+
+static uint32_t hash_u32(uint32_t value) {
+    value ^= value >> 16;
+    value *= 0x7feb352du;
+    value ^= value >> 15;
+    value *= 0x846ca68bu;
+    value ^= value >> 16;
+    return value;
+}
 
-    float max_height = 0.0f; // Track the maximum height for the text
+// ----------------------------------------------------------------------------
+// Glyph and kerning maps
+// ----------------------------------------------------------------------------
 
-    for (const char *p = text; *p; p++) {
-        Character ch = font->characters[(unsigned char)*p];
+static FontGlyph *glyph_find(const FontAtlas *atlas, uint32_t codepoint) {
+    if (!atlas->glyph_capacity) return NULL;
+    uint32_t mask = atlas->glyph_capacity - 1;
+    for (uint32_t slot = hash_u32(codepoint) & mask;; slot = (slot + 1) & mask) {
+        if (atlas->glyphs[slot].codepoint == codepoint) return &atlas->glyphs[slot];
+        if (atlas->glyphs[slot].codepoint == 0) return NULL;
+    }
+}
 
-        // Skip the space character
-        if (*p == ' ') {
-            *width += font->size / font->scalar; // Adjust space width as needed
-            continue;
+static void glyph_place(FontGlyph *table, uint32_t capacity, const FontGlyph *glyph) {
+    uint32_t mask = capacity - 1;
+    uint32_t slot = hash_u32(glyph->codepoint) & mask;
+    while (table[slot].codepoint != 0) slot = (slot + 1) & mask;
+    table[slot] = *glyph;
+}
+
+// Rebuild at the given capacity, dropping the glyphs of one shelf (-2 keeps everything)
+static bool glyph_rehash(FontAtlas *atlas, uint32_t capacity, int dropped_shelf) {
+    FontGlyph *table = calloc(capacity, sizeof(FontGlyph));
+    if (!table) return false;
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < atlas->glyph_capacity; i++) {
+        const FontGlyph *glyph = &atlas->glyphs[i];
+        if (glyph->codepoint == 0 || (dropped_shelf >= 0 && glyph->shelf == dropped_shelf)) continue;
+        glyph_place(table, capacity, glyph);
+        count++;
+    }
+
+    free(atlas->glyphs);
+    atlas->glyphs = table;
+    atlas->glyph_capacity = capacity;
+    atlas->glyph_count = count;
+    return true;
+}
+
+// The returned pointer is valid until the next insertion
+static FontGlyph *glyph_insert(FontAtlas *atlas, const FontGlyph *glyph) {
+    if ((atlas->glyph_count + 1) * 2 > atlas->glyph_capacity &&
+        !glyph_rehash(atlas, atlas->glyph_capacity ? atlas->glyph_capacity * 2 : 256, -2)) return NULL;
+
+    glyph_place(atlas->glyphs, atlas->glyph_capacity, glyph);
+    atlas->glyph_count++;
+    return glyph_find(atlas, glyph->codepoint);
+}
+
+static void kerning_insert(FontAtlas *atlas, uint32_t key, int advance) {
+    if ((atlas->kerning_count + 1) * 2 > atlas->kerning_capacity) {
+        uint32_t capacity = atlas->kerning_capacity ? atlas->kerning_capacity * 2 : 256;
+        FontKerning *table = calloc(capacity, sizeof(FontKerning));
+        if (!table) return;
+        for (uint32_t i = 0; i < atlas->kerning_capacity; i++) {
+            if (!atlas->kerning[i].key) continue;
+            uint32_t slot = hash_u32(atlas->kerning[i].key) & (capacity - 1);
+            while (table[slot].key) slot = (slot + 1) & (capacity - 1);
+            table[slot] = atlas->kerning[i];
         }
+        free(atlas->kerning);
+        atlas->kerning = table;
+        atlas->kerning_capacity = capacity;
+    }
+
+    uint32_t mask = atlas->kerning_capacity - 1;
+    uint32_t slot = hash_u32(key) & mask;
+    while (atlas->kerning[slot].key && atlas->kerning[slot].key != key) slot = (slot + 1) & mask;
+    if (!atlas->kerning[slot].key) atlas->kerning_count++;
+    atlas->kerning[slot] = (FontKerning){ key, advance };
+}
 
-        // Track the height (max height from any character)
-        if (ch.height > max_height) {
-            max_height = ch.height;
+// Precomputed pairs from the kern table; fonts with GPOS kerning fill the map as pairs are first seen
+static void kerning_load(FontAtlas *atlas) {
+    atlas->kerning_complete = !atlas->info.gpos;
+    int length = stbtt_GetKerningTableLength(&atlas->info);
+    if (length <= 0) return;
+
+    stbtt_kerningentry *table = malloc(sizeof(stbtt_kerningentry) * (size_t)length);
+    if (!table) {
+        atlas->kerning_complete = false;
+        return;
+    }
+    length = stbtt_GetKerningTable(&atlas->info, table, length);
+    for (int i = 0; i < length; i++) {
+        if (table[i].advance == 0 || table[i].glyph1 > 0xFFFF || table[i].glyph2 > 0xFFFF) continue;
+        kerning_insert(atlas, ((uint32_t)table[i].glyph1 << 16 | (uint32_t)table[i].glyph2) + 1, table[i].advance);
+    }
+    free(table);
+}
+
+// Kerning between two glyphs in atlas pixels
+static float kerning_advance(FontAtlas *atlas, int left, int right) {
+    if ((!atlas->info.kern && !atlas->info.gpos) || left <= 0 || right <= 0 || left > 0xFFFF || right > 0xFFFF) return 0.0f;
+
+    uint32_t key = ((uint32_t)left << 16 | (uint32_t)right) + 1;
+    if (atlas->kerning_capacity) {
+        uint32_t mask = atlas->kerning_capacity - 1;
+        for (uint32_t slot = hash_u32(key) & mask; atlas->kerning[slot].key; slot = (slot + 1) & mask) {
+            if (atlas->kerning[slot].key == key) return atlas->kerning[slot].advance * atlas->scale;
         }
+    }
+    if (atlas->kerning_complete) return 0.0f;
+
+    int advance = stbtt_GetGlyphKernAdvance(&atlas->info, left, right);
+    kerning_insert(atlas, key, advance);
+    return advance * atlas->scale;
+}
+
+// ----------------------------------------------------------------------------
+// Atlas packing
+// ----------------------------------------------------------------------------
+
+static void atlas_upload_rect(const FontAtlas *atlas, int x, int y, int width, int height) {
+    if (!atlas->texture) return; // Uploaded whole once the preloaded glyphs are in
 
-        *width += ch.advance; // Add character's advance to the total width
+    glBindTexture(GL_TEXTURE_2D, atlas->texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, FONT_ATLAS_SIZE);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RED, GL_UNSIGNED_BYTE, atlas->pixels + (size_t)y * FONT_ATLAS_SIZE + x);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+// Room for a width x height bitmap (plus a pixel of spacing, so linear filtering never reads a neighbour).
+// Tries the tightest shelf with space, then a new shelf, then empties the least recently used shelf.
+static int atlas_allocate(FontAtlas *atlas, int width, int height, int *x_out, int *y_out) {
+    int needed = height + 1;
+    int best = -1;
+    for (int i = 0; i < atlas->shelf_count; i++) {
+        const FontShelf *shelf = &atlas->shelves[i];
+        if (shelf->height >= needed && shelf->x + width + 1 <= FONT_ATLAS_SIZE &&
+            (best < 0 || shelf->height < atlas->shelves[best].height)) best = i;
     }
 
-    *height = max_height; // Set the maximum height found
+    int rounded = (needed + FONT_SHELF_ROUNDING - 1) / FONT_SHELF_ROUNDING * FONT_SHELF_ROUNDING;
+    if ((best < 0 || atlas->shelves[best].height > rounded * 2) && atlas->shelf_count < FONT_MAX_SHELVES &&
+        atlas->shelf_bottom + rounded <= FONT_ATLAS_SIZE) {
+        best = atlas->shelf_count++;
+        atlas->shelves[best] = (FontShelf){ atlas->shelf_bottom, rounded, 1, 0 };
+        atlas->shelf_bottom += rounded;
+    }
+
+    if (best < 0) {
+        // Full: reuse the shelf whose glyphs were drawn longest ago, never one the current text still needs
+        for (int i = 0; i < atlas->shelf_count; i++) {
+            const FontShelf *shelf = &atlas->shelves[i];
+            if (shelf->height >= needed && width + 2 <= FONT_ATLAS_SIZE && shelf->last_used != atlas->clock &&
+                (best < 0 || shelf->last_used < atlas->shelves[best].last_used)) best = i;
+        }
+        if (best < 0 || !glyph_rehash(atlas, atlas->glyph_capacity, best)) return -1;
+
+        FontShelf *shelf = &atlas->shelves[best];
+        for (int row = 0; row < shelf->height; row++) memset(atlas->pixels + (size_t)(shelf->y + row) * FONT_ATLAS_SIZE, 0, FONT_ATLAS_SIZE);
+        atlas_upload_rect(atlas, 0, shelf->y, FONT_ATLAS_SIZE, shelf->height);
+        shelf->x = 1;
+    }
+
+    FontShelf *shelf = &atlas->shelves[best];
+    *x_out = shelf->x;
+    *y_out = shelf->y;
+    shelf->x += width + 1;
+    return best;
+}
+
+// Put a generated glyph into the atlas and the map, NULL when it did not fit
+static FontGlyph *atlas_store(FontAtlas *atlas, uint32_t codepoint, int glyph_index, const unsigned char *bitmap,
+                              int width, int height, int x_offset, int y_offset) {
+    int advance_width, left_side_bearing;
+    stbtt_GetGlyphHMetrics(&atlas->info, glyph_index, &advance_width, &left_side_bearing);
+
+    FontGlyph glyph = {
+        .codepoint = codepoint,
+        .glyph_index = glyph_index,
+        .advance = advance_width * atlas->scale,
+        .shelf = -1
+    };
+
+    if (bitmap && width > 0 && height > 0) {
+        int x, y;
+        glyph.shelf = atlas_allocate(atlas, width, height, &x, &y);
+        if (glyph.shelf < 0) {
+            fprintf(stderr, "[FONT] Atlas full, cannot fit U+%04X\n", codepoint);
+            return NULL;
+        }
+
+        for (int row = 0; row < height; row++) {
+            memcpy(atlas->pixels + (size_t)(y + row) * FONT_ATLAS_SIZE + x, bitmap + (size_t)row * width, (size_t)width);
+        }
+        atlas_upload_rect(atlas, x, y, width, height);
+
+        glyph.u0 = (float)x / FONT_ATLAS_SIZE;
+        glyph.v0 = (float)y / FONT_ATLAS_SIZE;
+        glyph.u1 = (float)(x + width) / FONT_ATLAS_SIZE;
+        glyph.v1 = (float)(y + height) / FONT_ATLAS_SIZE;
+        glyph.x_offset = (float)x_offset;
+        glyph.y_offset = (float)y_offset;
+        glyph.width = (float)width;
+        glyph.height = (float)height;
+    }
+    return glyph_insert(atlas, &glyph);
+}
+
+static unsigned char *generate_sdf(const FontAtlas *atlas, int glyph_index, int *width, int *height, int *x_offset, int *y_offset) {
+    *width = *height = *x_offset = *y_offset = 0;
+    return stbtt_GetGlyphSDF(&atlas->info, atlas->scale, glyph_index, FONT_SDF_PADDING, FONT_SDF_ON_EDGE,
+                             (float)FONT_SDF_ON_EDGE / FONT_SDF_PADDING, width, height, x_offset, y_offset);
 }
 
-static GLuint create_texture_from_bitmap(const unsigned char *bitmap, int width, int height) {
-    // Create a new array to store the flipped bitmap
-    unsigned char *flipped_bitmap = (unsigned char *)malloc(width * height);
-    if (!flipped_bitmap) {
-        fprintf(stderr, "Failed to allocate memory for flipped bitmap\n");
-        return 0;
+// Glyph of a codepoint, generated on first use. The pointer is valid until the next lookup.
+static FontGlyph *atlas_glyph(FontAtlas *atlas, uint32_t codepoint) {
+    FontGlyph *glyph = glyph_find(atlas, codepoint);
+    if (!glyph) {
+        TRACE_BEGIN("Font glyph generate");
+        int glyph_index = stbtt_FindGlyphIndex(&atlas->info, (int)codepoint); // 0 (.notdef) when the font lacks it
+        int width, height, x_offset, y_offset;
+        unsigned char *bitmap = generate_sdf(atlas, glyph_index, &width, &height, &x_offset, &y_offset);
+        glyph = atlas_store(atlas, codepoint, glyph_index, bitmap, width, height, x_offset, y_offset);
+        stbtt_FreeSDF(bitmap, NULL);
+        TRACE_END();
+        if (!glyph) return NULL;
     }
 
-    // Flip the bitmap vertically
-    for (int y = 0; y < height; ++y) {
-        memcpy(
-            flipped_bitmap + y * width,                // Destination row
-            bitmap + (height - 1 - y) * width,         // Source row (flipped)
-            width                                      // Copy width bytes
-        );
+    if (glyph->shelf >= 0) atlas->shelves[glyph->shelf].last_used = atlas->clock;
+    return glyph;
+}
+
+// ----------------------------------------------------------------------------
+// Preloaded glyphs and the disk cache
+// ----------------------------------------------------------------------------
+
+#define FONT_PRELOAD_COUNT (FONT_PRELOAD_LAST - FONT_PRELOAD_FIRST + 1)
+
+typedef struct {
+    const FontAtlas *atlas;
+    int glyph_indices[FONT_PRELOAD_COUNT];
+    unsigned char *bitmaps[FONT_PRELOAD_COUNT];
+    int widths[FONT_PRELOAD_COUNT], heights[FONT_PRELOAD_COUNT];
+    int x_offsets[FONT_PRELOAD_COUNT], y_offsets[FONT_PRELOAD_COUNT];
+} PreloadJob;
+
+// Distance fields are slow to generate, the preloaded glyphs are spread over the job workers
+static void generate_preload_glyph(void *data, uint32_t index) {
+    PreloadJob *job = (PreloadJob *)data;
+    job->glyph_indices[index] = stbtt_FindGlyphIndex(&job->atlas->info, FONT_PRELOAD_FIRST + (int)index);
+    job->bitmaps[index] = generate_sdf(job->atlas, job->glyph_indices[index], &job->widths[index], &job->heights[index],
+                                       &job->x_offsets[index], &job->y_offsets[index]);
+}
+
+// Insert the glyphs of a cache file, false when there is none or it does not match (a bad entry is deleted)
+static bool preload_from_cache(FontAtlas *atlas, const char *path) {
+    MappedFile file;
+    if (!mapped_file_open(&file, path)) return false;
+
+    const FontCacheHeader *header = (const FontCacheHeader *)file.data;
+    size_t payload = file.size >= sizeof(FontCacheHeader) ? file.size - sizeof(FontCacheHeader) : 0;
+    bool valid = file.size >= sizeof(FontCacheHeader) &&
+                 header->magic == FONT_CACHE_MAGIC &&
+                 header->version == FONT_CACHE_VERSION &&
+                 header->key == atlas->key &&
+                 header->pixel_height == FONT_SDF_PIXEL_HEIGHT &&
+                 header->padding == FONT_SDF_PADDING &&
+                 header->checksum == hash_bytes(file.data + sizeof(FontCacheHeader), payload);
+
+    const unsigned char *p = file.data + sizeof(FontCacheHeader);
+    const unsigned char *end = file.data + file.size;
+    for (uint32_t i = 0; valid && i < header->glyph_count; i++) {
+        FontCacheGlyph record;
+        valid = (size_t)(end - p) >= sizeof(record);
+        if (!valid) break;
+        memcpy(&record, p, sizeof(record));
+        p += sizeof(record);
+
+        size_t size = (size_t)(record.width > 0 ? record.width : 0) * (size_t)(record.height > 0 ? record.height : 0);
+        valid = (size_t)(end - p) >= size &&
+                atlas_store(atlas, record.codepoint, stbtt_FindGlyphIndex(&atlas->info, (int)record.codepoint), size ? p : NULL,
+                            record.width, record.height, record.x_offset, record.y_offset) != NULL;
+        p += size;
+    }
+    mapped_file_close(&file);
+
+    if (!valid) {
+        fprintf(stderr, "[FONT] Discarding stale or corrupt cached glyphs %s\n", path);
+        remove(path);
     }
+    return valid;
+}
+
+static void preload_generate(FontAtlas *atlas, const char *cache_path) {
+    TRACE_BEGIN("Font SDF generate");
+    PreloadJob *job = calloc(1, sizeof(PreloadJob));
+    if (!job) {
+        TRACE_END();
+        return;
+    }
+    job->atlas = atlas;
+    jobs_parallel_for(FONT_PRELOAD_COUNT, generate_preload_glyph, job);
+
+    // Same records as the cache file, written right after
+    size_t payload_size = 0;
+    for (int i = 0; i < FONT_PRELOAD_COUNT; i++) payload_size += sizeof(FontCacheGlyph) + (size_t)job->widths[i] * job->heights[i];
+    unsigned char *payload = malloc(payload_size ? payload_size : 1);
+    unsigned char *p = payload;
+
+    for (int i = 0; i < FONT_PRELOAD_COUNT; i++) {
+        uint32_t codepoint = FONT_PRELOAD_FIRST + (uint32_t)i;
+        atlas_store(atlas, codepoint, job->glyph_indices[i], job->bitmaps[i], job->widths[i], job->heights[i], job->x_offsets[i], job->y_offsets[i]);
+
+        if (payload) {
+            FontCacheGlyph record = { codepoint, (int16_t)job->widths[i], (int16_t)job->heights[i], (int16_t)job->x_offsets[i], (int16_t)job->y_offsets[i] };
+            memcpy(p, &record, sizeof(record));
+            p += sizeof(record);
+            size_t size = (size_t)job->widths[i] * job->heights[i];
+            if (size) memcpy(p, job->bitmaps[i], size);
+            p += size;
+        }
+        stbtt_FreeSDF(job->bitmaps[i], NULL);
+    }
+
+    if (payload) {
+        FontCacheHeader header = {
+            FONT_CACHE_MAGIC, FONT_CACHE_VERSION, atlas->key, hash_bytes(payload, payload_size),
+            FONT_PRELOAD_COUNT, FONT_SDF_PIXEL_HEIGHT, FONT_SDF_PADDING, 0
+        };
+        cache_write(cache_path, &header, sizeof(header), payload, payload_size);
+    }
+    free(payload);
+    free(job);
+    TRACE_END();
+}
 
-    GLuint texture;
-    glGenTextures(1, &texture);
-    glBindTexture(GL_TEXTURE_2D, texture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, flipped_bitmap);
+// ----------------------------------------------------------------------------
+// Shared atlases
+// ----------------------------------------------------------------------------
+
+static void atlas_free(FontAtlas *atlas) {
+    if (atlas->texture) glDeleteTextures(1, &atlas->texture);
+    free(atlas->pixels);
+    free(atlas->glyphs);
+    free(atlas->kerning);
+    free(atlas->font_data);
+    free(atlas);
+}
+
+// Shared atlas for a font file, preloaded from the disk cache or generated
+static FontAtlas *atlas_acquire(const unsigned char *font_buffer, size_t font_buffer_size) {
+    uint64_t key = hash_bytes(font_buffer, font_buffer_size);
+    for (FontAtlas *atlas = atlases; atlas; atlas = atlas->next) {
+        if (atlas->key == key) {
+            atlas->references++;
+            return atlas;
+        }
+    }
+
+    FontAtlas *atlas = calloc(1, sizeof(FontAtlas));
+    if (!atlas) return NULL;
+    atlas->key = key;
+    atlas->font_data = malloc(font_buffer_size);
+    atlas->pixels = calloc(FONT_ATLAS_SIZE, FONT_ATLAS_SIZE);
+    if (!atlas->font_data || !atlas->pixels) {
+        atlas_free(atlas);
+        return NULL;
+    }
+    memcpy(atlas->font_data, font_buffer, font_buffer_size);
+
+    if (!stbtt_InitFont(&atlas->info, atlas->font_data, stbtt_GetFontOffsetForIndex(atlas->font_data, 0))) {
+        fprintf(stderr, "Failed to initialize font.\n");
+        atlas_free(atlas);
+        return NULL;
+    }
+    atlas->scale = stbtt_ScaleForPixelHeight(&atlas->info, FONT_SDF_PIXEL_HEIGHT);
+    kerning_load(atlas);
+
+    char cache_path[256];
+    cache_entry_path("fonts", key, ".sdf", cache_path, sizeof(cache_path));
+    if (!preload_from_cache(atlas, cache_path)) {
+        // A partial preload from a bad file is thrown away with its shelves
+        free(atlas->glyphs);
+        atlas->glyphs = NULL;
+        atlas->glyph_capacity = atlas->glyph_count = 0;
+        atlas->shelf_count = 0;
+        atlas->shelf_bottom = 0;
+        memset(atlas->pixels, 0, (size_t)FONT_ATLAS_SIZE * FONT_ATLAS_SIZE);
+        preload_generate(atlas, cache_path);
+    }
+
+    // One upload for everything preloaded, glyphs added later upload their own rectangle
+    glGenTextures(1, &atlas->texture);
+    glBindTexture(GL_TEXTURE_2D, atlas->texture);
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, FONT_ATLAS_SIZE, FONT_ATLAS_SIZE, 0, GL_RED, GL_UNSIGNED_BYTE, atlas->pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
 
-    // Clean up the temporary flipped bitmap
-    free(flipped_bitmap);
-    return texture;
+    atlas->references = 1;
+    atlas->next = atlases;
+    atlases = atlas;
+    return atlas;
 }
 
-void font_init(Font *font, const char *font_path, float font_size, float space_scalar, GLuint shader_program) {
-    font->size = font_size;
-    font->scalar = space_scalar;
-    font->shader_program = shader_program;
+static void atlas_release(FontAtlas *atlas) {
+    if (!atlas || --atlas->references > 0) return;
 
-    // Load font data
-    FILE *file = fopen(font_path, "rb");
-    if (!file) {
-        fprintf(stderr, "Failed to open font file: %s\n", font_path);
-        return;
+    for (FontAtlas **link = &atlases; *link; link = &(*link)->next) {
+        if (*link == atlas) {
+            *link = atlas->next;
+            break;
+        }
     }
+    atlas_free(atlas);
+}
 
-    fseek(file, 0, SEEK_END);
-    size_t file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
-
-    unsigned char *font_buffer = (unsigned char *)malloc(file_size);
-    fread(font_buffer, 1, file_size, file);
-    fclose(file);
+// Next codepoint of a UTF-8 string, malformed sequences decode to U+FFFD one byte at a time
+static uint32_t utf8_next(const char **text) {
+    const unsigned char *p = (const unsigned char *)*text;
+    uint32_t codepoint;
+    int length;
+
+    if (p[0] < 0x80) { codepoint = p[0]; length = 1; }
+    else if ((p[0] & 0xE0) == 0xC0) { codepoint = p[0] & 0x1F; length = 2; }
+    else if ((p[0] & 0xF0) == 0xE0) { codepoint = p[0] & 0x0F; length = 3; }
+    else if ((p[0] & 0xF8) == 0xF0) { codepoint = p[0] & 0x07; length = 4; }
+    else { *text += 1; return 0xFFFD; }
+
+    for (int i = 1; i < length; i++) {
+        if ((p[i] & 0xC0) != 0x80) { *text += 1; return 0xFFFD; } // Also stops at the terminator
+        codepoint = (codepoint << 6) | (p[i] & 0x3F);
+    }
 
-    stbtt_fontinfo info;
-    if (!stbtt_InitFont(&info, font_buffer, stbtt_GetFontOffsetForIndex(font_buffer, 0))) {
-        fprintf(stderr, "Failed to initialize font.\n");
-        free(font_buffer);
-        return;
+    // Overlong forms, surrogates and values past Unicode
+    static const uint32_t minimum[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+    if (codepoint < minimum[length] || (codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF) {
+        *text += 1;
+        return 0xFFFD;
     }
 
-    // Calculate a single scale factor for the font size
-    float scale = stbtt_ScaleForPixelHeight(&info, font_size);
+    *text += length;
+    return codepoint;
+}
 
-    // Generate textures for each character
-    for (unsigned char c = 0; c < 128; ++c) {
-        int width, height, x_offset, y_offset;
+void font_get_text_dimensions(Font *font, const char *text, float *width, float *height) {
+    *width = 0.0f;
+    *height = 0.0f;
+    if (!font->atlas) return;
 
-        // Skip space as it has a special case
-        if (c == ' ') {
-            continue; // Skip rendering this character
+    FontAtlas *atlas = font->atlas;
+    atlas->clock++;
+    float scale = font->size / FONT_SDF_PIXEL_HEIGHT;
+    float max_height = 0.0f; // Track the maximum height for the text
+    int previous = 0;        // Glyph index before this one, for kerning
+
+    for (const char *p = text; *p;) {
+        uint32_t codepoint = utf8_next(&p);
+
+        // Skip the space character
+        if (codepoint == ' ') {
+            *width += font->size / font->scalar; // Adjust space width as needed
+            previous = 0;
+            continue;
         }
 
-        // Only generate texture if it hasn't been done already
-        if (font->characters[c].texture_id == 0) {
-            unsigned char *bitmap = stbtt_GetCodepointBitmap(&info, 0, scale, c, &width, &height, &x_offset, &y_offset);
-            
-            if (bitmap) { // Check if bitmap was created successfully
-                font->characters[c].texture_id = create_texture_from_bitmap(bitmap, width, height);
-                font->characters[c].width = width;
-                font->characters[c].height = height;
-                font->characters[c].x_offset = x_offset;
-                font->characters[c].y_offset = y_offset;
-
-                int advanceWidth, leftSideBearing;
-                stbtt_GetCodepointHMetrics(&info, c, &advanceWidth, &leftSideBearing);
-                float scaledAdvance = advanceWidth * scale;
-                font->characters[c].advance = scaledAdvance;
-
-                stbtt_FreeBitmap(bitmap, NULL); // Free bitmap data after texture creation
-            } else {
-                font->characters[c].texture_id = 0; // Set to 0 to indicate an invalid texture
-            }
+        const FontGlyph *glyph = atlas_glyph(atlas, codepoint);
+        if (!glyph) continue;
+
+        // Track the height (max height from any character, without the distance field padding)
+        float glyph_height = glyph->height > 0.0f ? (glyph->height - 2.0f * FONT_SDF_PADDING) * scale : 0.0f;
+        if (glyph_height > max_height) {
+            max_height = glyph_height;
         }
+
+        *width += (kerning_advance(atlas, previous, glyph->glyph_index) + glyph->advance) * scale; // Add character's advance to the total width
+        previous = glyph->glyph_index;
     }
 
-    free(font_buffer);
+    *height = max_height; // Set the maximum height found
+}
+
+void font_init(Font *font, const char *font_path, float font_size, float space_scalar, GLuint shader_program) {
+    // Load font data, the glyphs are baked from the view directly
+    VfsFile file;
+    if (!vfs_open(&file, font_path)) {
+        fprintf(stderr, "Failed to open font file: %s\n", font_path);
+        memset(font, 0, sizeof(Font));
+        return;
+    }
+
+    font_init_from_memory(font, file.data, file.size, font_size, space_scalar, shader_program);
+    vfs_close(&file);
+}
+
+void font_init_from_memory(Font *font, const unsigned char *font_buffer, size_t font_buffer_size, float font_size, float space_scalar, GLuint shader_program) {
+    memset(font, 0, sizeof(Font));
+    font->size = font_size;
+    font->scalar = space_scalar;
+    font->shader_program = shader_program;
+
+    // Every size of the same font file shares one atlas
+    font->atlas = atlas_acquire(font_buffer, font_buffer_size);
+    if (!font->atlas) return;
 
-    // Set up VAO/VBO for rendering quads (not triangles)
+    // Set up VAO/VBO for rendering quads, the buffer grows with the longest string drawn
     glGenVertexArrays(1, &font->VAO);
     glGenBuffers(1, &font->VBO);
     glBindVertexArray(font->VAO);
     glBindBuffer(GL_ARRAY_BUFFER, font->VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 4 * 4, NULL, GL_DYNAMIC_DRAW); // 4 vertices per quad
+    font->vertex_capacity = 6 * 32;
+    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 4 * font->vertex_capacity, NULL, GL_DYNAMIC_DRAW);
 
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
@@ -143,76 +618,89 @@ void font_init(Font *font, const char *font_path, float font_size, float space_s
 }
 
 void font_render_text(Font *font, const char *text, float x, float y, vec3 color) {
-    glUseProgram(font->shader_program);
-    glUniform3fv(glGetUniformLocation(font->shader_program, "textColor"), 1, color);
-    glBindVertexArray(font->VAO);
-
-    // Track previous position for comparison to detect changes in rendering
-    float prevX = x;
-    float prevY = y;
-
-    for (const char *p = text; *p; p++) {
-        unsigned char c = (unsigned char)*p;
-        Character ch = font->characters[c];
+    if (!font->atlas) return;
+
+    // Two triangles per visible glyph, all drawn with one call
+    size_t length = strlen(text);
+    float (*vertices)[4] = malloc(sizeof(float) * 4 * 6 * (length ? length : 1));
+    if (!vertices) return;
+
+    // Glyphs missing from the atlas are generated here, a full atlas evicts shelves this text does not use
+    FontAtlas *atlas = font->atlas;
+    atlas->clock++;
+    float scale = font->size / FONT_SDF_PIXEL_HEIGHT;
+    size_t vertex_count = 0;
+    int previous = 0;
+    for (const char *p = text; *p;) {
+        uint32_t codepoint = utf8_next(&p);
 
         // Skip space
-        if (*p == ' ') {
+        if (codepoint == ' ') {
             x += font->size / font->scalar;
+            previous = 0;
             continue; // Skip rendering this character
         }
 
-        // Adjust Y position for descenders like 'y', 'g', etc.
-        float ypos = y + font->size + ch.y_offset;
-
-        // Adjust X position based on character width
-        float xpos = x + ch.x_offset;
-
-        float w = ch.width;
-        float h = ch.height;
+        const FontGlyph *glyph = atlas_glyph(atlas, codepoint);
+        if (!glyph) continue;
+
+        x += kerning_advance(atlas, previous, glyph->glyph_index) * scale;
+        previous = glyph->glyph_index;
+        if (glyph->width > 0.0f) {
+            // Adjust Y position for descenders like 'y', 'g', etc.
+            float ypos = y + font->size + glyph->y_offset * scale;
+            float xpos = x + glyph->x_offset * scale;
+            float w = glyph->width * scale;
+            float h = glyph->height * scale;
+
+            float quad[6][4] = {
+                { xpos,     ypos + h, glyph->u0, glyph->v1 },
+                { xpos,     ypos,     glyph->u0, glyph->v0 },
+                { xpos + w, ypos,     glyph->u1, glyph->v0 },
+                { xpos,     ypos + h, glyph->u0, glyph->v1 },
+                { xpos + w, ypos,     glyph->u1, glyph->v0 },
+                { xpos + w, ypos + h, glyph->u1, glyph->v1 }
+            };
+            memcpy(vertices[vertex_count], quad, sizeof(quad));
+            vertex_count += 6;
+        }
 
-        // Check if position or character has changed since the last rendering
-        bool positionChanged = (prevX != xpos) || (prevY != ypos) || (w != ch.width) || (h != ch.height);
+        // Advance the x position for the next character
+        x += glyph->advance * scale;
+    }
 
-        if (positionChanged) {
-            // Update vertices only if position or size has changed
-            float vertices[4][4] = {
-                { xpos,     ypos + h,   0.0f, 0.0f },
-                { xpos,     ypos,       0.0f, 1.0f },
-                { xpos + w, ypos + h,   1.0f, 0.0f },
-                { xpos + w, ypos,       1.0f, 1.0f }
-            };
+    if (vertex_count > 0) {
+        glUseProgram(font->shader_program);
+        glUniform3fv(glGetUniformLocation(font->shader_program, "textColor"), 1, color);
+        glBindVertexArray(font->VAO);
+        glBindTexture(GL_TEXTURE_2D, font->atlas->texture);
+        glBindBuffer(GL_ARRAY_BUFFER, font->VBO);
 
-            glBindTexture(GL_TEXTURE_2D, ch.texture_id);
-            glBindBuffer(GL_ARRAY_BUFFER, font->VBO);
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+        if (vertex_count > font->vertex_capacity) {
+            while (font->vertex_capacity < vertex_count) font->vertex_capacity *= 2;
+            glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 4 * font->vertex_capacity, NULL, GL_DYNAMIC_DRAW);
         }
+        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float) * 4 * vertex_count, vertices);
 
-        glDisable(GL_CULL_FACE); // Disable depth test while rendering 2D text
-        glDisable(GL_DEPTH_TEST); // Disable face culling while rendering 2D text
+        glDisable(GL_CULL_FACE); // Disable face culling while rendering 2D text
+        glDisable(GL_DEPTH_TEST); // Disable depth test while rendering 2D text
         glPolygonMode(GL_FRONT_AND_BACK, GL_FILL); // Render in solid mode
 
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4); // Use triangle strip (faster than 2 triangles)
+        glDrawArrays(GL_TRIANGLES, 0, (GLsizei)vertex_count);
 
         glEnable(GL_DEPTH_TEST); // Re-enable depth test after rendering
 
         if (wireframeMode) glPolygonMode(GL_FRONT_AND_BACK, GL_LINE); // Re-enable wireframe mode
         if (!cullingMode) glEnable(GL_CULL_FACE); // Re-enable face culling after rendering
 
-        // Update position for the next character
-        prevX = xpos + w;
-        prevY = ypos;
-
-        // Advance the x position for the next character
-        x += ch.advance;
+        glBindTexture(GL_TEXTURE_2D, 0);
     }
-
-    glBindTexture(GL_TEXTURE_2D, 0);
+    free(vertices);
 }
 
 void font_cleanup(Font *font) {
-    for (unsigned char c = 0; c < 128; ++c) {
-        glDeleteTextures(1, &font->characters[c].texture_id);
-    }
-    glDeleteVertexArrays(1, &font->VAO);
-    glDeleteBuffers(1, &font->VBO);
+    atlas_release(font->atlas);
+    if (font->VAO) glDeleteVertexArrays(1, &font->VAO);
+    if (font->VBO) glDeleteBuffers(1, &font->VBO);
+    memset(font, 0, sizeof(Font));
 }
@@ -21,7 +21,7 @@ void button_init(Button *button, const char *text, float x, float y, float width
     glm_vec3_copy(text_color, button->text_color);
 
     button->text = text;
-    button->font = *font;
+    button->font = font;
 
     // Calculate text position for alignment
     float text_width, text_height;
@@ -165,7 +165,7 @@ void button_render(Button *button, float x, float y, int framebufferWidth, int f
     if (!cullingMode) glEnable(GL_CULL_FACE); // Re-enable face culling after rendering
 
     // Render the text (for the button's label)
-    font_render_text(&button->font, button->text, button->text_offset_x + (x/2), button->text_offset_y + y, button->text_color);
+    font_render_text(button->font, button->text, button->text_offset_x + (x/2), button->text_offset_y + y, button->text_color);
 
     buffers_unbind_vao();
     buffers_unbind_vbo();
@@ -182,9 +182,6 @@ void button_cleanup(Button *button) {
 
     // Clean up buffers using buffers.h
     buffers_destroy(&button->buffers);
-
-    // Clean up font
-    font_cleanup(&button->font);
 }
 
 bool button_check_hover(Button *button, float mouse_x, float mouse_y) {
@@ -227,7 +224,7 @@ void button_scale(Button *button, float scale_x, float scale_y) {
 
     // Scale the text accordingly
     float text_width, text_height;
-    font_get_text_dimensions(&button->font, button->text, &text_width, &text_height);
+    font_get_text_dimensions(button->font, button->text, &text_width, &text_height);
 
     text_width *= scale_x;
     text_height *= scale_y;
@@ -28,6 +28,7 @@
 #include <entities/mesh.h>
 #include <entities/model.h>
 #include <entities/ecs.h>
+#include <entities/transform.h>
 
 #include <lighting/light.h>
 #include <entities/static/cube.h>
@@ -35,7 +36,12 @@
 #include <scenes/skybox.h>
 
 #include <output/sound.h>
-#include <wav.h>
+#include <output/audio.h>
+#include <output/voices.h>
+#include <output/stream.h>
+#include <loaders/assets.h>
+#include <pipeline/resources.h>
+#include <jobs/trace.h>
 
 static ShaderProgram shader, image_shader, text_shader, button_shader, skybox_shader;
 static Buffers buffers;
@@ -51,7 +57,7 @@ static vec4 crosshairColor = {1.0f, 1.0f, 1.0f, 0.2f}; // White color
 static float crosshairSize = 4.0f; // Adjust crosshair size as needed
 static float crosshairThickness = 6.0f; // Adjust crosshair size as needed
 
-static Font font;
+static Font* font = NULL;
 static vec3 color = { 1.0f, 1.0f, 1.0f };
 static float font_size = 18.0f;
 
@@ -63,13 +69,20 @@ static float fps = 0.0f;
 // Declare an image
 static Image background_image;
 
+static TransformSystem transforms; // Scene transform hierarchy
+
 static Model model; // A struct to hold GLTF model data
 static Drawable drawable;
 
 static Model player_model;
 static Drawable p_drawable;
 
-static Sound sound;
+static SoundClip crystal_clip = -1;
+
+// Player health text, reformatted only when the state value changes
+static StateSlot health_slot = -1;
+static uint32_t health_version = 0;
+static char health_text[32];
 static Button my_button;
 
 static Cube DebugLightCube;
@@ -81,111 +94,110 @@ static Skybox skybox;
 static mat4 skybox_view, skybox_projection, skybox_model;
 // ^ <<<<<<<<<<<<<< Skybox 
 
+// & Asset callbacks (main thread, in request order, while the splash screen is up)
+static void on_shader_loaded(Asset* asset, void* user) {
+	if (asset->status != ASSET_READY) {
+		fprintf(stderr, "Shader program creation failed: %s\n", asset->paths[0]);
+		return;
+	}
+	*(ShaderProgram*)user = asset->shader;
+	printf("Shader program created: %s\n", asset->paths[0]);
+}
+
 // & Default scene shaders
 static void setup_default_scene_shaders() {
-	// ! Default Shader
-	// Compile shaders and create shader program
-    char* vertexShaderSource = read_file("resources/shaders/vertex.glsl");
-    char* fragmentShaderSource = read_file("resources/shaders/fragment.glsl");
-    if (!vertexShaderSource || !fragmentShaderSource) {
-        fprintf(stderr, "Failed to load shader sources!\n");
-        return;
-    }
+	// Sources are read on the workers, compiled on the main thread in request order
+	assets_load_shader("resources/shaders/vertex.glsl", "resources/shaders/fragment.glsl", on_shader_loaded, &shader);
+	assets_load_shader("resources/shaders/text/vertex.glsl", "resources/shaders/text/fragment.glsl", on_shader_loaded, &text_shader);
+	assets_load_shader("resources/shaders/image/vertex.glsl", "resources/shaders/image/fragment.glsl", on_shader_loaded, &image_shader);
+	assets_load_shader("resources/shaders/button/vertex.glsl", "resources/shaders/button/fragment.glsl", on_shader_loaded, &button_shader);
+	assets_load_shader("resources/shaders/skybox/vertex.glsl", "resources/shaders/skybox/fragment.glsl", on_shader_loaded, &skybox_shader);
+	assets_load_shader("resources/shaders/debug/vertex.glsl", "resources/shaders/debug/fragment.glsl", on_shader_loaded, &DebugLightCube.shader_program);
+}
 
-    shader = shader_create(vertexShaderSource, fragmentShaderSource);
-    free(vertexShaderSource);
-    free(fragmentShaderSource);
+static void on_scene_model_loaded(Asset* asset, void* user) {
+	(void)user;
+	if (asset->status != ASSET_READY) {
+		fprintf(stderr, "Failed to load Agirl GLTF model!\n");
+		return;
+	}
+	printf("[GLTF] Loaded anime_girl_texture/agirl.gltf model.\n");
 
-    if (shader.id == 0) {
-        fprintf(stderr, "Shader program creation failed!\n");
-        return;
-    }
-    printf("Main shader program created.\n");
+	model_set_scale(&model, (vec3){ 0.5f, 0.5f, 0.5f });
+	model_set_rotation(&model, (vec4){ -90.0f, 0.0f, 0.0f, 1.0f });
+	model_apply_transform(&model);
+	model_attach_transforms(&model, &transforms, TRANSFORM_NONE);
 
-	// & >>>>>>>>>>>>>>>>>>>>>>>>>>>>
+	// Initialize the meshes as drawables
+    for (uint32_t i = 0; i < model.mesh_count; i++)
+        draw_manager_init_from_mesh(&drawable, model.meshes[i], model.meshes[i]->name);
+}
 
-	// ! Text Shader
-	// Initialize text renderer
-	// Compile shaders and create shader program
-    char* t_vertexShaderSource = read_file("resources/shaders/text/vertex.glsl");
-    char* t_fragmentShaderSource = read_file("resources/shaders/text/fragment.glsl");
-    if (!t_vertexShaderSource || !t_fragmentShaderSource) {
-        fprintf(stderr, "Failed to load text shader sources!\n");
-        return;
-    }
+static void on_player_model_loaded(Asset* asset, void* user) {
+	(void)user;
+	if (asset->status != ASSET_READY) {
+		fprintf(stderr, "Failed to load Cylinder GLTF model!\n");
+		return;
+	}
+	printf("[GLTF] Loaded static/cylinder.glb model.\n");
 
-	text_shader = shader_create(t_vertexShaderSource, t_fragmentShaderSource);
-    free(t_vertexShaderSource);
-    free(t_fragmentShaderSource);
+	model_set_scale(&player_model, (vec3){ 0.3f, 0.3f, 0.3f });
+	model_set_rotation(&player_model, (vec4){ -90.0f, 0.0f, 0.0f, 1.0f });
+	model_apply_transform(&player_model);
+	model_attach_transforms(&player_model, &transforms, TRANSFORM_NONE);
 
-    if (text_shader.id == 0) {
-        fprintf(stderr, "Shader program creation failed!\n");
-        return;
-    }
-    printf("Text shader program created.\n");
-	
-	// & >>>>>>>>>>>>>>>>>>>>>>>>>>>>
+	// * Initialize the meshes as drawables
+    for (uint32_t i = 0; i < player_model.mesh_count; i++)
+        draw_manager_init_from_mesh(&p_drawable, player_model.meshes[i], player_model.meshes[i]->name);
+}
 
-	// ! Image Shader
-	// Initialize image renderer
-	// Compile shaders and create shader program
-    char* i_vertexShaderSource = read_file("resources/shaders/image/vertex.glsl");
-    char* i_fragmentShaderSource = read_file("resources/shaders/image/fragment.glsl");
-    if (!i_vertexShaderSource || !i_fragmentShaderSource) {
-        fprintf(stderr, "Failed to load image shader sources!\n");
-        return;
-    }
+static void on_background_loaded(Asset* asset, void* user) {
+	(void)user;
+	if (asset->status != ASSET_READY) return;
 
-	image_shader = shader_create(i_vertexShaderSource, i_fragmentShaderSource);
-    free(i_vertexShaderSource);
-    free(i_fragmentShaderSource);
+	// * Initialize Image
+	image_init_from_texture(&background_image, asset->texture_id, asset->width, asset->height, image_shader.id);
+	image_set_dimensions(&background_image, 1024, 1024);
+	printf("Initialized background_image\n");
+}
 
-    if (image_shader.id == 0) {
-        fprintf(stderr, "Shader program creation failed!\n");
-        return;
-    }
-    printf("Image shader program created.\n");
-	
-	// & >>>>>>>>>>>>>>>>>>>>>>>>>>>>
+static void on_sound_loaded(Asset* asset, void* user) {
+	(void)user;
+	if (asset->status != ASSET_READY) return;
+	crystal_clip = asset->clip;
 
-	// ! Button Shader
-	// Initialize button renderer
-	// Compile shaders and create shader program
-    char* b_vertexShaderSource = read_file("resources/shaders/button/vertex.glsl");
-    char* b_fragmentShaderSource = read_file("resources/shaders/button/fragment.glsl");
-    if (!b_vertexShaderSource || !b_fragmentShaderSource) {
-        fprintf(stderr, "Failed to load image shader sources!\n");
-        return;
-    }
+	// * Played once at the origin, muted for now
+	SoundParams params = SOUND_PARAMS_DEFAULT;
+	params.volume = 0.0f;
+	params.positional = true;
+	sound_trigger(crystal_clip, &params);
+}
 
-	button_shader = shader_create(b_vertexShaderSource, b_fragmentShaderSource);
-    free(b_vertexShaderSource);
-    free(b_fragmentShaderSource);
+static void on_skybox_loaded(Asset* asset, void* user) {
+	(void)user;
+	if (asset->status != ASSET_READY) return;
+	skybox_init_from_texture(&skybox, asset->texture_id, skybox_shader.id);
+}
 
-    if (button_shader.id == 0) {
-        fprintf(stderr, "Shader program creation failed!\n");
-        return;
-    }
-    printf("Button shader program created.\n");
-	
-	// & >>>>>>>>>>>>>>>>>>>>>>>>>>>>
+// Everything queued before this has been finalized: wire up what depends on several assets
+static void on_scene_assets_loaded(Asset* asset, void* user) {
+	(void)asset;
+	(void)user;
+	// * VCR_OSD_MONO Font, shares its glyph atlas with the splash screen's
+	font = resources_font_acquire("resources/vcr_osd_mono.ttf", font_size, 3.0f, text_shader.id);
 
-	// ! Skybox Shader
-	// Initialize skybox renderer
-	// Compile shaders and create shader program
-    char* sk_vertexShaderSource = read_file("resources/shaders/skybox/vertex.glsl");
-    char* sk_fragmentShaderSource = read_file("resources/shaders/skybox/fragment.glsl");
-    if (!sk_vertexShaderSource || !sk_fragmentShaderSource) {
-        fprintf(stderr, "Failed to load image shader sources!\n");
-        return;
-    }
+	// * Initialize Button
+	button_init(
+		&my_button, "Hover me", 
+		100.0f, 100.0f, 200.0f, 60.0f, 
+		button_shader.id, BUTTON_TYPE_COLOR, 0, 
+		(vec4){0.2f, 0.0f, 0.0f, 1.0f}, 
+		font, (vec3){1.0f, 1.0f, 1.0f}
+	);
 
-	skybox_shader = shader_create(sk_vertexShaderSource, sk_fragmentShaderSource);
-    free(sk_vertexShaderSource);
-    free(sk_fragmentShaderSource);
-    printf("Skybox shader program created.\n");
-	
-	// & >>>>>>>>>>>>>>>>>>>>>>>>>>>>
+	// ! Light
+	create_light(&PointLight, shader.id);
+	printf("Default scene assets loaded.\n");
 }
 
 // Function to print a 4x4 matrix for debugging
@@ -285,33 +297,33 @@ void default_scene_update(Scene* self) {
 	GLuint camera_position = glGetUniformLocation(shader.id, "cameraPosition");
     glUniform3fv(camera_position, 1, camera.position);
 
-	// For each mesh in the model, apply the mesh's local transformation
-	for (int i = 0; i < model.mesh_count; i++) {
-		// Combine the mesh's local transformation with the model's global transformation
-		// ! vvvv enable if apply transform to parent is set to "true" vvvv
-		mat4 combined_transform;
-		glm_mat4_mul(model.transform_matrix, model.meshes[i]->transform_matrix, combined_transform);
-		// ! ^^^^ enable if apply transform to parent is set to "true" ^^^^
-
-		// Pass the combined transformation matrix to the shader
-		glUniformMatrix4fv(model_loc, 1, GL_FALSE, (const GLfloat*)combined_transform);  // Use combined_transform here
-		// ! ^^^^ change this to "combined_transform" if apply transform to parent is set to "true" ^^^^
-		material_apply(model.meshes[i]->material, shader.id);
-
-		// Draw the mesh with the combined transformation
-		draw_manager_draw(&drawable, model.meshes[i]->name);
-	}
-
 	// Set the scale for the player model
 	model_set_position(&player_model, (vec3){camera.position[0], camera.position[1] - 2.0f, camera.position[2]}); // Use camera position for the player's position
 	model_set_rotation(&player_model, (vec4){ 0.0f, 0.0f, 0.0f, 1.0f });
 
 	model_apply_transform(&player_model);
 
+	// Rebuild the world matrices of whatever moved (static meshes are skipped)
+	transform_system_update(&transforms);
+
+	// For each mesh in the model, use its world matrix (model transform * mesh transform)
+	uint32_t bound_material = 0; // Meshes sharing a material only bind it once
+	for (uint32_t i = 0; i < model.mesh_count; i++) {
+		glUniformMatrix4fv(model_loc, 1, GL_FALSE, (const GLfloat*)transform_world(&transforms, model.meshes[i]->transform));
+		const Material* material = model.meshes[i]->material;
+		if (material && material->id != bound_material) {
+			material_apply(material, shader.id);
+			bound_material = material->id;
+		}
+
+		// Draw the mesh with its world transformation
+		draw_manager_draw(&drawable, model.meshes[i]->name);
+	}
+
 	// Draw each mesh with the updated transformation
-	for (int i = 0; i < player_model.mesh_count; i++) {
-		// Pass the combined transformation matrix to the shader
-		glUniformMatrix4fv(model_loc, 1, GL_FALSE, (const GLfloat*)player_model.transform_matrix);  // Use combined_transform here
+	for (uint32_t i = 0; i < player_model.mesh_count; i++) {
+		// Player meshes only follow the model root
+		glUniformMatrix4fv(model_loc, 1, GL_FALSE, (const GLfloat*)transform_world(&transforms, player_model.transform));
 
 		// Draw the mesh with the combined transformation
 		draw_manager_draw(&p_drawable, player_model.meshes[i]->name);
@@ -356,7 +368,7 @@ void default_scene_update(Scene* self) {
 	bool hover = button_check_hover(&my_button, cursor_x_position, cursor_y_position);
 	// bool click = button_check_click(&my_button, cursor_x_position, cursor_y_position, glfwGetMouseButton(self->window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS);
 
-	sound_play_once_rtwp(&sound, (vec3){0.0f, 0.0f, 0.0f}, camera.position, camera.front, camera.worldUp);
+	audio_update(camera.position, camera.front, camera.worldUp);
 
 	if (hover) {
 		button_scale(&my_button, 1.1f, 1.1f);
@@ -373,23 +385,24 @@ void default_scene_update(Scene* self) {
 	setup_ortho_projection(framebufferWidth, framebufferHeight, text_projection);
 	
 	// Set projection matrix in shader
-	GLuint proj_loc = glGetUniformLocation(font.shader_program, "projection");
+	GLuint proj_loc = glGetUniformLocation(font->shader_program, "projection");
 	glUniformMatrix4fv(proj_loc, 1, GL_FALSE, (const GLfloat*)text_projection);
 
 	// Render info text
-	font_render_text(&font, "lwlaim beta v0.0", 4.0f, 0.0f, color);
-	font_render_text(&font, "lightweight aim training", 4.0f, (font_size + 2.0f), color);
+	font_render_text(font, "lwlaim beta v0.0", 4.0f, 0.0f, color);
+	font_render_text(font, "lightweight aim training", 4.0f, (font_size + 2.0f), color);
 	// Render FPS text
 	char fpsText[32];
 	snprintf(fpsText, sizeof(fpsText), "frames per second: %.0f", fps);
-	font_render_text(&font, fpsText, 4.0f, ((font_size * 2.0f) + 2.0f), color); // Display at top-left
+	font_render_text(font, fpsText, 4.0f, ((font_size * 2.0f) + 2.0f), color); // Display at top-left
 
 	// Render Player Health
-	char health[32]; // Declare the array
-	const char *player_health = scene_state_get(&self->state, "player_health");
-	// Copy the string into the array
-	snprintf(health, sizeof(health), "Player health: %.0f", atof(player_health)); // Assume it returns a numeric value as string
-	font_render_text(&font, health, 4.0f, ((font_size * 3.0f) + 2.0f), color); // Display at top-left
+	uint32_t version = scene_state_version(&self->state, health_slot);
+	if (version != health_version) {
+		snprintf(health_text, sizeof(health_text), "Player health: %.0f", scene_state_get_float(&self->state, health_slot));
+		health_version = version;
+	}
+	font_render_text(font, health_text, 4.0f, ((font_size * 3.0f) + 2.0f), color); // Display at top-left
 
 	// Render crosshair
 	crosshair_render(&crosshair, framebufferWidth, framebufferHeight);
@@ -400,100 +413,43 @@ void default_scene_update(Scene* self) {
 }
 
 void default_scene_render(Scene* self) {
+	TRACE_BEGIN("Default scene setup");
+
 	// * Setup the shaders of the scene
 	setup_default_scene_shaders();
 
-	// ! Test Multi-mesh Model
-    if (!model_load_gltf(
-		&model, 
-		"resources/static/copyrighted/anime_girl_texture/agirl.gltf",
-		true)
-	) {
-        fprintf(stderr, "Failed to load Agirl GLTF model!\n");
-        return;
-    }
-    printf("[GLTF] Loaded anime_girl_texture/agirl.gltf model.\n");
+	// * Scene state slots, resolved once here
+	health_slot = scene_state_register(&self->state, "player_health", STATE_FLOAT);
 
-	model_set_scale(&model, (vec3){ 0.5f, 0.5f, 0.5f });
-	model_set_rotation(&model, (vec4){ -90.0f, 0.0f, 0.0f, 1.0f });
-	model_apply_transform(&model);
+	// * Scene transform hierarchy
+	transform_system_init(&transforms, 128);
 
-	// Initialize the meshes as drawables
-    for (int i = 0; i < model.mesh_count; i++)
-        draw_manager_init_from_mesh(&drawable, model.meshes[i], model.meshes[i]->name);
+	// ! Test Multi-mesh Model
+	assets_load_model(&model, "resources/static/copyrighted/anime_girl_texture/agirl.gltf", true, on_scene_model_loaded, NULL);
 
 	// ! Player Character Model
-    if (!model_load_gltf(
-		&player_model, 
-		"resources/static/cylinder.glb",
-		false)
-	) {
-        fprintf(stderr, "Failed to load Cylinder GLTF model!\n");
-        return;
-    }
-    printf("[GLTF] Loaded static/cylinder.glb model.\n");
-
-	model_set_scale(&player_model, (vec3){ 0.3f, 0.3f, 0.3f });
-	model_set_rotation(&player_model, (vec4){ -90.0f, 0.0f, 0.0f, 1.0f });
-	model_apply_transform(&player_model);
-
-	// * Initialize the meshes as drawables
-    for (int i = 0; i < player_model.mesh_count; i++)
-        draw_manager_init_from_mesh(&p_drawable, player_model.meshes[i], player_model.meshes[i]->name);
-
-	// * Make stbi flip the image vertically
-	stbi_set_flip_vertically_on_load(1);
+	assets_load_model(&player_model, "resources/static/cylinder.glb", false, on_player_model_loaded, NULL);
 
 	// * Initialize Main Scene Camera
 	camera_init(&camera, (vec3){0.0f, 0.0f, 3.0f}, (vec3){0.0f, 1.0f, 0.0f}, -90.0f, 0.0f);
     printf("Camera initialized.\n");
 
 	// * Initialize the Crosshair
+	TRACE_BEGIN("Crosshair init");
 	crosshair_init(&crosshair, crosshairSize, crosshairThickness, crosshairColor);
+	TRACE_END();
 
-	// * Initialize VCR_OSD_MONO Font
-    font_init(&font, "resources/vcr_osd_mono.ttf", font_size, 3.0f, text_shader.id);  // Adjust path and size as needed
-
-	// * Initialize Image
-	image_init(&background_image, "resources/prototype/image.png", image_shader.id);
-	image_set_dimensions(&background_image, 1024, 1024);
-	printf("Initialized background_image\n");
-
-	// * Initialize Button
-	button_init(
-		&my_button, "Hover me", 
-		100.0f, 100.0f, 200.0f, 60.0f, 
-		button_shader.id, BUTTON_TYPE_COLOR, 0, 
-		(vec4){0.2f, 0.0f, 0.0f, 1.0f}, 
-		&font, (vec3){1.0f, 1.0f, 1.0f}
-	);
+	// * Image (flipped vertically)
+	assets_load_image("resources/prototype/image.png", true, on_background_loaded, NULL);
 
 	// * Initialize Sound System;
+	TRACE_BEGIN("OpenAL init");
 	sound_initialize();
-	alGenBuffers(1, &sound.buffer);
-	alGenSources(1, &sound.source);
-
-	ALsizei size, freq;
-	ALenum format;
-	ALvoid* data;
-	load_wav("resources/audio/copyrighted/crystal.wav", &format, &data, &size, &freq); // Implement your loader
-	alBufferData(sound.buffer, format, data, size, freq);
-	free(data);
-
-	// Attach the buffer to the source
-	sound_attach_buffer(&sound);
-
-	// * Initialize sound properties
-	sound_set_volume(&sound, 0.0f);
-
-	// ! Debug light cube
-	// * Create the cube shaders
-	create_debug_cube_shaders(
-		&DebugLightCube, 
-		"resources/shaders/debug/vertex.glsl", 
-		"resources/shaders/debug/fragment.glsl"
-	);
+	TRACE_END();
 
+	assets_load_sound("crystal", "resources/audio/copyrighted/crystal.wav", on_sound_loaded, NULL);
+
+	// ! Debug light cube (its shaders are queued with the others)
 	vec3 c_size = {0.3f, 0.3f, 0.3f};
 
 	glm_vec3_copy((vec3){ 0.0f, 12.0f, 6.0f }, LightPosition);
@@ -501,9 +457,6 @@ void default_scene_render(Scene* self) {
 
 	create_debug_cube(&DebugLightCube, c_size, LightPosition, c_color);
 
-	// ! Light
-	create_light(&PointLight, shader.id);
-
 	// ! Skybox
 	const char* faces[6] = {
 		"resources/static/cubemap/px.png", // Positive X
@@ -513,10 +466,12 @@ void default_scene_render(Scene* self) {
 		"resources/static/cubemap/pz.png", // Positive Z
 		"resources/static/cubemap/nz.png"  // Negative Z
 	};
+	assets_load_cubemap(faces, on_skybox_loaded, NULL);
+
+	// * Button and light need the font and shaders, run once everything above is in
+	assets_after(on_scene_assets_loaded, NULL);
 
-	// * Stop stbi from flipping the image vertically
-	stbi_set_flip_vertically_on_load(0);
-	skybox_init(&skybox, faces, skybox_shader.id);
+	TRACE_END();
 }
 
 void default_scene_cleanup() {
@@ -524,15 +479,18 @@ void default_scene_cleanup() {
 
 	// & >>>>>>>>>>>>>>>>>>>>>>>>>>>>
 
-	// * Destroy sound objects
+	// * Destroy sound objects (the bank goes with the pool)
 	sound_cleanup();
+	crystal_clip = -1;
+	health_version = 0;
 
 	// & >>>>>>>>>>>>>>>>>>>>>>>>>>>>
 
 	// * Destroy UI Components
 	button_cleanup(&my_button);
 	image_cleanup(&background_image);
-	font_cleanup(&font);
+	resources_font_release(font);
+	font = NULL;
 	crosshair_destroy(&crosshair);
 
 	// & >>>>>>>>>>>>>>>>>>>>>>>>>>>>
@@ -544,6 +502,8 @@ void default_scene_cleanup() {
 	draw_manager_destroy(&drawable);
 	draw_manager_destroy(&p_drawable);
 
+	transform_system_free(&transforms);
+
 	// & >>>>>>>>>>>>>>>>>>>>>>>>>>>>
 
 	// * Destroy Skybox
@@ -551,13 +511,14 @@ void default_scene_cleanup() {
 
 	// & >>>>>>>>>>>>>>>>>>>>>>>>>>>>
 
-	// * Destroy Shaders
-    shader_destroy(&shader);
+	// * Release Shaders (shared, destroyed with their last user)
+    resources_program_release(&shader);
 	
-    shader_destroy(&image_shader);
-    shader_destroy(&text_shader);
-    shader_destroy(&button_shader);
-    shader_destroy(&skybox_shader);
+    resources_program_release(&image_shader);
+    resources_program_release(&text_shader);
+    resources_program_release(&button_shader);
+    resources_program_release(&skybox_shader);
+    resources_program_release(&DebugLightCube.shader_program);
 
 	// & >>>>>>>>>>>>>>>>>>>>>>>>>>>>
 
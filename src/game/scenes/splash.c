@@ -8,13 +8,15 @@
 
 #include <pipeline/shader.h>
 #include <pipeline/buffers.h>
+#include <pipeline/resources.h>
 
 #include <projections/ortho.h>
 
 #include <ui/text.h>
 #include <ui/image.h>
 
-#include <qreader.h>
+#include <loaders/assets.h>
+#include <jobs/trace.h>
 
 #include <stb_image.h>
 #include <cglm/cglm.h>
@@ -30,17 +32,16 @@ static vec3 crosshairColor = {1.0f, 1.0f, 0.0f}; // White color
 static float crosshairSize = 2.0f; // Adjust crosshair size as needed
 static float crosshairThickness = 4.0f; // Adjust crosshair size as needed
 
-static Font font;
+static Font* font = NULL;
 static vec3 color = { 1.0f, 1.0f, 1.0f };
 static float font_size = 20.0f;
 
-static const char* loading_text = "Loading...";
+static char loading_text[32] = "Loading...";
 static const char* notify_text = "This might take some time, have a snack while it's loading!";
 
 // Declare an image
 static Image background_image;
 
-static double start_time;  // Store the start time
 	
 void splash_scene_update(Scene* self) {
 	// Get framebuffer size
@@ -74,15 +75,18 @@ void splash_scene_update(Scene* self) {
 	setup_ortho_projection(framebufferWidth, framebufferHeight, text_projection);
 
 	// Set projection matrix in shader
-	GLuint proj_loc = glGetUniformLocation(font.shader_program, "projection");
+	GLuint proj_loc = glGetUniformLocation(font->shader_program, "projection");
 	glUniformMatrix4fv(proj_loc, 1, GL_FALSE, (const GLfloat*)text_projection);
 
+	// Real progress of the asset loader
+	snprintf(loading_text, sizeof(loading_text), "Loading... %.0f%%", assets_progress() * 100.0f);
+
 	// Calculate text width and height
 	float text_width = 0.0f;
 	float text_m_width = 0.0f;
 	float text_height = 0.0f;
-	font_get_text_dimensions(&font, loading_text, &text_width, &text_height);
-	font_get_text_dimensions(&font, notify_text, &text_m_width, &text_height);
+	font_get_text_dimensions(font, loading_text, &text_width, &text_height);
+	font_get_text_dimensions(font, notify_text, &text_m_width, &text_height);
 
 	// Calculate centered position
 	float text_x = (framebufferWidth - text_width) / 2.0f;
@@ -90,71 +94,43 @@ void splash_scene_update(Scene* self) {
 	float text_y = ((framebufferHeight - text_height) / 2.0f) + 12.0f;
 
 	// Render text at the calculated position
-	font_render_text(&font, loading_text, text_x, text_y + font_size, color); // Centered text
-	font_render_text(&font, notify_text, text_xm, text_y + (font_size * 2.0f) + 2.0f, color); // Centered text
+	font_render_text(font, loading_text, text_x, text_y + font_size, color); // Centered text
+	font_render_text(font, notify_text, text_xm, text_y + (font_size * 2.0f) + 2.0f, color); // Centered text
 
 	buffers_unbind_vbo();
 	buffers_unbind_ebo();
-
-	// Get the current time
-    double current_time = glfwGetTime();
-
-    // If 8 seconds have passed, update the state to "loaded"
-    if (current_time - start_time >= 2.0) {
-        scene_state_set(&self->state, "loaded", "1"); // Set the loaded state
-    }
 }
 
 void splash_scene_render(Scene* self) {
-	start_time = glfwGetTime();
-	// Initialize text renderer
-	// Compile shaders and create shader program
-    char* t_vertexShaderSource = read_file("resources/shaders/text/vertex.glsl");
-    char* t_fragmentShaderSource = read_file("resources/shaders/text/fragment.glsl");
-    if (!t_vertexShaderSource || !t_fragmentShaderSource) {
-        fprintf(stderr, "Failed to load text shader sources!\n");
-        return;
-    }
-
-	text_shader = shader_create(t_vertexShaderSource, t_fragmentShaderSource);
-    free(t_vertexShaderSource);
-    free(t_fragmentShaderSource);
-
-    if (text_shader.id == 0) {
-        fprintf(stderr, "Shader program creation failed!\n");
-        return;
-    }
-    printf("Text shader program created.\n");
-
-	// Initialize image renderer
-	// Compile shaders and create shader program
-    char* i_vertexShaderSource = read_file("resources/shaders/image/vertex.glsl");
-    char* i_fragmentShaderSource = read_file("resources/shaders/image/fragment.glsl");
-    if (!t_vertexShaderSource || !t_fragmentShaderSource) {
-        fprintf(stderr, "Failed to load image shader sources!\n");
-        return;
-    }
-
-	image_shader = shader_create(i_vertexShaderSource, i_fragmentShaderSource);
-    free(i_vertexShaderSource);
-    free(i_fragmentShaderSource);
-
-    if (image_shader.id == 0) {
-        fprintf(stderr, "Shader program creation failed!\n");
-        return;
+	// Programs, font and image come from the shared resources, the main scene reuses them instead of building its own
+	// Both programs are issued before either is checked, so the driver can compile them side by side
+	ProgramBuild text_build, image_build;
+	resources_program_begin(&text_build, "resources/shaders/text/vertex.glsl", "resources/shaders/text/fragment.glsl");
+	resources_program_begin(&image_build, "resources/shaders/image/vertex.glsl", "resources/shaders/image/fragment.glsl");
+	text_shader = resources_program_finish(&text_build);
+	image_shader = resources_program_finish(&image_build);
+    if (text_shader.id == 0 || image_shader.id == 0) {
+        fprintf(stderr, "Splash shader program creation failed!\n");
     }
-    printf("Image shader program created.\n");
 
 	// Initialize Font
-    font_init(&font, "resources/vcr_osd_mono.ttf", font_size, 3.0f, text_shader.id);  // Adjust path and size as needed
+	TRACE_BEGIN("Splash font");
+    font = resources_font_acquire("resources/vcr_osd_mono.ttf", font_size, 3.0f, text_shader.id);
+
+	TRACE_END();
 
 	// Initialize background image
+	TRACE_BEGIN("Splash image");
 	image_init(&background_image, "resources/prototype/loading.png", image_shader.id);
+	TRACE_END();
 	image_set_dimensions(&background_image, 1024, 1024);
 	printf("Initialized background_image\n");
 }
 
 void splash_scene_cleanup() {
 	image_cleanup(&background_image);
-	font_cleanup(&font);
+	resources_font_release(font);
+	font = NULL;
+	resources_program_release(&text_shader);
+	resources_program_release(&image_shader);
 }
\ No newline at end of file
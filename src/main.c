@@ -14,14 +14,28 @@
 #include <input/mue.h>
 
 #include <scenes/scene.h>
+#include <scenes/scene_manager.h>
 #include <scenes/default.h>
 #include <scenes/splash.h>
 
+#include <jobs/jobs.h>
+#include <io/vfs.h>
+#include <loaders/assets.h>
+#include <pipeline/texture_registry.h>
+#include <pipeline/resources.h>
+#include <pipeline/shader.h>
+#include <jobs/trace.h>
+
 #include <debugger.h>
 
 int main() {
+    TRACE_THREAD_NAME("Main");
+
     // Initialize glfw
-    if(!glfwInit()) {
+    TRACE_BEGIN("glfwInit");
+    bool glfw_ready = glfwInit();
+    TRACE_END();
+    if(!glfw_ready) {
         fprintf(stderr, "Failed to initialize glfw!\n");
         return -1;
     }
@@ -56,7 +70,9 @@ int main() {
     int screen_h = 600;
 
     // Create a fullscreen-borderless window
+    TRACE_BEGIN("Window and context creation");
     GLFWwindow* window = glfwCreateWindow(screen_w, screen_h, "lwlaim", NULL, NULL);
+    TRACE_END();
     if(!window) {
         fprintf(stderr, "Failed to create window!\n");
         glfwTerminate();
@@ -68,7 +84,10 @@ int main() {
     glfwMakeContextCurrent(window);
 
     // Initialize Glad
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+    TRACE_BEGIN("GLAD load");
+    bool glad_ready = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+    TRACE_END();
+    if (!glad_ready) {
         fprintf(stderr, "Failed to initialize Glad!\n");
         return -2;
     }
@@ -77,6 +96,7 @@ int main() {
     // Print OpenGL version to ensure it is initialized
     const char* version = (const char*)glGetString(GL_VERSION);
     printf("OpenGL version: %s\n", version);
+    shader_init((GLADloadproc)glfwGetProcAddress);
 
     // Keyboard and mouse callback functions
     glfwSetKeyCallback(window, keyboard_callback);
@@ -97,39 +117,69 @@ int main() {
     glfwSwapInterval(0);
 
     Scene *main_scene = scene_create("main#0", window);
-    scene_state_set(&main_scene->state, "player_health", "100");
+    StateSlot player_health = scene_state_register(&main_scene->state, "player_health", STATE_FLOAT);
+    scene_state_set_float(&main_scene->state, player_health, 100.0f);
     main_scene->update = default_scene_update;
     main_scene->render = default_scene_render;
     main_scene->cleanup = default_scene_cleanup;
 
     Scene *splash_screen = scene_create("splash#0", window);
-    scene_state_set(&splash_screen->state, "loaded", "0");
     splash_screen->update = splash_scene_update;
     splash_screen->render = splash_scene_render;
     splash_screen->cleanup = splash_scene_cleanup;
 
-    splash_screen->render(splash_screen);
-    main_scene->render(main_scene);
-
+    // Resources come from the pack when one was built (bun pack), loose files otherwise
+    TRACE_BEGIN("Pack mount");
+    vfs_mount("resources.lpak");
+    TRACE_END();
+
+    // Worker threads for file I/O and decoding, GL work is finalized on this thread
+    TRACE_BEGIN("Jobs and asset loader init");
+    texture_registry_init();
+    jobs_init(0);
+    assets_init();
+    TRACE_END();
+
+    // The splash is set up on the first frame, the main scene on the next one and its assets load while the
+    // splash is shown, the switch happens once they are all resident
+    scene_manager_push(splash_screen);
+    scene_manager_replace(main_scene);
+
+    // Frames are only traced while loading, that is the part of the timeline worth looking at
+    bool loading = true;
     while (!glfwWindowShouldClose(window)) {
-        // Check the state of the splash screen
-        const char *state_value = scene_state_get(&splash_screen->state, "loaded");
-
-        if (state_value != NULL && strcmp(state_value, "1") == 0) {
-            // If the state is "1", switch to the main scene
-            main_scene->update(main_scene);
-        } else {
-            // Otherwise, keep showing the splash screen
-            splash_screen->update(splash_screen);
-        }
+        if (loading) TRACE_BEGIN("Loading frame");
+
+        // Upload / finish whatever the workers decoded, within a per-frame budget
+        assets_update(ASSETS_FRAME_BUDGET_MS);
+
+        // Starts / applies queued scene transitions, then updates the current scene
+        scene_manager_update();
 
         // Swap buffers to display the updated scene
         glfwSwapBuffers(window);
         glfwPollEvents();
+
+        if (loading) {
+            TRACE_END();
+            loading = !assets_idle() || scene_manager_transition() != SCENE_TRANSITION_NONE;
+        }
     }
 
-    main_scene->cleanup(main_scene);
-    splash_screen->cleanup(splash_screen);
+    // Stop the workers before anything they might still be writing into is freed
+    jobs_shutdown();
+    assets_shutdown();
+
+    scene_manager_shutdown();
+    scene_destroy(main_scene);
+    scene_destroy(splash_screen);
+
+    // Scenes have released their programs, fonts and textures, anything left is a leak
+    resources_shutdown();
+    texture_registry_shutdown();
+    vfs_unmount_all(); // Models still point into mapped packs until they are freed
+
+    TRACE_WRITE("lwlaim_trace.json");
 
     // Close window and terminate
     glfwDestroyWindow(window);
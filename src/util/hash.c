@@ -0,0 +1,34 @@
+#include <hash.h>
+
+#include <string.h>
+
+uint64_t hash_mix64(uint64_t value) {
+    value ^= value >> 31;
+    value *= 0xbf58476d1ce4e5b9ull;
+    value ^= value >> 29;
+    value *= 0x94d049bb133111ebull;
+    value ^= value >> 32;
+    return value;
+}
+
+uint64_t hash_bytes(const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    uint64_t hash = 0x9e3779b97f4a7c15ull ^ size;
+
+    // Eight bytes per step, image files are large
+    while (size >= 8) {
+        uint64_t word;
+        memcpy(&word, bytes, 8);
+        hash = (hash ^ hash_mix64(word)) * 0x9e3779b97f4a7c15ull;
+        bytes += 8;
+        size -= 8;
+    }
+    if (size) {
+        uint64_t word = 0;
+        memcpy(&word, bytes, size);
+        hash = (hash ^ hash_mix64(word)) * 0x9e3779b97f4a7c15ull;
+    }
+
+    hash = hash_mix64(hash);
+    return hash ? hash : 1;
+}
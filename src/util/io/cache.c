@@ -0,0 +1,43 @@
+#include <io/cache.h>
+
+#include <stdio.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+	#include <direct.h>
+	#define make_directory(path) _mkdir(path)
+#else
+	#define make_directory(path) mkdir(path, 0755)
+#endif
+
+#define CACHE_ROOT "cache"
+
+void cache_entry_path(const char* kind, uint64_t key, const char* extension, char* dest, size_t dest_size) {
+    char directory[256];
+    snprintf(directory, sizeof(directory), CACHE_ROOT "/%s", kind);
+
+    // Fails harmlessly when they exist
+    make_directory(CACHE_ROOT);
+    make_directory(directory);
+
+    snprintf(dest, dest_size, "%s/%016llx%s", directory, (unsigned long long)key, extension);
+}
+
+bool cache_write(const char* path, const void* header, size_t header_size, const void* payload, size_t payload_size) {
+    char temp_path[512];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+
+    FILE* file = fopen(temp_path, "wb");
+    bool ok = file &&
+              fwrite(header, 1, header_size, file) == header_size &&
+              (payload_size == 0 || fwrite(payload, 1, payload_size, file) == payload_size);
+    if (file) ok = fclose(file) == 0 && ok;
+
+    remove(path); // rename does not replace on Windows
+    if (!ok || rename(temp_path, path) != 0) {
+        fprintf(stderr, "[CACHE] Failed to write %s\n", path);
+        remove(temp_path);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,147 @@
+#include <io/lz4.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LZ4_MIN_MATCH 4
+#define LZ4_LAST_LITERALS 5   // The block always ends with at least this many literals
+#define LZ4_MATCH_LIMIT 12    // No match may start closer than this to the end
+#define LZ4_MAX_OFFSET 65535
+#define LZ4_HASH_BITS 16
+
+static uint32_t read_u32(const unsigned char* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static uint32_t hash_sequence(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+}
+
+// Length continuation bytes after a nibble of 15
+static unsigned char* write_length(unsigned char* out, size_t length) {
+    for (; length >= 255; length -= 255) *out++ = 255;
+    *out++ = (unsigned char)length;
+    return out;
+}
+
+// One sequence: literals, then a match (length 0 for the final literal run)
+static unsigned char* write_sequence(unsigned char* out, const unsigned char* end, const unsigned char* literals, size_t literal_count, size_t offset, size_t match_length) {
+    size_t needed = 1 + literal_count + literal_count / 255 + 1 + (match_length ? 2 + match_length / 255 + 1 : 0);
+    if ((size_t)(end - out) < needed) return NULL;
+
+    size_t match_code = match_length ? match_length - LZ4_MIN_MATCH : 0;
+    *out++ = (unsigned char)(((literal_count < 15 ? literal_count : 15) << 4) | (match_code < 15 ? match_code : 15));
+    if (literal_count >= 15) out = write_length(out, literal_count - 15);
+
+    memcpy(out, literals, literal_count);
+    out += literal_count;
+    if (!match_length) return out;
+
+    *out++ = (unsigned char)(offset & 0xFF);
+    *out++ = (unsigned char)(offset >> 8);
+    if (match_code >= 15) out = write_length(out, match_code - 15);
+    return out;
+}
+
+size_t lz4_compress_bound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+size_t lz4_compress(const unsigned char* src, size_t size, unsigned char* dst, size_t capacity) {
+    // Last position each 4-byte sequence was seen at, plus one (0 = never)
+    uint32_t* table = calloc((size_t)1 << LZ4_HASH_BITS, sizeof(uint32_t));
+    if (!table) return 0;
+
+    unsigned char* out = dst;
+    const unsigned char* end = dst + capacity;
+    size_t anchor = 0;
+    size_t pos = 0;
+
+    while (size >= LZ4_MATCH_LIMIT && pos <= size - LZ4_MATCH_LIMIT) {
+        uint32_t sequence = read_u32(src + pos);
+        uint32_t slot = hash_sequence(sequence);
+        size_t candidate = table[slot];
+        table[slot] = (uint32_t)(pos + 1);
+
+        if (!candidate || pos - (candidate - 1) > LZ4_MAX_OFFSET || read_u32(src + candidate - 1) != sequence) {
+            pos++;
+            continue;
+        }
+
+        // Extend the match, leaving the trailing literals alone
+        size_t match = candidate - 1;
+        size_t length = LZ4_MIN_MATCH;
+        while (pos + length < size - LZ4_LAST_LITERALS && src[match + length] == src[pos + length]) length++;
+
+        out = write_sequence(out, end, src + anchor, pos - anchor, pos - match, length);
+        if (!out) {
+            free(table);
+            return 0;
+        }
+
+        pos += length;
+        anchor = pos;
+    }
+
+    out = write_sequence(out, end, src + anchor, size - anchor, 0, 0);
+    free(table);
+    return out ? (size_t)(out - dst) : 0;
+}
+
+size_t lz4_decompress(const unsigned char* src, size_t size, unsigned char* dst, size_t capacity) {
+    const unsigned char* in = src;
+    const unsigned char* in_end = src + size;
+    unsigned char* out = dst;
+    unsigned char* out_end = dst + capacity;
+
+    while (in < in_end) {
+        unsigned token = *in++;
+
+        size_t literal_count = token >> 4;
+        if (literal_count == 15) {
+            unsigned char byte;
+            do {
+                if (in >= in_end) return 0;
+                byte = *in++;
+                literal_count += byte;
+            } while (byte == 255);
+        }
+        if (literal_count > (size_t)(in_end - in) || literal_count > (size_t)(out_end - out)) return 0;
+
+        memcpy(out, in, literal_count);
+        in += literal_count;
+        out += literal_count;
+        if (in == in_end) break; // The last sequence has no match
+
+        if (in_end - in < 2) return 0;
+        size_t offset = (size_t)in[0] | ((size_t)in[1] << 8);
+        in += 2;
+        if (offset == 0 || offset > (size_t)(out - dst)) return 0;
+
+        size_t length = token & 15;
+        if (length == 15) {
+            unsigned char byte;
+            do {
+                if (in >= in_end) return 0;
+                byte = *in++;
+                length += byte;
+            } while (byte == 255);
+        }
+        length += LZ4_MIN_MATCH;
+        if (length > (size_t)(out_end - out)) return 0;
+
+        // Overlapping matches repeat the last offset bytes, copy those forward one at a time
+        const unsigned char* match = out - offset;
+        if (offset >= length) {
+            memcpy(out, match, length);
+        } else {
+            for (size_t i = 0; i < length; i++) out[i] = match[i];
+        }
+        out += length;
+    }
+
+    return (size_t)(out - dst);
+}
@@ -0,0 +1,88 @@
+#include <io/mapped_file.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+#ifdef _WIN32
+
+bool mapped_file_open(MappedFile* file, const char* path) {
+    memset(file, 0, sizeof(MappedFile));
+
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0) {
+        CloseHandle(handle);
+        return false;
+    }
+
+    // The mapping keeps the file open, the file handle itself is not needed any more
+    HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(handle);
+    if (!mapping) {
+        fprintf(stderr, "Failed to map file %s\n", path);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        fprintf(stderr, "Failed to map file %s\n", path);
+        CloseHandle(mapping);
+        return false;
+    }
+
+    file->data = (const unsigned char*)view;
+    file->size = (size_t)size.QuadPart;
+    file->handle = mapping;
+    return true;
+}
+
+void mapped_file_close(MappedFile* file) {
+    if (file->data) UnmapViewOfFile((LPCVOID)file->data);
+    if (file->handle) CloseHandle((HANDLE)file->handle);
+    memset(file, 0, sizeof(MappedFile));
+}
+
+#else
+
+bool mapped_file_open(MappedFile* file, const char* path) {
+    memset(file, 0, sizeof(MappedFile));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    void* view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        fprintf(stderr, "Failed to map file %s\n", path);
+        return false;
+    }
+
+    file->data = (const unsigned char*)view;
+    file->size = (size_t)info.st_size;
+    return true;
+}
+
+void mapped_file_close(MappedFile* file) {
+    if (file->data) munmap((void*)file->data, file->size);
+    memset(file, 0, sizeof(MappedFile));
+}
+
+#endif
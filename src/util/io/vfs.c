@@ -0,0 +1,222 @@
+#include <io/vfs.h>
+#include <io/pack.h>
+#include <io/lz4.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define VFS_MAX_MOUNTS 8
+#define VFS_PATH_MAX 1024
+
+typedef struct {
+    MappedFile file;
+    const PackHeader* header;
+} Mount;
+
+static Mount mounts[VFS_MAX_MOUNTS];
+static uint32_t mount_count = 0;
+
+void vfs_normalize_path(const char* path, char* dest, size_t dest_size) {
+    if (!dest || dest_size == 0) return;
+    dest[0] = '\0';
+    if (!path) return;
+
+    size_t length = 0;
+    size_t root = 0; // Leading "/" (or drive) that ".." never removes
+    if (path[0] == '/' || path[0] == '\\') {
+        if (dest_size > 1) dest[length++] = '/';
+        root = length;
+    }
+
+    const char* p = path;
+    while (*p) {
+        while (*p == '/' || *p == '\\') p++;
+        const char* segment = p;
+        while (*p && *p != '/' && *p != '\\') p++;
+        size_t segment_length = (size_t)(p - segment);
+
+        if (segment_length == 0 || (segment_length == 1 && segment[0] == '.')) continue;
+
+        // "dir/.." cancels out, a ".." with nothing left to remove is kept
+        if (segment_length == 2 && segment[0] == '.' && segment[1] == '.') {
+            size_t start = length;
+            while (start > root && dest[start - 1] != '/') start--;
+            bool parent = length > root && !(length - start == 2 && dest[start] == '.' && dest[start + 1] == '.');
+            if (parent || (root > 0 && length == root)) { // Nothing goes above "/"
+                length = start > root ? start - 1 : root;
+                continue;
+            }
+        }
+
+        if (length > root && length + 1 < dest_size) dest[length++] = '/';
+        if (length + segment_length >= dest_size) break;
+        memcpy(dest + length, segment, segment_length);
+        length += segment_length;
+    }
+    dest[length] = '\0';
+}
+
+bool vfs_mount(const char* pack_path) {
+    if (mount_count == VFS_MAX_MOUNTS) {
+        fprintf(stderr, "[VFS] Too many packs mounted, ignoring %s\n", pack_path);
+        return false;
+    }
+
+    Mount* mount = &mounts[mount_count];
+    if (!mapped_file_open(&mount->file, pack_path)) return false;
+
+    mount->header = pack_validate(mount->file.data, mount->file.size);
+    if (!mount->header) {
+        fprintf(stderr, "[VFS] Invalid resource pack (rebuild it): %s\n", pack_path);
+        mapped_file_close(&mount->file);
+        return false;
+    }
+
+    mount_count++;
+    printf("[VFS] Mounted %s (%u files)\n", pack_path, mount->header->entry_count);
+    return true;
+}
+
+void vfs_unmount_all() {
+    for (uint32_t i = 0; i < mount_count; i++) mapped_file_close(&mounts[i].file);
+    mount_count = 0;
+}
+
+// Binary search on the hash, then the names of the (rare) colliding entries
+static const PackEntry* pack_find(const PackHeader* header, const char* name, uint64_t hash) {
+    const PackEntry* entries = pack_entries(header);
+    uint32_t low = 0, high = header->entry_count;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (entries[middle].hash < hash) low = middle + 1;
+        else high = middle;
+    }
+
+    for (uint32_t i = low; i < header->entry_count && entries[i].hash == hash; i++) {
+        if (strcmp(pack_entry_name(header, &entries[i]), name) == 0) return &entries[i];
+    }
+    return NULL;
+}
+
+static const PackEntry* vfs_find(const char* path, const PackHeader** header_out) {
+    if (mount_count == 0) return NULL;
+
+    char name[VFS_PATH_MAX];
+    vfs_normalize_path(path, name, sizeof(name));
+    uint64_t hash = pack_hash_path(name);
+
+    for (uint32_t i = mount_count; i-- > 0;) {
+        const PackEntry* entry = pack_find(mounts[i].header, name, hash);
+        if (entry) {
+            *header_out = mounts[i].header;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+bool vfs_open(VfsFile* file, const char* path) {
+    memset(file, 0, sizeof(VfsFile));
+
+    const PackHeader* header;
+    const PackEntry* entry = vfs_find(path, &header);
+    if (!entry) {
+        if (!mapped_file_open(&file->mapped, path)) return false;
+        file->data = file->mapped.data;
+        file->size = file->mapped.size;
+        return true;
+    }
+
+    const unsigned char* stored = (const unsigned char*)header + entry->offset;
+    if (entry->compression == PACK_STORED) {
+        file->data = stored;
+        file->size = (size_t)entry->size;
+        return true;
+    }
+
+    // The extra byte keeps text files null-terminated, like vfs_read
+    file->owned = malloc((size_t)entry->raw_size + 1);
+    if (!file->owned) {
+        fprintf(stderr, "[VFS] Failed to allocate %llu bytes for %s\n", (unsigned long long)entry->raw_size, path);
+        return false;
+    }
+    if (lz4_decompress(stored, (size_t)entry->size, file->owned, (size_t)entry->raw_size) != entry->raw_size) {
+        fprintf(stderr, "[VFS] Corrupt pack entry: %s\n", path);
+        free(file->owned);
+        file->owned = NULL;
+        return false;
+    }
+    file->owned[entry->raw_size] = '\0';
+    file->data = file->owned;
+    file->size = (size_t)entry->raw_size;
+    return true;
+}
+
+void vfs_close(VfsFile* file) {
+    free(file->owned);
+    mapped_file_close(&file->mapped);
+    memset(file, 0, sizeof(VfsFile));
+}
+
+bool vfs_exists(const char* path) {
+    const PackHeader* header;
+    if (vfs_find(path, &header)) return true;
+
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    fclose(file);
+    return true;
+}
+
+unsigned char* vfs_read(const char* path, size_t* size) {
+    const PackHeader* header;
+    const PackEntry* entry = vfs_find(path, &header);
+
+    if (entry) {
+        VfsFile file;
+        if (!vfs_open(&file, path)) return NULL;
+
+        // Decompressed entries already are a private null-terminated copy, hand it over
+        unsigned char* content = file.owned;
+        size_t length = file.size;
+        if (!content) {
+            content = malloc(file.size + 1);
+            if (content) {
+                memcpy(content, file.data, file.size);
+                content[file.size] = '\0';
+            }
+            vfs_close(&file);
+        }
+        if (content && size) *size = length;
+        return content;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (length < 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    unsigned char* content = malloc((size_t)length + 1);
+    if (!content) {
+        fclose(file);
+        return NULL;
+    }
+
+    size_t read = fread(content, 1, (size_t)length, file);
+    fclose(file);
+    if (read != (size_t)length) {
+        free(content);
+        return NULL;
+    }
+
+    content[length] = '\0';
+    if (size) *size = (size_t)length;
+    return content;
+}
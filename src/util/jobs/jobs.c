@@ -0,0 +1,210 @@
+#include <jobs/jobs.h>
+#include <jobs/thread.h>
+#include <jobs/trace.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define JOBS_MAX_WORKERS 32
+
+typedef struct {
+    JobFunc func;
+    void* data;
+} Job;
+
+// Growable ring buffer of pending jobs, guarded by one mutex
+static Job* queue = NULL;
+static uint32_t queue_head = 0;
+static uint32_t queue_count = 0;
+static uint32_t queue_capacity = 0;
+
+static Mutex queue_mutex;
+static CondVar queue_wake;
+static bool running = false;
+
+static Thread workers[JOBS_MAX_WORKERS];
+static uint32_t worker_count = 0;
+
+static void worker_main(void* arg) {
+    (void)arg;
+    TRACE_THREAD_NAME("Job worker");
+
+    mutex_lock(&queue_mutex);
+    for (;;) {
+        while (running && queue_count == 0) cond_wait(&queue_wake, &queue_mutex);
+        if (!running) break;
+
+        Job job = queue[queue_head];
+        queue_head = (queue_head + 1) % queue_capacity;
+        queue_count--;
+
+        mutex_unlock(&queue_mutex);
+        job.func(job.data);
+        mutex_lock(&queue_mutex);
+    }
+    mutex_unlock(&queue_mutex);
+}
+
+bool jobs_init(uint32_t count) {
+    if (running) return true;
+
+    if (count == 0) {
+        uint32_t hardware = thread_hardware_concurrency();
+        count = hardware > 1 ? hardware - 1 : 1;
+    }
+    if (count > JOBS_MAX_WORKERS) count = JOBS_MAX_WORKERS;
+
+    mutex_init(&queue_mutex);
+    cond_init(&queue_wake);
+    running = true;
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (!thread_create(&workers[worker_count], worker_main, NULL)) {
+            fprintf(stderr, "[JOBS] Failed to start worker %u.\n", i);
+            break;
+        }
+        worker_count++;
+    }
+
+    if (worker_count == 0) {
+        fprintf(stderr, "[JOBS] No worker threads could be started!\n");
+        running = false;
+        cond_destroy(&queue_wake);
+        mutex_destroy(&queue_mutex);
+        return false;
+    }
+
+    printf("[JOBS] Started %u worker threads.\n", worker_count);
+    return true;
+}
+
+void jobs_shutdown() {
+    if (!running) return;
+
+    mutex_lock(&queue_mutex);
+    running = false;
+    cond_broadcast(&queue_wake);
+    mutex_unlock(&queue_mutex);
+
+    for (uint32_t i = 0; i < worker_count; i++) thread_join(workers[i]);
+    worker_count = 0;
+
+    if (queue_count) printf("[JOBS] Dropped %u pending jobs.\n", queue_count);
+    free(queue);
+    queue = NULL;
+    queue_head = queue_count = queue_capacity = 0;
+
+    cond_destroy(&queue_wake);
+    mutex_destroy(&queue_mutex);
+}
+
+bool jobs_submit(JobFunc func, void* data) {
+    if (!running || !func) return false;
+
+    mutex_lock(&queue_mutex);
+    if (queue_count == queue_capacity) {
+        // Unroll the ring into a larger buffer
+        uint32_t capacity = queue_capacity ? queue_capacity * 2 : 64;
+        Job* grown = malloc(sizeof(Job) * capacity);
+        if (!grown) {
+            mutex_unlock(&queue_mutex);
+            fprintf(stderr, "[JOBS] Failed to grow the job queue!\n");
+            return false;
+        }
+        for (uint32_t i = 0; i < queue_count; i++) grown[i] = queue[(queue_head + i) % queue_capacity];
+
+        free(queue);
+        queue = grown;
+        queue_head = 0;
+        queue_capacity = capacity;
+    }
+
+    queue[(queue_head + queue_count) % queue_capacity] = (Job){ func, data };
+    queue_count++;
+    cond_signal(&queue_wake);
+    mutex_unlock(&queue_mutex);
+    return true;
+}
+
+// Shared state of one jobs_parallel_for call, freed by whoever drops the last reference
+typedef struct {
+    JobIndexFunc func;
+    void* data;
+    uint32_t count;
+    uint32_t next;
+    uint32_t done;
+    uint32_t refs;
+    Mutex mutex;
+    CondVar finished;
+} JobBatch;
+
+// Take items until none are left; helpers that start late find nothing to do
+static void batch_run(JobBatch* batch) {
+    mutex_lock(&batch->mutex);
+    while (batch->next < batch->count) {
+        uint32_t index = batch->next++;
+        mutex_unlock(&batch->mutex);
+
+        batch->func(batch->data, index);
+
+        mutex_lock(&batch->mutex);
+        if (++batch->done == batch->count) cond_broadcast(&batch->finished);
+    }
+    mutex_unlock(&batch->mutex);
+}
+
+static void batch_release(JobBatch* batch) {
+    mutex_lock(&batch->mutex);
+    bool last = --batch->refs == 0;
+    mutex_unlock(&batch->mutex);
+
+    if (last) {
+        cond_destroy(&batch->finished);
+        mutex_destroy(&batch->mutex);
+        free(batch);
+    }
+}
+
+static void batch_helper_job(void* data) {
+    JobBatch* batch = (JobBatch*)data;
+    batch_run(batch);
+    batch_release(batch);
+}
+
+void jobs_parallel_for(uint32_t count, JobIndexFunc func, void* data) {
+    if (count == 0 || !func) return;
+
+    JobBatch* batch = count > 1 && worker_count ? malloc(sizeof(JobBatch)) : NULL;
+    if (!batch) {
+        for (uint32_t i = 0; i < count; i++) func(data, i);
+        return;
+    }
+
+    *batch = (JobBatch){ .func = func, .data = data, .count = count, .next = 0, .done = 0, .refs = 1 };
+    mutex_init(&batch->mutex);
+    cond_init(&batch->finished);
+
+    // One helper per worker at most, the calling thread is the last pair of hands
+    uint32_t helpers = count - 1 < worker_count ? count - 1 : worker_count;
+    for (uint32_t i = 0; i < helpers; i++) {
+        mutex_lock(&batch->mutex);
+        batch->refs++;
+        mutex_unlock(&batch->mutex);
+        if (!jobs_submit(batch_helper_job, batch)) {
+            batch_release(batch);
+            break;
+        }
+    }
+
+    batch_run(batch);
+
+    mutex_lock(&batch->mutex);
+    while (batch->done < batch->count) cond_wait(&batch->finished, &batch->mutex);
+    mutex_unlock(&batch->mutex);
+    batch_release(batch);
+}
+
+uint32_t jobs_worker_count() {
+    return worker_count;
+}
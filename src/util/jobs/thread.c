@@ -0,0 +1,139 @@
+#include <jobs/thread.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#else
+	#include <time.h>
+	#include <unistd.h>
+	#include <sys/syscall.h>
+#endif
+
+// Trampoline data so both platforms can share the ThreadFunc signature
+typedef struct {
+    ThreadFunc func;
+    void* arg;
+} ThreadStart;
+
+#ifdef _WIN32
+
+static DWORD WINAPI thread_trampoline(LPVOID param) {
+    ThreadStart start = *(ThreadStart*)param;
+    free(param);
+    start.func(start.arg);
+    return 0;
+}
+
+bool thread_create(Thread* thread, ThreadFunc func, void* arg) {
+    ThreadStart* start = malloc(sizeof(ThreadStart));
+    if (!start) return false;
+    start->func = func;
+    start->arg = arg;
+
+    *thread = CreateThread(NULL, 0, thread_trampoline, start, 0, NULL);
+    if (!*thread) {
+        fprintf(stderr, "Failed to create thread.\n");
+        free(start);
+        return false;
+    }
+    return true;
+}
+
+void thread_join(Thread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+uint32_t thread_current_id() { return (uint32_t)GetCurrentThreadId(); }
+
+uint32_t thread_hardware_concurrency() {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors ? (uint32_t)info.dwNumberOfProcessors : 1;
+}
+
+void thread_sleep_ms(uint32_t milliseconds) { Sleep(milliseconds); }
+
+void mutex_init(Mutex* mutex) { InitializeSRWLock((PSRWLOCK)mutex); }
+void mutex_destroy(Mutex* mutex) { (void)mutex; }
+void mutex_lock(Mutex* mutex) { AcquireSRWLockExclusive((PSRWLOCK)mutex); }
+void mutex_unlock(Mutex* mutex) { ReleaseSRWLockExclusive((PSRWLOCK)mutex); }
+
+void cond_init(CondVar* cond) { InitializeConditionVariable((PCONDITION_VARIABLE)cond); }
+void cond_destroy(CondVar* cond) { (void)cond; }
+void cond_wait(CondVar* cond, Mutex* mutex) { SleepConditionVariableSRW((PCONDITION_VARIABLE)cond, (PSRWLOCK)mutex, INFINITE, 0); }
+void cond_signal(CondVar* cond) { WakeConditionVariable((PCONDITION_VARIABLE)cond); }
+void cond_broadcast(CondVar* cond) { WakeAllConditionVariable((PCONDITION_VARIABLE)cond); }
+
+uint64_t clock_now_ns() {
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((counter.QuadPart / frequency.QuadPart) * 1000000000ull +
+                      ((counter.QuadPart % frequency.QuadPart) * 1000000000ull) / frequency.QuadPart);
+}
+
+#else
+
+static void* thread_trampoline(void* param) {
+    ThreadStart start = *(ThreadStart*)param;
+    free(param);
+    start.func(start.arg);
+    return NULL;
+}
+
+bool thread_create(Thread* thread, ThreadFunc func, void* arg) {
+    ThreadStart* start = malloc(sizeof(ThreadStart));
+    if (!start) return false;
+    start->func = func;
+    start->arg = arg;
+
+    if (pthread_create(thread, NULL, thread_trampoline, start) != 0) {
+        fprintf(stderr, "Failed to create thread.\n");
+        free(start);
+        return false;
+    }
+    return true;
+}
+
+void thread_join(Thread thread) { pthread_join(thread, NULL); }
+
+uint32_t thread_current_id() {
+#ifdef SYS_gettid
+    return (uint32_t)syscall(SYS_gettid);
+#else
+    return (uint32_t)(uintptr_t)pthread_self();
+#endif
+}
+
+uint32_t thread_hardware_concurrency() {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (uint32_t)count : 1;
+}
+
+void thread_sleep_ms(uint32_t milliseconds) {
+    struct timespec duration = { milliseconds / 1000, (long)(milliseconds % 1000) * 1000000L };
+    nanosleep(&duration, NULL);
+}
+
+void mutex_init(Mutex* mutex) { pthread_mutex_init(mutex, NULL); }
+void mutex_destroy(Mutex* mutex) { pthread_mutex_destroy(mutex); }
+void mutex_lock(Mutex* mutex) { pthread_mutex_lock(mutex); }
+void mutex_unlock(Mutex* mutex) { pthread_mutex_unlock(mutex); }
+
+void cond_init(CondVar* cond) { pthread_cond_init(cond, NULL); }
+void cond_destroy(CondVar* cond) { pthread_cond_destroy(cond); }
+void cond_wait(CondVar* cond, Mutex* mutex) { pthread_cond_wait(cond, mutex); }
+void cond_signal(CondVar* cond) { pthread_cond_signal(cond); }
+void cond_broadcast(CondVar* cond) { pthread_cond_broadcast(cond); }
+
+uint64_t clock_now_ns() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+#endif
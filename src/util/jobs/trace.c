@@ -0,0 +1,156 @@
+#include <jobs/trace.h>
+
+#ifdef LWLAIM_TRACE
+
+#include <jobs/thread.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#define TRACE_EVENTS_PER_THREAD 16384
+#define TRACE_DETAIL_SIZE 46
+
+typedef struct {
+    const char* name;    // NULL for an end event
+    uint64_t time_ns;
+    char detail[TRACE_DETAIL_SIZE];
+    bool truncated;      // detail holds the end of a longer string
+} TraceEvent;
+
+// One per thread, only that thread writes its events, the writer reads them after the threads are done
+typedef struct TraceBuffer {
+    uint32_t thread_id;
+    char thread_name[32];
+    _Atomic uint32_t count;
+    uint32_t dropped;
+    struct TraceBuffer* next;
+    TraceEvent events[TRACE_EVENTS_PER_THREAD];
+} TraceBuffer;
+
+static _Atomic(TraceBuffer*) buffers = NULL;
+static _Atomic uint64_t start_ns = 0;
+static _Thread_local TraceBuffer* local_buffer = NULL;
+
+static TraceBuffer* trace_local_buffer() {
+    if (local_buffer) return local_buffer;
+
+    // First event anywhere sets time zero
+    uint64_t zero = 0;
+    atomic_compare_exchange_strong(&start_ns, &zero, clock_now_ns());
+
+    TraceBuffer* buffer = calloc(1, sizeof(TraceBuffer));
+    if (!buffer) return NULL;
+    buffer->thread_id = thread_current_id();
+
+    // Lock-free push, buffers are never removed
+    buffer->next = atomic_load(&buffers);
+    while (!atomic_compare_exchange_weak(&buffers, &buffer->next, buffer)) {}
+
+    local_buffer = buffer;
+    return buffer;
+}
+
+static void trace_record(const char* name, const char* detail) {
+    // Read the clock after time zero exists, the first event of the process must not come before it
+    TraceBuffer* buffer = trace_local_buffer();
+    if (!buffer) return;
+    uint64_t now = clock_now_ns();
+
+    uint32_t index = atomic_load_explicit(&buffer->count, memory_order_relaxed);
+    if (index == TRACE_EVENTS_PER_THREAD) {
+        buffer->dropped++;
+        return;
+    }
+
+    TraceEvent* event = &buffer->events[index];
+    event->name = name;
+    event->time_ns = now;
+    event->detail[0] = '\0';
+    event->truncated = false;
+    if (detail) {
+        // Keep the end, for paths the file name matters most
+        size_t length = strlen(detail);
+        event->truncated = length >= TRACE_DETAIL_SIZE;
+        if (event->truncated) detail += length - (TRACE_DETAIL_SIZE - 1);
+        strcpy(event->detail, detail);
+    }
+    atomic_store_explicit(&buffer->count, index + 1, memory_order_release);
+}
+
+void trace_begin(const char* name, const char* detail) {
+    trace_record(name ? name : "(unnamed)", detail);
+}
+
+void trace_end() {
+    trace_record(NULL, NULL);
+}
+
+void trace_thread_name(const char* name) {
+    TraceBuffer* buffer = trace_local_buffer();
+    if (buffer) snprintf(buffer->thread_name, sizeof(buffer->thread_name), "%s", name);
+}
+
+static void write_json_string(FILE* file, const char* prefix, const char* text) {
+    fprintf(file, "\"%s", prefix);
+    for (; *text; text++) {
+        unsigned char c = (unsigned char)*text;
+        if (c == '"' || c == '\\') fprintf(file, "\\%c", c);
+        else if (c < 0x20) fprintf(file, "\\u%04x", c);
+        else fputc(c, file);
+    }
+    fputc('"', file);
+}
+
+bool trace_write(const char* path) {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "[TRACE] Failed to create %s\n", path);
+        return false;
+    }
+
+    uint64_t zero = atomic_load(&start_ns);
+    uint32_t event_count = 0, dropped = 0;
+    bool first = true;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (TraceBuffer* buffer = atomic_load(&buffers); buffer; buffer = buffer->next) {
+        if (buffer->thread_name[0]) {
+            fprintf(file, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",\n", buffer->thread_id);
+            write_json_string(file, "", buffer->thread_name);
+            fprintf(file, "}}");
+            first = false;
+        }
+
+        uint32_t count = atomic_load_explicit(&buffer->count, memory_order_acquire);
+        for (uint32_t i = 0; i < count; i++) {
+            const TraceEvent* event = &buffer->events[i];
+            double timestamp_us = (double)(event->time_ns - zero) / 1000.0;
+            fprintf(file, "%s{\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%.3f", first ? "" : ",\n",
+                    event->name ? 'B' : 'E', buffer->thread_id, timestamp_us);
+            if (event->name) {
+                fprintf(file, ",\"name\":");
+                write_json_string(file, "", event->name);
+            }
+            if (event->detail[0]) {
+                fprintf(file, ",\"args\":{\"detail\":");
+                write_json_string(file, event->truncated ? "..." : "", event->detail);
+                fprintf(file, "}");
+            }
+            fprintf(file, "}");
+            first = false;
+        }
+        event_count += count;
+        dropped += buffer->dropped;
+    }
+    fprintf(file, "\n]}\n");
+
+    bool ok = fclose(file) == 0;
+    if (ok) printf("[TRACE] Wrote %u events to %s\n", event_count, path);
+    if (dropped) fprintf(stderr, "[TRACE] %u events dropped, a thread buffer was full\n", dropped);
+    return ok;
+}
+
+#endif // LWLAIM_TRACE
@@ -0,0 +1,825 @@
+#include <loaders/assets.h>
+#include <jobs/jobs.h>
+#include <jobs/thread.h>
+#include <jobs/trace.h>
+
+#include <entities/material.h>
+#include <entities/mesh_baked.h>
+#include <pipeline/texture_registry.h>
+#include <pipeline/resources.h>
+#include <pipeline/texture.h>
+#include <loaders/ufbx.h>
+#include <stb_image.h>
+#include <wav.h>
+#include <hash.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ASSETS_UPLOAD_PBOS 2 // Ring of pixel unpack buffers used for texture uploads
+
+// Request list in submission order, finalized from the head
+static Asset *queue_head = NULL;
+static Asset *queue_tail = NULL;
+static Mutex queue_mutex;
+static bool initialized = false;
+
+// Progress of the current batch (reset whenever a request arrives while idle)
+static uint32_t batch_requested = 0;
+static uint32_t batch_decoded = 0;
+static uint32_t batch_finalized = 0;
+
+// Baked texture formats the GL can sample (bit per TextureBakedFormat), queried once on the main thread
+static uint32_t baked_formats = 0;
+
+static GLuint upload_pbos[ASSETS_UPLOAD_PBOS];
+static uint32_t upload_pbo_next = 0;
+
+// ----------------------------------------------------------------------------
+// Worker side
+// ----------------------------------------------------------------------------
+
+// Read a whole file (packed or loose), null-terminated so text files can be used directly
+static unsigned char *read_whole_file(const char *path, size_t *size_out) {
+    unsigned char *data = vfs_read(path, size_out);
+    if (!data) fprintf(stderr, "[ASSETS] Could not read file %s\n", path);
+    return data;
+}
+
+// Decode an image from its file contents on the calling thread; grey and grey-alpha images are expanded to RGBA
+static bool decode_image_memory(AssetImage *image, const unsigned char *bytes, size_t size, const char *path, bool flip, int desired_channels) {
+    stbi_set_flip_vertically_on_load_thread(flip);
+
+    if (!desired_channels) {
+        int width, height, channels;
+        if (stbi_info_from_memory(bytes, (int)size, &width, &height, &channels) && channels < 3) desired_channels = 4;
+    }
+
+    image->pixels = stbi_load_from_memory(bytes, (int)size, &image->width, &image->height, &image->channels, desired_channels);
+    if (!image->pixels) {
+        fprintf(stderr, "[ASSETS] Failed to decode image %s: %s\n", path, stbi_failure_reason());
+        return false;
+    }
+    if (desired_channels) image->channels = desired_channels;
+    return true;
+}
+
+// Map the baked container next to an image instead of decoding it, when there is a usable one
+static bool map_baked_image(AssetImage *image, const char *path, bool flip) {
+    char baked_path[1024];
+    texture_baked_path(path, baked_path, sizeof(baked_path));
+    if (!vfs_open(&image->baked, baked_path)) return false;
+
+    const TextureBakedHeader *header = texture_baked_validate(image->baked.data, image->baked.size);
+    if (!header || ((header->flags & TEXTURE_BAKED_FLIPPED) != 0) != flip || !(baked_formats & (1u << header->format))) {
+        fprintf(stderr, "[ASSETS] Ignoring baked texture %s (invalid, other orientation or unsupported format)\n", baked_path);
+        vfs_close(&image->baked);
+        return false;
+    }
+
+    image->width = (int)header->width;
+    image->height = (int)header->height;
+    return true;
+}
+
+// Decoded straight from the pack (or the mapped loose file), no intermediate copy
+static bool decode_image_file(AssetImage *image, const char *path, bool flip, int desired_channels) {
+    VfsFile file;
+    if (!vfs_open(&file, path)) {
+        fprintf(stderr, "[ASSETS] Could not open image %s\n", path);
+        return false;
+    }
+
+    bool ok = decode_image_memory(image, file.data, file.size, path, flip, desired_channels);
+    vfs_close(&file);
+    return ok;
+}
+
+static bool decode_image(AssetImage *image, const char *path, bool flip, int desired_channels) {
+    return map_baked_image(image, path, flip) || decode_image_file(image, path, flip, desired_channels);
+}
+
+// Model textures are shared through the texture registry: a texture some model already uploaded (under the same
+// path, or with identical contents) is reused without decoding it again
+static bool decode_model_texture(AssetImage *image, const char *path, bool flip) {
+    char canonical_path[TEXTURE_PATH_MAX];
+    texture_path_canonical(path, canonical_path, sizeof(canonical_path));
+    image->canonical_path = strdup(canonical_path);
+    if (!image->canonical_path) return false;
+
+    image->texture_id = texture_registry_find(canonical_path, 0);
+    if (image->texture_id || map_baked_image(image, path, flip)) return true;
+
+    VfsFile file;
+    if (!vfs_open(&file, path)) {
+        fprintf(stderr, "[ASSETS] Could not open image %s\n", path);
+        return false;
+    }
+
+    image->content_hash = hash_bytes(file.data, file.size);
+    image->texture_id = texture_registry_find(canonical_path, image->content_hash);
+
+    bool ok = image->texture_id || decode_image_memory(image, file.data, file.size, path, flip, 0);
+    vfs_close(&file);
+    return ok;
+}
+
+// Same lookup as load_texture_from_gltf: URIs are relative to the model's directory
+static void model_texture_path(const char *model_path, const char *uri, char *dest, size_t dest_size) {
+    const char *last_slash = strrchr(model_path, '/');
+    if (last_slash) {
+        snprintf(dest, dest_size, "%.*s/%s", (int)(last_slash - model_path), model_path, uri);
+    } else {
+        snprintf(dest, dest_size, "./%s", uri);
+    }
+}
+
+// One image of a multi-image asset (cubemap face or model texture), decoded by its own job
+struct AssetPart {
+    Asset *asset;
+    uint32_t index;
+    char *path;
+};
+
+// The asset becomes decoded once its last job is done
+static void part_finished(Asset *asset, bool ok) {
+    mutex_lock(&queue_mutex);
+    if (!ok) asset->failed_part = true;
+    if (--asset->pending == 0) {
+        asset->status = asset->failed_part ? ASSET_FAILED : ASSET_DECODED;
+        batch_decoded++;
+    }
+    mutex_unlock(&queue_mutex);
+}
+
+static void decode_part_job(void *data) {
+    AssetPart *part = (AssetPart *)data;
+    Asset *asset = part->asset;
+
+    // Cubemap faces are uploaded as GL_RGBA, decode them as such
+    TRACE_BEGIN_DETAIL("Texture decode", part->path);
+    bool ok = asset->type == ASSET_MODEL
+        ? decode_model_texture(&asset->images[part->index], part->path, asset->flip)
+        : decode_image(&asset->images[part->index], part->path, asset->flip, 4);
+    TRACE_END();
+
+    // A missing model texture only loses that texture (the material falls back), a missing face fails the cubemap
+    part_finished(asset, ok || asset->type == ASSET_MODEL);
+}
+
+static void submit_part(AssetPart *part) {
+    // No workers, decode inline so the request still completes
+    if (!jobs_submit(decode_part_job, part)) decode_part_job(part);
+}
+
+// Texture URIs of the model, from the glTF images or from the baked / FBX material tables
+static uint32_t model_texture_uris(Asset *asset, const char ***uris_out) {
+    if (asset->gltf) {
+        cgltf_data *gltf = asset->gltf;
+        const char **uris = gltf->images_count ? malloc(gltf->images_count * sizeof(char *)) : NULL;
+        if (!uris) return 0;
+        for (size_t i = 0; i < gltf->images_count; i++) uris[i] = gltf->images[i].uri;
+        *uris_out = uris;
+        return (uint32_t)gltf->images_count;
+    }
+
+    uint32_t count = 0;
+    const char **uris = NULL;
+    if (asset->fbx) {
+        ufbx_scene *scene = asset->fbx;
+        uris = scene->materials.count ? malloc(scene->materials.count * 4 * sizeof(char *)) : NULL;
+        if (!uris) return 0;
+        for (size_t i = 0; i < scene->materials.count; i++) {
+            MaterialSource source;
+            model_fbx_material_source(scene->materials.data[i], &source);
+            const char *textures[4] = { source.diffuse_texture, source.normal_texture, source.occlusion_texture, source.emissive_texture };
+            for (int t = 0; t < 4; t++) {
+                if (textures[t]) uris[count++] = textures[t];
+            }
+        }
+    } else {
+        const MeshBakedHeader *header = mesh_baked_validate(asset->model->baked.data, asset->model->baked.size);
+        uint32_t max_uris = header ? header->material_count * 4 : 0;
+        uris = max_uris ? malloc(max_uris * sizeof(char *)) : NULL;
+        if (!uris) return 0;
+        count = model_baked_texture_uris(asset->model, uris, max_uris);
+    }
+
+    // Materials share textures, keep one job per file
+    uint32_t unique = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        bool seen = false;
+        for (uint32_t j = 0; j < unique && !seen; j++) seen = strcmp(uris[j], uris[i]) == 0;
+        if (!seen) uris[unique++] = uris[i];
+    }
+    *uris_out = uris;
+    return unique;
+}
+
+static bool decode_model(Asset *asset) {
+    // A baked copy is only mapped here, the glTF / FBX file is the fallback
+    char baked_path[1024];
+    model_baked_path(asset->paths[0], baked_path, sizeof(baked_path));
+    if (model_load_baked_geometry(asset->model, baked_path, asset->apply_parent_transform) < 0) {
+        int result = model_is_fbx(asset->paths[0])
+            ? model_load_fbx_geometry(asset->model, asset->paths[0], asset->apply_parent_transform, &asset->fbx)
+            : model_load_gltf_geometry(asset->model, asset->paths[0], asset->apply_parent_transform, &asset->gltf);
+        if (result < 0) return false;
+    }
+
+    // Every external image the materials can reference is decoded by its own job, the uploads happen on the main thread
+    const char **uris = NULL;
+    uint32_t uri_count = model_texture_uris(asset, &uris);
+    if (!uri_count) {
+        free(uris);
+        return true;
+    }
+
+    asset->images = calloc(uri_count, sizeof(AssetImage));
+    asset->parts = calloc(uri_count, sizeof(AssetPart));
+    if (!asset->images || !asset->parts) {
+        free(uris);
+        return false;
+    }
+    asset->image_count = uri_count;
+
+    uint32_t part_count = 0;
+    for (uint32_t i = 0; i < uri_count; i++) {
+        const char *uri = uris[i];
+        if (!uri || strncmp(uri, "data:", 5) == 0) continue;
+
+        char path[1024];
+        model_texture_path(asset->paths[0], uri, path, sizeof(path));
+
+        asset->images[i].uri = strdup(uri);
+        asset->parts[part_count++] = (AssetPart){ asset, i, strdup(path) };
+    }
+    asset->part_count = part_count;
+    free(uris);
+
+    mutex_lock(&queue_mutex);
+    asset->pending += part_count;
+    mutex_unlock(&queue_mutex);
+
+    for (uint32_t i = 0; i < part_count; i++) submit_part(&asset->parts[i]);
+    return true;
+}
+
+static void decode_job(void *data) {
+    Asset *asset = (Asset *)data;
+    bool ok = true;
+    TRACE_BEGIN_DETAIL("Asset decode", asset->paths[0]);
+
+    switch (asset->type) {
+        case ASSET_FILE:
+            asset->data = read_whole_file(asset->paths[0], &asset->size);
+            ok = asset->data != NULL;
+            break;
+
+        case ASSET_IMAGE:
+            asset->images = calloc(1, sizeof(AssetImage));
+            ok = asset->images != NULL;
+            if (ok) {
+                asset->image_count = 1;
+                ok = decode_image(&asset->images[0], asset->paths[0], asset->flip, 0);
+            }
+            break;
+
+        case ASSET_SHADER:
+            asset->sources[0] = (char *)read_whole_file(asset->paths[0], NULL);
+            asset->sources[1] = (char *)read_whole_file(asset->paths[1], NULL);
+            ok = asset->sources[0] && asset->sources[1];
+            break;
+
+        case ASSET_WAV: {
+            ALvoid *samples = NULL;
+            ALsizei size = 0;
+            ok = load_wav(asset->paths[0], &asset->format, &samples, &size, &asset->frequency);
+            asset->data = samples;
+            asset->size = (size_t)size;
+            break;
+        }
+
+        case ASSET_MODEL:
+            ok = decode_model(asset);
+            break;
+
+        default:
+            break;
+    }
+
+    TRACE_END();
+    part_finished(asset, ok);
+}
+
+// ----------------------------------------------------------------------------
+// Main thread side
+// ----------------------------------------------------------------------------
+
+static GLenum format_for_channels(int channels) {
+    switch (channels) {
+        case 1: return GL_RED;
+        case 2: return GL_RG;
+        case 3: return GL_RGB;
+        default: return GL_RGBA;
+    }
+}
+
+// Upload through a pixel unpack buffer: the copy into the mapped buffer is all the main thread pays,
+// the transfer into the texture happens asynchronously in the driver
+static void upload_image(GLenum target, const AssetImage *image) {
+    GLenum format = format_for_channels(image->channels);
+    size_t size = (size_t)image->width * image->height * image->channels;
+
+    GLint alignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    if (!upload_pbos[0]) glGenBuffers(ASSETS_UPLOAD_PBOS, upload_pbos);
+    GLuint pbo = upload_pbos[upload_pbo_next];
+    upload_pbo_next = (upload_pbo_next + 1) % ASSETS_UPLOAD_PBOS;
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)size, NULL, GL_STREAM_DRAW); // Orphan the previous upload
+    void *mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+    bool staged = false;
+    if (mapped) {
+        memcpy(mapped, image->pixels, size);
+        staged = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+    }
+
+    if (staged) {
+        glTexImage2D(target, 0, format, image->width, image->height, 0, format, GL_UNSIGNED_BYTE, (const void *)0);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    } else {
+        // Mapping failed, fall back to a plain client-memory upload
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glTexImage2D(target, 0, format, image->width, image->height, 0, format, GL_UNSIGNED_BYTE, image->pixels);
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+}
+
+// Baked faces share one immutable storage, so either all six are baked alike or none is used. A partly baked or
+// mismatched set falls back to decoding the sources of the baked faces here (slow, only happens while rebaking).
+static bool cubemap_prepare_faces(Asset *asset) {
+    const TextureBakedHeader *first = (const TextureBakedHeader *)asset->images[0].baked.data;
+    uint32_t baked_faces = 0;
+    bool alike = first != NULL;
+
+    for (uint32_t face = 0; face < 6; face++) {
+        const TextureBakedHeader *header = (const TextureBakedHeader *)asset->images[face].baked.data;
+        if (!header) {
+            alike = false;
+            continue;
+        }
+
+        baked_faces++;
+        if (first && (header->format != first->format || header->width != first->width ||
+                      header->height != first->height || header->level_count != first->level_count)) {
+            alike = false;
+        }
+    }
+    if (baked_faces == 0 || alike) return true;
+
+    fprintf(stderr, "[ASSETS] Cubemap faces are not baked alike, decoding their sources instead.\n");
+    for (uint32_t face = 0; face < 6; face++) {
+        AssetImage *image = &asset->images[face];
+        if (!image->baked.data) continue;
+
+        vfs_close(&image->baked);
+        if (!decode_image_file(image, asset->paths[face], asset->flip, 4)) return false;
+    }
+    return true;
+}
+
+// Issue the program's build, unless the same files or sources were built before: then it is shared (step 2)
+static void shader_begin(Asset *asset) {
+    asset->shader = resources_program_find(asset->paths[0], asset->paths[1], resources_source_hash(asset->sources[0], asset->sources[1]));
+    if (asset->shader.id) {
+        asset->finalize_step = 2;
+        return;
+    }
+    shader_build_begin(&asset->shader_build, asset->sources[0], asset->sources[1]);
+    asset->finalize_step = 1;
+}
+
+// Run one finalize step, returns true once the asset is complete
+static bool finalize_step(Asset *asset) {
+    switch (asset->type) {
+        case ASSET_IMAGE: {
+            // Same sampling as image_init
+            AssetImage *image = &asset->images[0];
+            glGenTextures(1, &asset->texture_id);
+            glBindTexture(GL_TEXTURE_2D, asset->texture_id);
+            if (image->baked.data) {
+                const TextureBakedHeader *header = (const TextureBakedHeader *)image->baked.data;
+                texture_baked_allocate(GL_TEXTURE_2D, header);
+                texture_baked_upload(GL_TEXTURE_2D, header);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, header->level_count > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+            } else {
+                upload_image(GL_TEXTURE_2D, image);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            }
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glBindTexture(GL_TEXTURE_2D, 0);
+
+            asset->width = image->width;
+            asset->height = image->height;
+            return true;
+        }
+
+        case ASSET_CUBEMAP: {
+            // One face per step
+            if (asset->finalize_step == 0) {
+                if (!cubemap_prepare_faces(asset)) {
+                    asset->status = ASSET_FAILED;
+                    return true;
+                }
+
+                // Baked faces upload into storage sized for their stored chain
+                const TextureBakedHeader *baked = (const TextureBakedHeader *)asset->images[0].baked.data;
+                glGenTextures(1, &asset->texture_id);
+                glBindTexture(GL_TEXTURE_CUBE_MAP, asset->texture_id);
+                if (baked) texture_baked_allocate(GL_TEXTURE_CUBE_MAP, baked);
+                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, baked && baked->level_count > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+            }
+            glBindTexture(GL_TEXTURE_CUBE_MAP, asset->texture_id);
+
+            uint32_t face = asset->finalize_step++;
+            AssetImage *image = &asset->images[face];
+            if (image->baked.data) {
+                texture_baked_upload(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, (const TextureBakedHeader *)image->baked.data);
+                vfs_close(&image->baked);
+            } else {
+                upload_image(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, image);
+                stbi_image_free(image->pixels);
+                image->pixels = NULL;
+            }
+
+            if (asset->finalize_step < 6) return false;
+
+            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+            glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+            asset->width = asset->images[0].width;
+            asset->height = asset->images[0].height;
+            return true;
+        }
+
+        case ASSET_SHADER: {
+            // Normally already issued by begin_shader_builds, the driver compiles while earlier assets finalize
+            if (asset->finalize_step == 0) shader_begin(asset);
+            if (asset->finalize_step == 2) return true; // Shared with an earlier user
+            if (!shader_build_ready(&asset->shader_build)) return false;
+
+            ShaderProgram built = shader_build_finish(&asset->shader_build);
+            if (built.id == 0) {
+                asset->status = ASSET_FAILED;
+                return true;
+            }
+            asset->shader = resources_program_add(asset->paths[0], asset->paths[1], resources_source_hash(asset->sources[0], asset->sources[1]), built);
+            return true;
+        }
+
+        case ASSET_MODEL: {
+            // One texture upload per step, the materials then find them in the texture registry
+            while (asset->finalize_step < asset->image_count) {
+                AssetImage *image = &asset->images[asset->finalize_step++];
+                if (!image->pixels && !image->baked.data) continue; // Failed, or already registered
+
+                GLuint texture_id;
+                size_t gpu_bytes;
+                glGenTextures(1, &texture_id);
+                glBindTexture(GL_TEXTURE_2D, texture_id);
+                if (image->baked.data) {
+                    // Stored mip chain, nothing to generate
+                    const TextureBakedHeader *header = (const TextureBakedHeader *)image->baked.data;
+                    texture_baked_allocate(GL_TEXTURE_2D, header);
+                    texture_baked_upload(GL_TEXTURE_2D, header);
+                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, header->level_count > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+                    gpu_bytes = texture_baked_gpu_bytes(header);
+                    vfs_close(&image->baked);
+                } else {
+                    upload_image(GL_TEXTURE_2D, image);
+                    glGenerateMipmap(GL_TEXTURE_2D);
+                    gpu_bytes = texture_gpu_bytes(image->width, image->height, image->channels, true);
+                    stbi_image_free(image->pixels);
+                    image->pixels = NULL;
+                }
+                glBindTexture(GL_TEXTURE_2D, 0);
+
+                image->texture_id = texture_registry_add(image->canonical_path, image->content_hash, texture_id, image->width, image->height, gpu_bytes);
+                return false;
+            }
+
+            if (asset->fbx) {
+                if (model_load_fbx_materials(asset->model, asset->fbx, asset->paths[0]) < 0) asset->status = ASSET_FAILED;
+                asset->fbx = NULL; // Freed by the material pass
+                return true;
+            }
+
+            if (!asset->gltf) {
+                char baked_path[1024];
+                model_baked_path(asset->paths[0], baked_path, sizeof(baked_path));
+                if (model_load_baked_materials(asset->model, baked_path) < 0) asset->status = ASSET_FAILED;
+                return true;
+            }
+
+            if (model_load_gltf_materials(asset->model, asset->gltf, asset->paths[0]) < 0) asset->status = ASSET_FAILED;
+            asset->gltf = NULL; // Freed by the material pass
+            return true;
+        }
+
+        case ASSET_WAV:
+            // Samples are uploaded once, every voice playing the clip shares the buffer
+            if (asset->clip_name) {
+                asset->clip = sound_bank_add(asset->clip_name, asset->format, asset->data, (ALsizei)asset->size, asset->frequency);
+                if (asset->clip < 0) asset->status = ASSET_FAILED;
+            }
+            return true;
+
+        default:
+            return true;
+    }
+}
+
+// Release everything the loader still owns for an asset
+static void asset_free(Asset *asset) {
+    for (int i = 0; i < 6; i++) free(asset->paths[i]);
+    free(asset->clip_name);
+    free(asset->data);
+    free(asset->sources[0]);
+    free(asset->sources[1]);
+
+    for (uint32_t i = 0; asset->images && i < asset->image_count; i++) {
+        stbi_image_free(asset->images[i].pixels);
+        vfs_close(&asset->images[i].baked);
+        free(asset->images[i].uri);
+        free(asset->images[i].canonical_path);
+        texture_registry_release(asset->images[i].texture_id); // The materials hold their own references
+    }
+    free(asset->images);
+
+    for (uint32_t i = 0; asset->parts && i < asset->part_count; i++) free(asset->parts[i].path);
+    free(asset->parts);
+
+    if (asset->gltf) cgltf_free(asset->gltf);
+    if (asset->fbx) ufbx_free_scene(asset->fbx);
+    shader_build_cancel(&asset->shader_build);
+    free(asset);
+}
+
+// ----------------------------------------------------------------------------
+// Public API
+// ----------------------------------------------------------------------------
+
+bool assets_init() {
+    if (initialized) return true;
+
+    if (jobs_worker_count() == 0) {
+        fprintf(stderr, "[ASSETS] The job system must be running before the asset loader!\n");
+        return false;
+    }
+
+    // Workers decide between a baked file and its source, they need to know what the GL can take
+    baked_formats = 0;
+    for (uint32_t format = 0; format < TEXTURE_BAKED_FORMAT_COUNT; format++) {
+        TextureBakedHeader header = { .format = format };
+        if (texture_baked_supported(&header)) baked_formats |= 1u << format;
+    }
+
+    mutex_init(&queue_mutex);
+    initialized = true;
+    return true;
+}
+
+void assets_shutdown() {
+    if (!initialized) return;
+
+    // Workers are stopped at this point, anything left over was never finalized
+    Asset *asset = queue_head;
+    while (asset) {
+        Asset *next = asset->next;
+        if (asset->texture_id) glDeleteTextures(1, &asset->texture_id);
+        asset_free(asset);
+        asset = next;
+    }
+    queue_head = queue_tail = NULL;
+
+    if (upload_pbos[0]) glDeleteBuffers(ASSETS_UPLOAD_PBOS, upload_pbos);
+    memset(upload_pbos, 0, sizeof(upload_pbos));
+
+    mutex_destroy(&queue_mutex);
+    initialized = false;
+}
+
+static Asset *asset_request(AssetType type, AssetCallback on_ready, void *user) {
+    if (!initialized) {
+        fprintf(stderr, "[ASSETS] Loader is not initialized!\n");
+        return NULL;
+    }
+
+    Asset *asset = calloc(1, sizeof(Asset));
+    if (!asset) {
+        fprintf(stderr, "[ASSETS] Failed to allocate an asset request!\n");
+        return NULL;
+    }
+    asset->type = type;
+    asset->status = ASSET_QUEUED;
+    asset->pending = 1;
+    asset->on_ready = on_ready;
+    asset->user = user;
+    return asset;
+}
+
+// Append to the finalize order and hand the decode to a worker
+static Asset *asset_submit(Asset *asset) {
+    if (!asset) return NULL;
+
+    mutex_lock(&queue_mutex);
+    if (!queue_head) batch_requested = batch_decoded = batch_finalized = 0;
+    batch_requested++;
+
+    if (queue_tail) queue_tail->next = asset;
+    else queue_head = asset;
+    queue_tail = asset;
+
+    if (asset->type == ASSET_BARRIER) {
+        asset->status = ASSET_DECODED;
+        batch_decoded++;
+    }
+    mutex_unlock(&queue_mutex);
+
+    if (asset->type == ASSET_CUBEMAP) {
+        // Each face is decoded in parallel
+        for (uint32_t face = 0; face < asset->part_count; face++) submit_part(&asset->parts[face]);
+    } else if (asset->type != ASSET_BARRIER && !jobs_submit(decode_job, asset)) {
+        // No workers, decode inline so the request still completes
+        decode_job(asset);
+    }
+    return asset;
+}
+
+Asset *assets_load_file(const char *path, AssetCallback on_ready, void *user) {
+    Asset *asset = asset_request(ASSET_FILE, on_ready, user);
+    if (!asset) return NULL;
+    asset->paths[0] = strdup(path);
+    return asset_submit(asset);
+}
+
+Asset *assets_load_image(const char *path, bool flip, AssetCallback on_ready, void *user) {
+    Asset *asset = asset_request(ASSET_IMAGE, on_ready, user);
+    if (!asset) return NULL;
+    asset->paths[0] = strdup(path);
+    asset->flip = flip;
+    return asset_submit(asset);
+}
+
+Asset *assets_load_cubemap(const char *faces[6], AssetCallback on_ready, void *user) {
+    Asset *asset = asset_request(ASSET_CUBEMAP, on_ready, user);
+    if (!asset) return NULL;
+
+    asset->images = calloc(6, sizeof(AssetImage));
+    asset->parts = calloc(6, sizeof(AssetPart));
+    if (!asset->images || !asset->parts) {
+        fprintf(stderr, "[ASSETS] Failed to allocate cubemap faces!\n");
+        asset_free(asset);
+        return NULL;
+    }
+
+    asset->image_count = asset->part_count = 6;
+    asset->pending = 6;
+    for (uint32_t i = 0; i < 6; i++) {
+        asset->paths[i] = strdup(faces[i]);
+        asset->parts[i] = (AssetPart){ asset, i, strdup(faces[i]) };
+    }
+    return asset_submit(asset);
+}
+
+Asset *assets_load_shader(const char *vertex_path, const char *fragment_path, AssetCallback on_ready, void *user) {
+    Asset *asset = asset_request(ASSET_SHADER, on_ready, user);
+    if (!asset) return NULL;
+    asset->paths[0] = strdup(vertex_path);
+    asset->paths[1] = strdup(fragment_path);
+    return asset_submit(asset);
+}
+
+Asset *assets_load_wav(const char *path, AssetCallback on_ready, void *user) {
+    Asset *asset = asset_request(ASSET_WAV, on_ready, user);
+    if (!asset) return NULL;
+    asset->paths[0] = strdup(path);
+    asset->clip = -1;
+    return asset_submit(asset);
+}
+
+Asset *assets_load_sound(const char *name, const char *path, AssetCallback on_ready, void *user) {
+    Asset *asset = asset_request(ASSET_WAV, on_ready, user);
+    if (!asset) return NULL;
+    asset->paths[0] = strdup(path);
+    asset->clip_name = strdup(name);
+    asset->clip = -1;
+    return asset_submit(asset);
+}
+
+Asset *assets_load_model(Model *model, const char *path, bool apply_parent_transform, AssetCallback on_ready, void *user) {
+    Asset *asset = asset_request(ASSET_MODEL, on_ready, user);
+    if (!asset) return NULL;
+    asset->paths[0] = strdup(path);
+    asset->model = model;
+    asset->apply_parent_transform = apply_parent_transform;
+    return asset_submit(asset);
+}
+
+Asset *assets_after(AssetCallback on_ready, void *user) {
+    return asset_submit(asset_request(ASSET_BARRIER, on_ready, user));
+}
+
+// Issue every decoded shader program at once instead of one per finalize, reading a status only happens when the
+// program's turn comes. Only the main thread unlinks assets, so the list can be walked with the lock held per step.
+static void begin_shader_builds() {
+    mutex_lock(&queue_mutex);
+    Asset *asset = queue_head;
+    mutex_unlock(&queue_mutex);
+
+    while (asset) {
+        mutex_lock(&queue_mutex);
+        AssetStatus status = asset->status;
+        Asset *next = asset->next;
+        mutex_unlock(&queue_mutex);
+
+        if (asset->type == ASSET_SHADER && status == ASSET_DECODED && asset->finalize_step == 0) shader_begin(asset);
+        asset = next;
+    }
+}
+
+void assets_update(double budget_ms) {
+    if (!initialized) return;
+
+    uint64_t start = clock_now_ns();
+    uint64_t budget_ns = (uint64_t)(budget_ms * 1000000.0);
+
+    begin_shader_builds();
+
+    for (;;) {
+        mutex_lock(&queue_mutex);
+        Asset *asset = queue_head;
+        AssetStatus status = asset ? asset->status : ASSET_QUEUED;
+        mutex_unlock(&queue_mutex);
+
+        // Strict request order: stop at the first asset still being decoded
+        if (!asset || status == ASSET_QUEUED) break;
+
+        TRACE_BEGIN_DETAIL("Asset finalize", asset->paths[0]);
+        bool done = status == ASSET_FAILED || finalize_step(asset);
+        TRACE_END();
+
+        // A program still compiling in the driver is collected next frame instead of stalling this one
+        if (!done && asset->type == ASSET_SHADER) break;
+
+        if (done) {
+            if (asset->status == ASSET_DECODED) asset->status = ASSET_READY;
+            if (asset->status == ASSET_FAILED) fprintf(stderr, "[ASSETS] Failed to load %s\n", asset->paths[0] ? asset->paths[0] : "(barrier)");
+
+            // The callback may queue more requests, unlink first
+            mutex_lock(&queue_mutex);
+            queue_head = asset->next;
+            if (!queue_head) queue_tail = NULL;
+            batch_finalized++;
+            mutex_unlock(&queue_mutex);
+
+            TRACE_BEGIN_DETAIL("Asset callback", asset->paths[0]);
+            if (asset->on_ready) asset->on_ready(asset, asset->user);
+            TRACE_END();
+            asset->texture_id = 0; // Owned by the callback now
+            asset_free(asset);
+        }
+
+        if (clock_now_ns() - start >= budget_ns) break;
+    }
+}
+
+float assets_progress() {
+    if (!initialized) return 1.0f;
+
+    mutex_lock(&queue_mutex);
+    float progress = batch_requested ? (float)(batch_decoded + batch_finalized) / (float)(batch_requested * 2) : 1.0f;
+    mutex_unlock(&queue_mutex);
+    return progress;
+}
+
+bool assets_idle() {
+    if (!initialized) return true;
+
+    mutex_lock(&queue_mutex);
+    bool idle = queue_head == NULL;
+    mutex_unlock(&queue_mutex);
+    return idle;
+}
@@ -1,119 +1,469 @@
 #include <loaders/obj.h>
+#include <io/vfs.h>
+#include <jobs/jobs.h>
+#include <jobs/trace.h>
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
 
-#include <cglm/cglm.h>
+#define OBJ_CHUNK_SIZE (1 << 20)  // Files are split into chunks of about this many bytes, parsed in parallel
+#define OBJ_MAX_CHUNKS 64
+#define OBJ_NONE 0xFFFFFFFFu      // Corner without a texcoord or normal
 
-int load_obj(const char *filename, StaticMesh *mesh) {
-    FILE *file = fopen(filename, "r");
-    if (!file) {
-        fprintf(stderr, "Could not open file: %s\n", filename);
-        return -1;
+// Relative (negative) index, resolved once the chunks before it are counted
+typedef struct {
+    size_t slot;       // Index in the chunk's corners
+    int64_t local;     // Element index counted from the chunk start, may be negative
+} ObjFixup;
+
+// One slice of the file, starting and ending on a line boundary
+typedef struct {
+    const char* begin;
+    const char* end;
+
+    float* positions;  // 3 per position
+    float* texcoords;  // 2 per texcoord
+    float* normals;    // 3 per normal
+    uint32_t* corners; // position, texcoord, normal index per triangle corner
+    ObjFixup* fixups;
+    size_t position_count, texcoord_count, normal_count, corner_count, fixup_count;
+    size_t position_capacity, texcoord_capacity, normal_capacity, corner_capacity, fixup_capacity;
+
+    bool failed;
+} ObjChunk;
+
+// Face corner while parsing, 0-based (negative = none), relative has one bit per attribute
+typedef struct {
+    int64_t index[3];
+    uint8_t relative;
+} ObjCorner;
+
+static const double powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static bool is_digit(char c) { return c >= '0' && c <= '9'; }
+static bool is_blank(char c) { return c == ' ' || c == '\t'; }
+
+static const char* skip_blank(const char* p, const char* end) {
+    while (p < end && is_blank(*p)) p++;
+    return p;
+}
+
+static const char* skip_line(const char* p, const char* end) {
+    const char* newline = memchr(p, '\n', (size_t)(end - p));
+    return newline ? newline + 1 : end;
+}
+
+static bool grow(void** data, size_t* capacity, size_t needed, size_t element_size) {
+    if (needed <= *capacity) return true;
+    size_t new_capacity = *capacity ? *capacity * 2 : 1024;
+    while (new_capacity < needed) new_capacity *= 2;
+    void* grown = realloc(*data, new_capacity * element_size);
+    if (!grown) return false;
+    *data = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+// Decimal float: mantissa gathered as an integer (19 significant digits), then scaled once by a power of ten.
+// Anything that is not a number (nan, inf, garbage) reads as 0.
+static const char* scan_float(const char* p, const char* end, float* out) {
+    p = skip_blank(p, end);
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+    bool any = false;
+    for (; p < end && is_digit(*p); p++) {
+        any = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            if (mantissa) digits++;
+        } else {
+            exponent++;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && is_digit(*p); p++) {
+            any = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                if (mantissa) digits++;
+                exponent--;
+            }
+        }
+    }
+    if (any && p < end && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        bool exponent_negative = false;
+        if (q < end && (*q == '-' || *q == '+')) exponent_negative = *q++ == '-';
+        if (q < end && is_digit(*q)) {
+            int value = 0;
+            for (; q < end && is_digit(*q); q++) {
+                if (value < 10000) value = value * 10 + (*q - '0');
+            }
+            exponent += exponent_negative ? -value : value;
+            p = q;
+        }
+    }
+
+    if (!any) {
+        while (p < end && !is_blank(*p) && *p != '\n' && *p != '\r') p++;
+        *out = 0.0f;
+        return p;
     }
 
-    size_t positions_size = 0;
-    size_t normals_size = 0;
-    size_t texcoords_size = 0;
-    size_t indices_size = 0;
-
-    char line[128];
-    while (fgets(line, sizeof(line), file)) {
-        if (strncmp(line, "v ", 2) == 0) {
-            positions_size++;
-        } else if (strncmp(line, "vn ", 3) == 0) {
-            normals_size++;
-        } else if (strncmp(line, "vt ", 3) == 0) {
-            texcoords_size++;
-        } else if (strncmp(line, "f ", 2) == 0) {
-            // We don't know the number of vertices per face, so count them dynamically
-            int vertex_count = 0;
-            char *token = strtok(line + 2, " ");
-            while (token != NULL) {
-                vertex_count++;
-                token = strtok(NULL, " ");
+    double value = (double)mantissa;
+    if (mantissa != 0) {
+        for (; exponent > 22; exponent -= 22) value *= 1e22;
+        for (; exponent < -22; exponent += 22) value /= 1e22;
+        value = exponent < 0 ? value / powers_of_ten[-exponent] : value * powers_of_ten[exponent];
+    }
+    *out = (float)(negative ? -value : value);
+    return p;
+}
+
+static const char* scan_floats(const char* p, const char* end, float* out, int count) {
+    for (int i = 0; i < count; i++) p = scan_float(p, end, &out[i]);
+    return p;
+}
+
+static const char* scan_int(const char* p, const char* end, int64_t* out) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+
+    int64_t value = 0;
+    for (; p < end && is_digit(*p); p++) {
+        if (value < INT64_MAX / 10) value = value * 10 + (*p - '0');
+    }
+    *out = negative ? -value : value;
+    return p;
+}
+
+static void emit_corner(ObjChunk* chunk, const ObjCorner* corner) {
+    if (!grow((void**)&chunk->corners, &chunk->corner_capacity, chunk->corner_count + 3, sizeof(uint32_t))) {
+        chunk->failed = true;
+        return;
+    }
+
+    for (int attribute = 0; attribute < 3; attribute++) {
+        size_t slot = chunk->corner_count++;
+        int64_t index = corner->index[attribute];
+
+        if (corner->relative & (1u << attribute)) {
+            if (!grow((void**)&chunk->fixups, &chunk->fixup_capacity, chunk->fixup_count + 1, sizeof(ObjFixup))) {
+                chunk->failed = true;
+                return;
             }
-            indices_size += vertex_count-1; // Triangulate the face
+            chunk->fixups[chunk->fixup_count++] = (ObjFixup){ slot, index };
+            chunk->corners[slot] = 0;
+        } else {
+            chunk->corners[slot] = index < 0 || index >= OBJ_NONE ? OBJ_NONE : (uint32_t)index;
+        }
+    }
+}
+
+// "f v/vt/vn ..." with vt and vn optional, any number of corners
+static const char* parse_face(ObjChunk* chunk, const char* p, const char* end) {
+    const size_t counts[3] = { chunk->position_count, chunk->texcoord_count, chunk->normal_count };
+    ObjCorner first = { { -1, -1, -1 }, 0 }, previous = first;
+    uint32_t corner_count = 0;
+
+    for (;;) {
+        p = skip_blank(p, end);
+        if (p >= end || *p == '\n' || *p == '\r' || *p == '#') break;
+
+        ObjCorner corner = { { -1, -1, -1 }, 0 };
+        for (int attribute = 0; attribute < 3; attribute++) {
+            if (attribute > 0) {
+                if (p >= end || *p != '/') break;
+                p++;
+            }
+            if (p >= end || !(is_digit(*p) || *p == '-' || *p == '+')) continue;
+
+            int64_t value;
+            p = scan_int(p, end, &value);
+            if (value > 0) {
+                corner.index[attribute] = value - 1;
+            } else if (value < 0) {
+                corner.index[attribute] = (int64_t)counts[attribute] + value;
+                corner.relative |= (uint8_t)(1u << attribute);
+            } else {
+                chunk->failed = true; // OBJ indices start at 1
+            }
+        }
+
+        // Skip whatever is left of a malformed corner
+        while (p < end && !is_blank(*p) && *p != '\n' && *p != '\r') p++;
+        if (corner.index[0] < 0 && !(corner.relative & 1u)) {
+            chunk->failed = true;
+            continue;
+        }
+
+        if (corner_count >= 2) {
+            emit_corner(chunk, &first);
+            emit_corner(chunk, &previous);
+            emit_corner(chunk, &corner);
+        }
+        if (corner_count == 0) first = corner;
+        previous = corner;
+        corner_count++;
+    }
+    return p;
+}
+
+static void parse_chunk(void* data, uint32_t index) {
+    ObjChunk* chunk = &((ObjChunk*)data)[index];
+    const char* p = chunk->begin;
+    const char* end = chunk->end;
+
+    while (p < end && !chunk->failed) {
+        p = skip_blank(p, end);
+        if (end - p >= 2 && p[0] == 'v' && is_blank(p[1])) {
+            if (!grow((void**)&chunk->positions, &chunk->position_capacity, (chunk->position_count + 1) * 3, sizeof(float))) break;
+            p = scan_floats(p + 2, end, &chunk->positions[chunk->position_count++ * 3], 3);
+        } else if (end - p >= 3 && p[0] == 'v' && p[1] == 't' && is_blank(p[2])) {
+            if (!grow((void**)&chunk->texcoords, &chunk->texcoord_capacity, (chunk->texcoord_count + 1) * 2, sizeof(float))) break;
+            p = scan_floats(p + 3, end, &chunk->texcoords[chunk->texcoord_count++ * 2], 2);
+        } else if (end - p >= 3 && p[0] == 'v' && p[1] == 'n' && is_blank(p[2])) {
+            if (!grow((void**)&chunk->normals, &chunk->normal_capacity, (chunk->normal_count + 1) * 3, sizeof(float))) break;
+            p = scan_floats(p + 3, end, &chunk->normals[chunk->normal_count++ * 3], 3);
+        } else if (end - p >= 2 && p[0] == 'f' && is_blank(p[1])) {
+            p = parse_face(chunk, p + 2, end);
+        }
+        // Comments, groups, materials, extra components (w, vertex colors)
+        p = skip_line(p, end);
+    }
+    if (p < end) chunk->failed = true;
+}
+
+static uint32_t hash_corner(const uint32_t* corner) {
+    uint32_t hash = corner[0] * 0x9E3779B1u;
+    hash ^= corner[1] * 0x85EBCA77u + (hash << 6) + (hash >> 2);
+    hash ^= corner[2] * 0xC2B2AE3Du + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+// Open addressing table of unique corners, slots hold vertex index + 1 (0 = empty)
+typedef struct {
+    uint32_t* slots;
+    size_t capacity;
+} CornerTable;
+
+static bool corner_table_grow(CornerTable* table, const uint32_t* keys, size_t vertex_count) {
+    size_t capacity = table->capacity ? table->capacity * 2 : 1024;
+    uint32_t* slots = calloc(capacity, sizeof(uint32_t));
+    if (!slots) return false;
+
+    for (size_t vertex = 0; vertex < vertex_count; vertex++) {
+        size_t slot = hash_corner(&keys[vertex * 3]) & (capacity - 1);
+        while (slots[slot]) slot = (slot + 1) & (capacity - 1);
+        slots[slot] = (uint32_t)vertex + 1;
+    }
+
+    free(table->slots);
+    table->slots = slots;
+    table->capacity = capacity;
+    return true;
+}
+
+static void free_chunks(ObjChunk* chunks, uint32_t chunk_count) {
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        free(chunks[i].positions);
+        free(chunks[i].texcoords);
+        free(chunks[i].normals);
+        free(chunks[i].corners);
+        free(chunks[i].fixups);
+    }
+    free(chunks);
+}
+
+// Resolve relative indices and check every corner against the attribute totals
+static bool resolve_corners(ObjChunk* chunks, uint32_t chunk_count, const size_t totals[3]) {
+    size_t bases[3] = { 0, 0, 0 };
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        ObjChunk* chunk = &chunks[i];
+        for (size_t f = 0; f < chunk->fixup_count; f++) {
+            const ObjFixup* fixup = &chunk->fixups[f];
+            int64_t index = (int64_t)bases[fixup->slot % 3] + fixup->local;
+            if (index < 0) return false;
+            chunk->corners[fixup->slot] = (uint32_t)index;
+        }
+        for (size_t c = 0; c < chunk->corner_count; c++) {
+            uint32_t index = chunk->corners[c];
+            if (c % 3 == 0 ? index >= totals[0] : index != OBJ_NONE && index >= totals[c % 3]) return false;
         }
+
+        bases[0] += chunk->position_count;
+        bases[1] += chunk->texcoord_count;
+        bases[2] += chunk->normal_count;
+    }
+    return true;
+}
+
+void free_obj(StaticMesh *mesh) {
+    if (!mesh) return;
+    free(mesh->positions);
+    free(mesh->normals);
+    free(mesh->texcoords);
+    free(mesh->indices);
+    memset(mesh, 0, sizeof(StaticMesh));
+}
+
+// Gather the chunks into one list per attribute, then dedupe the corners into the mesh's unified vertices
+static bool build_mesh(ObjChunk* chunks, uint32_t chunk_count, StaticMesh* mesh) {
+    size_t totals[3] = { 0, 0, 0 };
+    size_t corner_total = 0;
+    bool has_texcoords = false, has_normals = false;
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        totals[0] += chunks[i].position_count;
+        totals[1] += chunks[i].texcoord_count;
+        totals[2] += chunks[i].normal_count;
+        corner_total += chunks[i].corner_count / 3;
+    }
+    if (corner_total >= OBJ_NONE || totals[0] >= OBJ_NONE || totals[1] >= OBJ_NONE || totals[2] >= OBJ_NONE) return false;
+    if (!resolve_corners(chunks, chunk_count, totals)) {
+        fprintf(stderr, "[OBJ] Face index out of range\n");
+        return false;
+    }
+
+    float* positions = malloc(sizeof(float) * 3 * (totals[0] ? totals[0] : 1));
+    float* texcoords = malloc(sizeof(float) * 2 * (totals[1] ? totals[1] : 1));
+    float* normals = malloc(sizeof(float) * 3 * (totals[2] ? totals[2] : 1));
+    uint32_t* keys = malloc(sizeof(uint32_t) * 3 * (corner_total ? corner_total : 1));
+    mesh->indices = malloc(sizeof(unsigned int) * (corner_total ? corner_total : 1));
+    CornerTable table = { NULL, 0 };
+
+    bool ok = positions && texcoords && normals && keys && mesh->indices;
+    size_t offsets[3] = { 0, 0, 0 };
+    for (uint32_t i = 0; ok && i < chunk_count; i++) {
+        if (chunks[i].position_count) memcpy(positions + offsets[0] * 3, chunks[i].positions, sizeof(float) * 3 * chunks[i].position_count);
+        if (chunks[i].texcoord_count) memcpy(texcoords + offsets[1] * 2, chunks[i].texcoords, sizeof(float) * 2 * chunks[i].texcoord_count);
+        if (chunks[i].normal_count) memcpy(normals + offsets[2] * 3, chunks[i].normals, sizeof(float) * 3 * chunks[i].normal_count);
+        offsets[0] += chunks[i].position_count;
+        offsets[1] += chunks[i].texcoord_count;
+        offsets[2] += chunks[i].normal_count;
     }
 
-    // Allocate memory for data
-    mesh->positions = malloc(sizeof(float) * 3 * positions_size); // 3 floats per vertex
-    mesh->normals = malloc(sizeof(float) * 3 * normals_size);     // 3 floats per normal
-    mesh->texcoords = malloc(sizeof(float) * 2 * texcoords_size); // 2 floats per texture coordinate
-    mesh->indices = malloc(sizeof(unsigned int) * indices_size);  // Indices for faces
-
-    mesh->vertex_count = positions_size;
-    mesh->index_count = indices_size;
-    mesh->texcoords_count = texcoords_size;
-    mesh->normals_count = normals_size;
-
-    // Reset file pointer and parse the data
-    rewind(file);
-
-    size_t position_index = 0;
-    size_t normal_index = 0;
-    size_t texcoord_index = 0;
-    size_t index_index = 0;
-
-    while (fgets(line, sizeof(line), file)) {
-        if (strncmp(line, "v ", 2) == 0) {
-            // Parse position
-            float x, y, z;
-            sscanf(line, "v %f %f %f", &x, &y, &z);
-            mesh->positions[position_index * 3] = x;
-            mesh->positions[position_index * 3 + 1] = y;
-            mesh->positions[position_index * 3 + 2] = z;
-            position_index++;
-        } else if (strncmp(line, "vn ", 3) == 0) {
-            // Parse normal
-            float nx, ny, nz;
-            sscanf(line, "vn %f %f %f", &nx, &ny, &nz);
-            mesh->normals[normal_index * 3] = nx;
-            mesh->normals[normal_index * 3 + 1] = ny;
-            mesh->normals[normal_index * 3 + 2] = nz;
-            normal_index++;
-        } else if (strncmp(line, "vt ", 3) == 0) {
-            // Parse texture coordinate
-            float u, v;
-            sscanf(line, "vt %f %f", &u, &v);
-            mesh->texcoords[texcoord_index * 2] = u;
-            mesh->texcoords[texcoord_index * 2 + 1] = v;
-            texcoord_index++;
-        } else if (strncmp(line, "f ", 2) == 0) {
-            // Parse face (indices)
-            unsigned int p_idx[10], t_idx[10], n_idx[10];  // Max 10 vertices per face
-            int vertex_count = 0;
-            char *token = strtok(line + 2, " ");
-            while (token != NULL) {
-                int matched = sscanf(token, "%u/%u/%u", &p_idx[vertex_count], &t_idx[vertex_count], &n_idx[vertex_count]);
-                if (matched == 3) {
-                    vertex_count++;
-                }
-                token = strtok(NULL, " ");
+    size_t vertex_count = 0;
+    size_t index_count = 0;
+    for (uint32_t i = 0; ok && i < chunk_count; i++) {
+        for (size_t c = 0; ok && c < chunks[i].corner_count; c += 3) {
+            const uint32_t* corner = &chunks[i].corners[c];
+            if (vertex_count * 2 >= table.capacity && !corner_table_grow(&table, keys, vertex_count)) {
+                ok = false;
+                break;
             }
 
-            // Triangulate the face (if necessary)
-            for (int i = 1; i < vertex_count - 1; i++) {
-                // Indices
-                // mesh->indices[index_index++] = p_idx[0] - 1; // 1-based to 0-based index
-                // mesh->indices[index_index++] = p_idx[i] - 1;
-                // mesh->indices[index_index++] = p_idx[i + 1] - 1;
-
-                // // Texture coordinates
-                // mesh->texcoords[index_index - 3] = mesh->texcoords[(t_idx[0] - 1) * 2];
-                // mesh->texcoords[index_index - 2] = mesh->texcoords[(t_idx[i] - 1) * 2];
-                // mesh->texcoords[index_index - 1] = mesh->texcoords[(t_idx[i + 1] - 1) * 2];
-
-                // // Normals
-                // mesh->normals[index_index - 3] = mesh->normals[(n_idx[0] - 1) * 3];
-                // mesh->normals[index_index - 2] = mesh->normals[(n_idx[i] - 1) * 3];
-                // mesh->normals[index_index - 1] = mesh->normals[(n_idx[i + 1] - 1) * 3];
+            size_t slot = hash_corner(corner) & (table.capacity - 1);
+            while (table.slots[slot] && memcmp(&keys[(table.slots[slot] - 1) * 3], corner, sizeof(uint32_t) * 3) != 0) {
+                slot = (slot + 1) & (table.capacity - 1);
+            }
+            if (!table.slots[slot]) {
+                memcpy(&keys[vertex_count * 3], corner, sizeof(uint32_t) * 3);
+                has_texcoords |= corner[1] != OBJ_NONE;
+                has_normals |= corner[2] != OBJ_NONE;
+                table.slots[slot] = (uint32_t)++vertex_count;
             }
+            mesh->indices[index_count++] = table.slots[slot] - 1;
         }
     }
+    free(table.slots);
+
+    if (ok) {
+        mesh->positions = malloc(sizeof(float) * 3 * (vertex_count ? vertex_count : 1));
+        mesh->texcoords = has_texcoords ? malloc(sizeof(float) * 2 * vertex_count) : NULL;
+        mesh->normals = has_normals ? malloc(sizeof(float) * 3 * vertex_count) : NULL;
+        ok = mesh->positions && (!has_texcoords || mesh->texcoords) && (!has_normals || mesh->normals);
+    }
+
+    for (size_t vertex = 0; ok && vertex < vertex_count; vertex++) {
+        const uint32_t* key = &keys[vertex * 3];
+        memcpy(&mesh->positions[vertex * 3], &positions[key[0] * 3], sizeof(float) * 3);
+        if (has_texcoords) {
+            if (key[1] != OBJ_NONE) memcpy(&mesh->texcoords[vertex * 2], &texcoords[key[1] * 2], sizeof(float) * 2);
+            else memset(&mesh->texcoords[vertex * 2], 0, sizeof(float) * 2);
+        }
+        if (has_normals) {
+            if (key[2] != OBJ_NONE) memcpy(&mesh->normals[vertex * 3], &normals[key[2] * 3], sizeof(float) * 3);
+            else memset(&mesh->normals[vertex * 3], 0, sizeof(float) * 3);
+        }
+    }
+
+    free(positions);
+    free(texcoords);
+    free(normals);
+    free(keys);
+    if (!ok) {
+        fprintf(stderr, "[OBJ] Failed to allocate the mesh\n");
+        free_obj(mesh);
+        return false;
+    }
+
+    mesh->vertex_count = vertex_count;
+    mesh->index_count = index_count;
+    mesh->texcoords_count = has_texcoords ? vertex_count : 0;
+    mesh->normals_count = has_normals ? vertex_count : 0;
+    printf("[OBJ] %zu positions, %zu texcoords, %zu normals, %zu triangles -> %zu vertices\n",
+           totals[0], totals[1], totals[2], index_count / 3, vertex_count);
+    return true;
+}
+
+int load_obj(const char *filename, StaticMesh *mesh) {
+    memset(mesh, 0, sizeof(StaticMesh));
+
+    VfsFile file;
+    if (!vfs_open(&file, filename)) {
+        fprintf(stderr, "Could not open file: %s\n", filename);
+        return -1;
+    }
+
+    // Only worth splitting when there are workers to share the chunks with
+    const char* text = (const char*)file.data;
+    uint32_t chunk_count = 1;
+    if (jobs_worker_count() > 0) {
+        size_t chunks_by_size = file.size / OBJ_CHUNK_SIZE + 1;
+        chunk_count = chunks_by_size < OBJ_MAX_CHUNKS ? (uint32_t)chunks_by_size : OBJ_MAX_CHUNKS;
+    }
+
+    ObjChunk* chunks = calloc(chunk_count, sizeof(ObjChunk));
+    if (!chunks) {
+        vfs_close(&file);
+        return -1;
+    }
+
+    // Cut at even offsets, moved forward to the next line start
+    const char* end = text + file.size;
+    const char* begin = text;
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        const char* cut = i + 1 == chunk_count ? end : text + file.size / chunk_count * (i + 1);
+        if (cut < begin) cut = begin;
+        if (cut < end) cut = skip_line(cut, end);
+        chunks[i].begin = begin;
+        chunks[i].end = cut;
+        begin = cut;
+    }
+
+    TRACE_BEGIN_DETAIL("OBJ parse", filename);
+    jobs_parallel_for(chunk_count, parse_chunk, chunks);
+    TRACE_END();
+
+    bool ok = true;
+    for (uint32_t i = 0; i < chunk_count; i++) ok = ok && !chunks[i].failed;
+    if (!ok) fprintf(stderr, "[OBJ] Malformed or too large: %s\n", filename);
+    TRACE_BEGIN("OBJ build");
+    ok = ok && build_mesh(chunks, chunk_count, mesh);
+    TRACE_END();
 
-    fclose(file);
-    return 1;
-}
\ No newline at end of file
+    free_chunks(chunks, chunk_count);
+    vfs_close(&file);
+    return ok ? 1 : -1;
+}
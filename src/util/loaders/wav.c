@@ -4,118 +4,304 @@
 #include <stdbool.h>
 #include <AL/al.h>
 #include <string.h>
+#include <math.h>
+#include <io/vfs.h>
+#include <wav.h>
 
-bool load_wav(const char* filename, ALenum* format, ALvoid** data, ALsizei* size, ALsizei* freq) {
-    FILE* file = fopen(filename, "rb");
-    if (!file) {
-        fprintf(stderr, "Failed to open WAV file: %s\n", filename);
-        return false;
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define WAV_SSE2 1
+#endif
+#if defined(__SSSE3__) || defined(__AVX__)
+	#include <tmmintrin.h>
+	#define WAV_SSSE3 1
+#endif
+
+#define WAV_FORMAT_PCM 1
+#define WAV_FORMAT_FLOAT 3
+#define WAV_FORMAT_EXTENSIBLE 0xFFFE
+#define WAV_BLOCK_FRAMES 4096 // Frames converted per pass, keeps the scratch buffer small
+
+static uint16_t read_u16(const unsigned char* p) { return (uint16_t)(p[0] | p[1] << 8); }
+static uint32_t read_u32(const unsigned char* p) { return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24; }
+
+// Four printable characters, as every chunk id is
+static bool is_chunk_id(const unsigned char* p) {
+    for (int i = 0; i < 4; i++) {
+        if (p[i] < 0x20 || p[i] > 0x7E) return false;
     }
+    return true;
+}
 
-    // Read WAV header
-    char chunk_id[4];
-    uint32_t chunk_size;
-    char format_type[4];
+bool wav_parse(const unsigned char* data, size_t size, WavInfo* info) {
+    memset(info, 0, sizeof(WavInfo));
+    if (size < 12 || memcmp(data, "RIFF", 4) != 0 || memcmp(data + 8, "WAVE", 4) != 0) return false;
 
-    fread(chunk_id, 1, 4, file);
-    fread(&chunk_size, 4, 1, file);
-    fread(format_type, 1, 4, file);
+    bool has_format = false;
+    size_t position = 12;
+    while (size - position >= 8) {
+        const unsigned char* chunk = data + position;
+        uint32_t chunk_size = read_u32(chunk + 4);
+        size_t available = size - position - 8;
+        size_t body_size = chunk_size < available ? chunk_size : available; // Truncated files keep what is there
 
-    if (strncmp(chunk_id, "RIFF", 4) != 0 || strncmp(format_type, "WAVE", 4) != 0) {
-        fprintf(stderr, "Invalid WAV file format\n");
-        fclose(file);
-        return false;
+        if (memcmp(chunk, "fmt ", 4) == 0 && body_size >= 16) {
+            info->audio_format = read_u16(chunk + 8);
+            info->num_channels = read_u16(chunk + 10);
+            info->sample_rate = read_u32(chunk + 12);
+            info->block_align = read_u16(chunk + 20);
+            info->bits_per_sample = read_u16(chunk + 22);
+
+            // WAVE_FORMAT_EXTENSIBLE: the real format is the first two bytes of the sub-format GUID
+            if (info->audio_format == WAV_FORMAT_EXTENSIBLE && body_size >= 40) info->audio_format = read_u16(chunk + 32);
+            has_format = true;
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            info->samples = chunk + 8;
+            info->samples_size = body_size;
+        }
+
+        // Chunks are padded to an even size, some writers forget the pad byte
+        size_t step = 8 + (size_t)chunk_size + (chunk_size & 1);
+        // Both candidate ids must be inside the buffer, anything shorter cannot hold another chunk header anyway
+        if ((chunk_size & 1) && step + 4 <= size - position && !is_chunk_id(chunk + step) && is_chunk_id(chunk + step - 1)) step--;
+        if (step > size - position) break;
+        position += step;
     }
 
-    // Read "fmt " subchunk
-    char subchunk1_id[4];
-    uint32_t subchunk1_size;
-    uint16_t audio_format;
-    uint16_t num_channels;
-    uint32_t sample_rate;
-    uint32_t byte_rate;
-    uint16_t block_align;
-    uint16_t bits_per_sample;
-
-    fread(subchunk1_id, 1, 4, file);
-    fread(&subchunk1_size, 4, 1, file);
-    fread(&audio_format, 2, 1, file);
-    fread(&num_channels, 2, 1, file);
-    fread(&sample_rate, 4, 1, file);
-    fread(&byte_rate, 4, 1, file);
-    fread(&block_align, 2, 1, file);
-    fread(&bits_per_sample, 2, 1, file);
-
-    if (strncmp(subchunk1_id, "fmt ", 4) != 0) {
-        fprintf(stderr, "Invalid fmt chunk in WAV file\n");
-        fclose(file);
-        return false;
+    if (!has_format || !info->samples || info->num_channels == 0 || info->sample_rate == 0) return false;
+    if (info->bits_per_sample == 0 || info->block_align == 0) return false;
+    if (info->block_align != info->num_channels * ((info->bits_per_sample + 7) / 8)) return false;
+    info->samples_size -= info->samples_size % info->block_align;
+    return true;
+}
+
+bool wav_supported(const WavInfo* info) {
+    if (info->audio_format == WAV_FORMAT_PCM) {
+        return info->bits_per_sample == 8 || info->bits_per_sample == 16 || info->bits_per_sample == 24 || info->bits_per_sample == 32;
     }
+    return info->audio_format == WAV_FORMAT_FLOAT && info->bits_per_sample == 32;
+}
 
-    // Check for PCM format
-    if (audio_format != 1) {
-        fprintf(stderr, "Non-PCM WAV files are not supported\n");
-        fclose(file);
-        return false;
+// ----------------------------------------------------------------------------
+// Conversion kernels, SSE2 (SSSE3 for 24-bit) with scalar tails and fallbacks
+// ----------------------------------------------------------------------------
+
+static void convert_u8(const unsigned char* src, size_t count, int16_t* dest) {
+    size_t i = 0;
+#ifdef WAV_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    for (; i + 16 <= count; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i low = _mm_slli_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(bytes, zero), bias), 8);
+        __m128i high = _mm_slli_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(bytes, zero), bias), 8);
+        _mm_storeu_si128((__m128i*)(dest + i), low);
+        _mm_storeu_si128((__m128i*)(dest + i + 8), high);
+    }
+#endif
+    for (; i < count; i++) dest[i] = (int16_t)((src[i] - 128) * 256);
+}
+
+// Keep the top 16 bits of each little-endian 24-bit sample
+static void convert_s24(const unsigned char* src, size_t count, int16_t* dest) {
+    size_t i = 0;
+#ifdef WAV_SSSE3
+    // 16 source bytes hold 5 samples, take 4 per step (reading 12 of them)
+    const __m128i shuffle = _mm_setr_epi8(1, 2, 4, 5, 7, 8, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1);
+    for (; i + 6 <= count; i += 4) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(src + i * 3));
+        _mm_storel_epi64((__m128i*)(dest + i), _mm_shuffle_epi8(bytes, shuffle));
     }
+#endif
+    for (; i < count; i++) dest[i] = (int16_t)(uint16_t)(src[i * 3 + 1] | src[i * 3 + 2] << 8);
+}
 
-    // Set OpenAL format to mono, regardless of the original number of channels
-    *format = (bits_per_sample == 8) ? AL_FORMAT_MONO8 : AL_FORMAT_MONO16;
+static void convert_s32(const unsigned char* src, size_t count, int16_t* dest) {
+    size_t i = 0;
+#ifdef WAV_SSE2
+    for (; i + 8 <= count; i += 8) {
+        __m128i a = _mm_srai_epi32(_mm_loadu_si128((const __m128i*)(src + i * 4)), 16);
+        __m128i b = _mm_srai_epi32(_mm_loadu_si128((const __m128i*)(src + i * 4 + 16)), 16);
+        _mm_storeu_si128((__m128i*)(dest + i), _mm_packs_epi32(a, b));
+    }
+#endif
+    for (; i < count; i++) {
+        int32_t sample;
+        memcpy(&sample, src + i * 4, 4);
+        dest[i] = (int16_t)(sample >> 16);
+    }
+}
 
-    *freq = sample_rate;
+static void convert_f32(const unsigned char* src, size_t count, int16_t* dest) {
+    size_t i = 0;
+#ifdef WAV_SSE2
+    // Clamped to -1..1 before scaling, cvtps turns anything out of int32 range (and NaN) into INT_MIN
+    const __m128 scale = _mm_set1_ps(32767.0f), one = _mm_set1_ps(1.0f), minus_one = _mm_set1_ps(-1.0f);
+    for (; i + 8 <= count; i += 8) {
+        __m128i a = _mm_cvtps_epi32(_mm_mul_ps(_mm_max_ps(_mm_min_ps(_mm_loadu_ps((const float*)(src + i * 4)), one), minus_one), scale));
+        __m128i b = _mm_cvtps_epi32(_mm_mul_ps(_mm_max_ps(_mm_min_ps(_mm_loadu_ps((const float*)(src + i * 4 + 16)), one), minus_one), scale));
+        _mm_storeu_si128((__m128i*)(dest + i), _mm_packs_epi32(a, b));
+    }
+#endif
+    for (; i < count; i++) {
+        float sample;
+        memcpy(&sample, src + i * 4, 4);
+        // Same operand order as minps / maxps, so NaN also ends up at 1
+        sample = sample < 1.0f ? sample : 1.0f;
+        sample = sample > -1.0f ? sample : -1.0f;
+        dest[i] = (int16_t)lrintf(sample * 32767.0f); // Rounds like cvtps
+    }
+}
 
-    // Read "data" subchunk
-    char subchunk2_id[4];
-    uint32_t subchunk2_size;
+void wav_convert_s16(const WavInfo* info, const unsigned char* src, size_t frames, int16_t* dest) {
+    size_t count = frames * info->num_channels;
+    if (info->audio_format == WAV_FORMAT_FLOAT) convert_f32(src, count, dest);
+    else if (info->bits_per_sample == 8) convert_u8(src, count, dest);
+    else if (info->bits_per_sample == 24) convert_s24(src, count, dest);
+    else if (info->bits_per_sample == 32) convert_s32(src, count, dest);
+    else memcpy(dest, src, count * sizeof(int16_t));
+}
 
-    while (fread(subchunk2_id, 1, 4, file)) {
-        fread(&subchunk2_size, 4, 1, file);
-        if (strncmp(subchunk2_id, "data", 4) == 0) {
-            break;
+void wav_downmix_s16(const int16_t* src, size_t frames, int channels, int16_t* dest) {
+    size_t i = 0;
+    if (channels == 1) {
+        memmove(dest, src, frames * sizeof(int16_t));
+        return;
+    }
+    if (channels == 2) {
+#ifdef WAV_SSE2
+        // madd sums each left/right pair into 32 bits, so the average cannot overflow
+        const __m128i ones = _mm_set1_epi16(1);
+        for (; i + 8 <= frames; i += 8) {
+            __m128i a = _mm_srai_epi32(_mm_madd_epi16(_mm_loadu_si128((const __m128i*)(src + i * 2)), ones), 1);
+            __m128i b = _mm_srai_epi32(_mm_madd_epi16(_mm_loadu_si128((const __m128i*)(src + i * 2 + 8)), ones), 1);
+            _mm_storeu_si128((__m128i*)(dest + i), _mm_packs_epi32(a, b));
         }
-        fseek(file, subchunk2_size, SEEK_CUR); // Skip non-"data" chunks
+#endif
+        for (; i < frames; i++) dest[i] = (int16_t)((src[i * 2] + src[i * 2 + 1]) >> 1);
+        return;
     }
 
-    if (strncmp(subchunk2_id, "data", 4) != 0) {
-        fprintf(stderr, "No data chunk found in WAV file\n");
-        fclose(file);
-        return false;
+    // Surround layouts are rare in game audio, a plain average is enough
+    for (; i < frames; i++) {
+        int32_t sum = 0;
+        for (int c = 0; c < channels; c++) sum += src[i * channels + c];
+        dest[i] = (int16_t)(sum / channels);
     }
+}
 
-    // Allocate memory for audio data and read it
-    *size = subchunk2_size;
-    *data = malloc(subchunk2_size);
-    if (!*data) {
-        fprintf(stderr, "Failed to allocate memory for WAV data\n");
-        fclose(file);
-        return false;
+size_t wav_resampled_frames(size_t frames, uint32_t src_rate, uint32_t dst_rate) {
+    return frames ? (size_t)(((uint64_t)frames * dst_rate + src_rate - 1) / src_rate) : 0;
+}
+
+void wav_resample_s16(const int16_t* src, size_t frames, uint32_t src_rate, uint32_t dst_rate, int16_t* dest) {
+    // Linear interpolation, positions in 32.32 fixed point
+    size_t out_frames = wav_resampled_frames(frames, src_rate, dst_rate);
+    uint64_t step = ((uint64_t)src_rate << 32) / dst_rate;
+    uint64_t position = 0;
+    size_t i = 0;
+#ifdef WAV_SSE2
+    // The loads are a gather, the blend runs four outputs at a time
+    const __m128 inverse = _mm_set1_ps(1.0f / 4294967296.0f);
+    for (; i + 4 <= out_frames; i += 4) {
+        int32_t a[4], b[4];
+        float t[4];
+        for (int k = 0; k < 4; k++) {
+            size_t index = (size_t)(position >> 32);
+            size_t next = index + 1 < frames ? index + 1 : frames - 1;
+            a[k] = src[index];
+            b[k] = src[next];
+            t[k] = (float)(uint32_t)position;
+            position += step;
+        }
+        __m128 va = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)a));
+        __m128 vb = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)b));
+        __m128 vt = _mm_mul_ps(_mm_loadu_ps(t), inverse);
+        __m128i mixed = _mm_cvtps_epi32(_mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), vt)));
+        _mm_storel_epi64((__m128i*)(dest + i), _mm_packs_epi32(mixed, mixed));
+    }
+#endif
+    for (; i < out_frames; i++) {
+        size_t index = (size_t)(position >> 32);
+        size_t next = index + 1 < frames ? index + 1 : frames - 1;
+        float t = (float)(uint32_t)position / 4294967296.0f;
+        dest[i] = (int16_t)lrintf(src[index] + (src[next] - src[index]) * t); // Rounds like cvtps
+        position += step;
     }
+}
+
+bool wav_decode_mono(const WavInfo* info, uint32_t target_rate, int16_t** samples, size_t* frames) {
+    *samples = NULL;
+    *frames = 0;
+    if (!wav_supported(info)) return false;
 
-    fread(*data, 1, subchunk2_size, file);
-    fclose(file);
+    size_t frame_count = info->samples_size / info->block_align;
+    int16_t* mono = malloc((frame_count ? frame_count : 1) * sizeof(int16_t));
+    int16_t* scratch = malloc((size_t)WAV_BLOCK_FRAMES * info->num_channels * sizeof(int16_t));
+    if (!mono || !scratch) {
+        free(mono);
+        free(scratch);
+        return false;
+    }
 
-    // If the file was stereo, downmix it to mono
-    if (num_channels == 2) {
-        int16_t* stereo_data = (int16_t*)*data;
-        int16_t* mono_data = (int16_t*)malloc(*size / 2); // Mono data will be half the size of stereo data
+    // Convert then downmix a block at a time, the interleaved copy never exists in full
+    for (size_t done = 0; done < frame_count; done += WAV_BLOCK_FRAMES) {
+        size_t count = frame_count - done < WAV_BLOCK_FRAMES ? frame_count - done : WAV_BLOCK_FRAMES;
+        wav_convert_s16(info, info->samples + done * info->block_align, count, scratch);
+        wav_downmix_s16(scratch, count, info->num_channels, mono + done);
+    }
+    free(scratch);
 
-        if (!mono_data) {
-            fprintf(stderr, "Failed to allocate memory for downmixed data\n");
-            free(*data);
+    if (target_rate && target_rate != info->sample_rate && frame_count) {
+        size_t resampled_count = wav_resampled_frames(frame_count, info->sample_rate, target_rate);
+        int16_t* resampled = malloc(resampled_count * sizeof(int16_t));
+        if (!resampled) {
+            free(mono);
             return false;
         }
+        wav_resample_s16(mono, frame_count, info->sample_rate, target_rate, resampled);
+        free(mono);
+        mono = resampled;
+        frame_count = resampled_count;
+    }
 
-        size_t num_samples = *size / sizeof(int16_t);
-        for (size_t i = 0, j = 0; i < num_samples; i += 2, ++j) {
-            // Average left and right channels to create mono data
-            mono_data[j] = (stereo_data[i] + stereo_data[i + 1]) / 2;
-        }
+    *samples = mono;
+    *frames = frame_count;
+    return true;
+}
 
-        // Free the original stereo data and point to the mono data
-        free(*data);
-        *data = mono_data;
-        *size = *size / 2;  // Update size for mono data
+bool load_wav(const char* filename, ALenum* format, ALvoid** data, ALsizei* size, ALsizei* freq) {
+    VfsFile view;
+    if (!vfs_open(&view, filename)) {
+        fprintf(stderr, "Failed to open WAV file: %s\n", filename);
+        return false;
+    }
+
+    WavInfo info;
+    if (!wav_parse(view.data, view.size, &info)) {
+        fprintf(stderr, "Invalid WAV file format: %s\n", filename);
+        vfs_close(&view);
+        return false;
+    }
+    if (!wav_supported(&info)) {
+        fprintf(stderr, "Unsupported WAV encoding (format %u, %u bits): %s\n", info.audio_format, info.bits_per_sample, filename);
+        vfs_close(&view);
+        return false;
+    }
+
+    // Mono so OpenAL can position it, whatever the original channel count and sample format
+    int16_t* samples;
+    size_t frames;
+    bool ok = wav_decode_mono(&info, 0, &samples, &frames);
+    vfs_close(&view);
+    if (!ok) {
+        fprintf(stderr, "Failed to allocate memory for WAV data\n");
+        return false;
     }
 
+    *format = AL_FORMAT_MONO16;
+    *data = samples;
+    *size = (ALsizei)(frames * sizeof(int16_t));
+    *freq = (ALsizei)info.sample_rate;
     return true;
-}
\ No newline at end of file
+}
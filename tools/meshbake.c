@@ -0,0 +1,240 @@
+// Offline mesh baker.
+// Loads glTF and FBX models with the engine's own loaders (same attribute conversion, bounds and node transforms) and
+// writes .lmesh containers (see entities/mesh_baked.h) next to them: interleaved vertices and 16/32-bit indices
+// laid out exactly as the GL buffers expect them, so the game maps the file and uploads it without parsing.
+//
+// Usage: lwlaim_meshbake [-o output] input.gltf|input.fbx...
+//   -o   output path (single input only), by default the input with its extension replaced by .lmesh
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <entities/model.h>
+#include <entities/mesh_baked.h>
+#include <cgltf.h>
+#include <loaders/ufbx.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Growable byte buffer for one section of the file
+typedef struct {
+    unsigned char* data;
+    size_t size;
+    size_t capacity;
+} Section;
+
+static bool section_reserve(Section* section, size_t size) {
+    if (section->size + size <= section->capacity) return true;
+
+    size_t capacity = section->capacity ? section->capacity : 4096;
+    while (capacity < section->size + size) capacity *= 2;
+    unsigned char* data = realloc(section->data, capacity);
+    if (!data) return false;
+
+    section->data = data;
+    section->capacity = capacity;
+    return true;
+}
+
+static bool section_append(Section* section, const void* data, size_t size) {
+    if (!section_reserve(section, size)) return false;
+    memcpy(section->data + section->size, data, size);
+    section->size += size;
+    return true;
+}
+
+static bool section_align(Section* section) {
+    size_t padding = (MESH_BAKED_ALIGNMENT - section->size % MESH_BAKED_ALIGNMENT) % MESH_BAKED_ALIGNMENT;
+    if (!section_reserve(section, padding)) return false;
+    memset(section->data + section->size, 0, padding);
+    section->size += padding;
+    return true;
+}
+
+// Offset of a string in the table, identical strings are stored once (offset 0 is the empty string)
+static uint32_t string_add(Section* strings, const char* value) {
+    if (!value || !value[0]) return 0;
+
+    size_t length = strlen(value) + 1;
+    for (size_t offset = 1; offset + length <= strings->size; offset += strlen((const char*)strings->data + offset) + 1) {
+        if (memcmp(strings->data + offset, value, length) == 0) return (uint32_t)offset;
+    }
+
+    uint32_t offset = (uint32_t)strings->size;
+    return section_append(strings, value, length) ? offset : 0;
+}
+
+// Embedded images are not baked (the material falls back)
+static uint32_t texture_add(Section* strings, const char* uri) {
+    if (!uri) return 0;
+    if (strncmp(uri, "data:", 5) == 0) {
+        printf("Warning: embedded image skipped, use an external file to bake it.\n");
+        return 0;
+    }
+    return string_add(strings, uri);
+}
+
+static bool write_mesh(const Mesh* mesh, MeshBakedMesh* baked, Section* vertices, Section* indices) {
+    baked->vertex_count = mesh->vertex_count;
+    baked->vertex_offset = vertices->size;
+    if (mesh->normals) baked->flags |= MESH_BAKED_HAS_NORMALS;
+    if (mesh->texcoords) baked->flags |= MESH_BAKED_HAS_TEXCOORDS;
+
+    // Missing attributes are zero, the drawable reads all three from the interleaved stream
+    for (uint32_t i = 0; i < mesh->vertex_count; i++) {
+        MeshBakedVertex vertex = {0};
+        memcpy(vertex.position, &mesh->vertices[i * 3], sizeof(vertex.position));
+        if (mesh->normals) memcpy(vertex.normal, &mesh->normals[i * 3], sizeof(vertex.normal));
+        if (mesh->texcoords) memcpy(vertex.texcoord, &mesh->texcoords[i * 2], sizeof(vertex.texcoord));
+        if (!section_append(vertices, &vertex, sizeof(vertex))) return false;
+    }
+
+    if (mesh->indices) {
+        // Half the index bandwidth whenever the vertices fit
+        baked->index_count = mesh->index_count;
+        baked->index_size = mesh->vertex_count <= 0xFFFF ? 2 : 4;
+        baked->index_offset = indices->size;
+        for (uint32_t i = 0; i < mesh->index_count; i++) {
+            uint16_t short_index = (uint16_t)mesh->indices[i];
+            bool ok = baked->index_size == 2 ? section_append(indices, &short_index, sizeof(short_index))
+                                             : section_append(indices, &mesh->indices[i], sizeof(uint32_t));
+            if (!ok) return false;
+        }
+        if (!section_align(indices)) return false;
+    }
+
+    memcpy(baked->min_bound, mesh->min_bound, sizeof(baked->min_bound));
+    memcpy(baked->max_bound, mesh->max_bound, sizeof(baked->max_bound));
+
+    // Node transform, used when the game applies parent transforms
+    baked->flags |= MESH_BAKED_HAS_NODE;
+    memcpy(baked->translation, mesh->position, sizeof(baked->translation));
+    memcpy(baked->rotation, mesh->rotation, sizeof(baked->rotation));
+    memcpy(baked->scale, mesh->scale, sizeof(baked->scale));
+    return true;
+}
+
+static bool bake(const char* input, const char* output) {
+    Model* model = calloc(1, sizeof(Model));
+    cgltf_data* gltf = NULL;
+    ufbx_scene* fbx = NULL;
+    bool loaded = model && (model_is_fbx(input) ? model_load_fbx_geometry(model, input, true, &fbx)
+                                                : model_load_gltf_geometry(model, input, true, &gltf)) >= 0;
+    if (!loaded) {
+        fprintf(stderr, "Failed to load %s\n", input);
+        free(model);
+        return false;
+    }
+
+    uint32_t material_count = fbx ? (uint32_t)fbx->materials.count : (uint32_t)gltf->materials_count;
+    MeshBakedHeader header = {
+        .magic = MESH_BAKED_MAGIC,
+        .version = MESH_BAKED_VERSION,
+        .mesh_count = model->mesh_count,
+        .material_count = material_count
+    };
+    MeshBakedMesh* meshes = calloc(model->mesh_count ? model->mesh_count : 1, sizeof(MeshBakedMesh));
+    MeshBakedMaterial* materials = calloc(material_count ? material_count : 1, sizeof(MeshBakedMaterial));
+    Section vertices = {0}, indices = {0}, strings = {0};
+    bool ok = meshes && materials && section_append(&strings, "", 1);
+
+    // The material table is stored as is, meshes keep their index into it
+    for (uint32_t i = 0; ok && i < model->mesh_count; i++) {
+        uint32_t material = model->meshes[i]->material_index;
+        meshes[i].name = string_add(&strings, model->meshes[i]->name);
+        meshes[i].material = material == MESH_NO_MATERIAL ? MESH_BAKED_NO_MATERIAL : material;
+        ok = write_mesh(model->meshes[i], &meshes[i], &vertices, &indices);
+    }
+
+    // Same texture choice as the runtime material passes
+    for (uint32_t i = 0; ok && i < material_count; i++) {
+        MaterialSource source;
+        if (fbx) model_fbx_material_source(fbx->materials.data[i], &source);
+        else model_gltf_material_source(&gltf->materials[i], &source);
+
+        MeshBakedMaterial* material = &materials[i];
+        material->diffuse_texture = texture_add(&strings, source.diffuse_texture);
+        material->normal_texture = texture_add(&strings, source.normal_texture);
+        material->occlusion_texture = texture_add(&strings, source.occlusion_texture);
+        material->emissive_texture = texture_add(&strings, source.emissive_texture);
+        memcpy(material->emissive_color, source.emissive_color, sizeof(material->emissive_color));
+    }
+
+    // Header and tables, then each block on an aligned offset
+    uint64_t tables = sizeof(MeshBakedHeader) + (uint64_t)header.mesh_count * sizeof(MeshBakedMesh) +
+                      (uint64_t)header.material_count * sizeof(MeshBakedMaterial);
+    header.vertex_offset = (tables + MESH_BAKED_ALIGNMENT - 1) / MESH_BAKED_ALIGNMENT * MESH_BAKED_ALIGNMENT;
+    header.vertex_size = vertices.size;
+    header.index_offset = (header.vertex_offset + vertices.size + MESH_BAKED_ALIGNMENT - 1) / MESH_BAKED_ALIGNMENT * MESH_BAKED_ALIGNMENT;
+    header.index_size = indices.size;
+    header.string_offset = (header.index_offset + indices.size + MESH_BAKED_ALIGNMENT - 1) / MESH_BAKED_ALIGNMENT * MESH_BAKED_ALIGNMENT;
+    header.string_size = strings.size;
+
+    FILE* file = ok ? fopen(output, "wb") : NULL;
+    if (file) {
+        static const unsigned char zeros[MESH_BAKED_ALIGNMENT] = {0};
+        fwrite(&header, sizeof(header), 1, file);
+        fwrite(meshes, sizeof(MeshBakedMesh), header.mesh_count, file);
+        fwrite(materials, sizeof(MeshBakedMaterial), header.material_count, file);
+        fwrite(zeros, 1, (size_t)(header.vertex_offset - tables), file);
+        if (vertices.size) fwrite(vertices.data, 1, vertices.size, file);
+        fwrite(zeros, 1, (size_t)(header.index_offset - header.vertex_offset - vertices.size), file);
+        if (indices.size) fwrite(indices.data, 1, indices.size, file);
+        fwrite(zeros, 1, (size_t)(header.string_offset - header.index_offset - indices.size), file);
+        fwrite(strings.data, 1, strings.size, file);
+        ok = !ferror(file);
+        ok = fclose(file) == 0 && ok;
+    } else {
+        ok = false;
+    }
+
+    if (ok) {
+        printf("%s -> %s (%u meshes, %u materials, %llu bytes)\n", input, output, header.mesh_count, header.material_count,
+               (unsigned long long)(header.string_offset + header.string_size));
+    } else {
+        fprintf(stderr, "Failed to write %s\n", output);
+    }
+
+    free(meshes);
+    free(materials);
+    free(vertices.data);
+    free(indices.data);
+    free(strings.data);
+    if (gltf) cgltf_free(gltf);
+    if (fbx) ufbx_free_scene(fbx);
+    model_free(model); // No materials were created, nothing touches the GL
+    return ok;
+}
+
+static int usage(const char* program) {
+    fprintf(stderr, "Usage: %s [-o output] input.gltf|input.fbx...\n", program);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    const char* output = NULL;
+    int first_input = argc;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (argv[i][0] == '-') {
+            return usage(argv[0]);
+        } else {
+            first_input = i;
+            break;
+        }
+    }
+
+    if (first_input >= argc || (output && argc - first_input != 1)) return usage(argv[0]);
+
+    int failed = 0;
+    for (int i = first_input; i < argc; i++) {
+        char path[1024];
+        if (!output) model_baked_path(argv[i], path, sizeof(path));
+        if (!bake(argv[i], output ? output : path)) failed++;
+    }
+    return failed ? 1 : 0;
+}
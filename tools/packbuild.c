@@ -0,0 +1,240 @@
+// Offline resource pack builder.
+// Collects files and directories into one .lpak (see io/pack.h) that the game mounts through the VFS, so a release
+// opens a single mapped file instead of hundreds of loose ones. Entry names are the normalized paths as given, build
+// from the game directory ("resources/...") so they match the paths the code loads.
+//
+// Usage: lwlaim_packbuild [-o output] [--lz4] path...
+//   -o      output pack, resources.lpak by default
+//   --lz4   LZ4-compress entries that shrink by at least an eighth. Images, audio streams and baked containers are
+//           always stored, they are either compressed already or meant to be used straight from the mapping.
+
+#include <io/pack.h>
+#include <io/vfs.h>
+#include <io/lz4.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+	#include <win_dirent.h>
+#else
+	#include <dirent.h>
+#endif
+
+typedef struct {
+    char* name;           // Normalized path
+    uint64_t hash;
+    unsigned char* data;  // Stored bytes (compressed or not)
+    size_t size;
+    size_t raw_size;
+    uint32_t compression;
+} BuildEntry;
+
+static BuildEntry* entries = NULL;
+static uint32_t entry_count = 0;
+static uint32_t entry_capacity = 0;
+static bool compress_entries = false;
+
+static bool is_directory(const char* path) {
+    struct stat info;
+    return stat(path, &info) == 0 && S_ISDIR(info.st_mode);
+}
+
+static bool has_extension(const char* name, const char* const* extensions) {
+    const char* dot = strrchr(name, '.');
+    if (!dot) return false;
+    for (; *extensions; extensions++) {
+        if (strcmp(dot, *extensions) == 0) return true;
+    }
+    return false;
+}
+
+static const char* const stored_extensions[] = { ".png", ".jpg", ".jpeg", ".ogg", ".mp3", ".wav", ".ltex", ".lmesh", NULL };
+static const char* const skipped_extensions[] = { ".lpak", NULL };
+
+static bool add_file(const char* path) {
+    char name[1024];
+    vfs_normalize_path(path, name, sizeof(name));
+    if (has_extension(name, skipped_extensions)) return true;
+
+    for (uint32_t i = 0; i < entry_count; i++) {
+        if (strcmp(entries[i].name, name) == 0) return true; // Given twice
+    }
+
+    size_t size;
+    unsigned char* data = vfs_read(path, &size);
+    if (!data) {
+        fprintf(stderr, "Failed to read %s\n", path);
+        return false;
+    }
+
+    if (entry_count == entry_capacity) {
+        uint32_t capacity = entry_capacity ? entry_capacity * 2 : 256;
+        BuildEntry* grown = realloc(entries, sizeof(BuildEntry) * capacity);
+        if (!grown) {
+            free(data);
+            return false;
+        }
+        entries = grown;
+        entry_capacity = capacity;
+    }
+
+    BuildEntry* entry = &entries[entry_count++];
+    *entry = (BuildEntry){ strdup(name), pack_hash_path(name), data, size, size, PACK_STORED };
+
+    // Keep the compressed block only when it is clearly worth the decompression
+    if (compress_entries && size > 0 && !has_extension(name, stored_extensions)) {
+        size_t capacity = lz4_compress_bound(size);
+        unsigned char* compressed = malloc(capacity);
+        size_t compressed_size = compressed ? lz4_compress(data, size, compressed, capacity) : 0;
+        if (compressed_size && compressed_size <= size - size / 8) {
+            free(entry->data);
+            entry->data = compressed;
+            entry->size = compressed_size;
+            entry->compression = PACK_LZ4;
+        } else {
+            free(compressed);
+        }
+    }
+    return entry->name != NULL;
+}
+
+static bool add_path(const char* path) {
+    if (!is_directory(path)) return add_file(path);
+
+    DIR* dir = opendir(path);
+    if (!dir) {
+        fprintf(stderr, "Failed to open directory %s\n", path);
+        return false;
+    }
+
+    bool ok = true;
+    struct dirent* item;
+    while ((item = readdir(dir)) != NULL) {
+        if (strcmp(item->d_name, ".") == 0 || strcmp(item->d_name, "..") == 0) continue;
+
+        char child[1024];
+        snprintf(child, sizeof(child), "%s/%s", path, item->d_name);
+        ok = add_path(child) && ok;
+    }
+    closedir(dir);
+    return ok;
+}
+
+static int compare_entries(const void* a, const void* b) {
+    const BuildEntry* left = (const BuildEntry*)a;
+    const BuildEntry* right = (const BuildEntry*)b;
+    if (left->hash != right->hash) return left->hash < right->hash ? -1 : 1;
+    return strcmp(left->name, right->name);
+}
+
+static uint64_t align(uint64_t offset) {
+    return (offset + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT;
+}
+
+static bool write_padding(FILE* file, uint64_t from, uint64_t to) {
+    static const unsigned char zeros[PACK_ALIGNMENT] = {0};
+    return fwrite(zeros, 1, (size_t)(to - from), file) == to - from;
+}
+
+static bool write_pack(const char* output) {
+    // Sorted by hash, the runtime binary searches the index
+    qsort(entries, entry_count, sizeof(BuildEntry), compare_entries);
+
+    PackHeader header = {
+        .magic = PACK_MAGIC,
+        .version = PACK_VERSION,
+        .entry_count = entry_count,
+        .reserved = 0
+    };
+    PackEntry* index = calloc(entry_count ? entry_count : 1, sizeof(PackEntry));
+    if (!index) return false;
+
+    // Name table (offset 0 is the empty string), then the entry data
+    header.names_offset = sizeof(PackHeader) + (uint64_t)entry_count * sizeof(PackEntry);
+    header.names_size = 1;
+    for (uint32_t i = 0; i < entry_count; i++) {
+        index[i].name = (uint32_t)header.names_size;
+        header.names_size += strlen(entries[i].name) + 1;
+    }
+
+    uint64_t offset = align(header.names_offset + header.names_size);
+    uint64_t raw_total = 0, stored_total = 0;
+    for (uint32_t i = 0; i < entry_count; i++) {
+        index[i].hash = entries[i].hash;
+        index[i].compression = entries[i].compression;
+        index[i].offset = offset;
+        index[i].size = entries[i].size;
+        index[i].raw_size = entries[i].raw_size;
+        offset = align(offset + entries[i].size);
+        raw_total += entries[i].raw_size;
+        stored_total += entries[i].size;
+    }
+
+    FILE* file = fopen(output, "wb");
+    if (!file) {
+        fprintf(stderr, "Failed to create %s\n", output);
+        free(index);
+        return false;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && (entry_count == 0 || fwrite(index, sizeof(PackEntry), entry_count, file) == entry_count);
+    ok = ok && fputc('\0', file) != EOF;
+    for (uint32_t i = 0; ok && i < entry_count; i++) ok = fwrite(entries[i].name, 1, strlen(entries[i].name) + 1, file) > 0;
+
+    uint64_t position = header.names_offset + header.names_size;
+    for (uint32_t i = 0; ok && i < entry_count; i++) {
+        ok = write_padding(file, position, index[i].offset) &&
+             (entries[i].size == 0 || fwrite(entries[i].data, 1, entries[i].size, file) == entries[i].size);
+        position = index[i].offset + entries[i].size;
+    }
+    ok = fclose(file) == 0 && ok;
+
+    if (ok) {
+        printf("%s: %u files, %.2f MiB (%.2f MiB before compression)\n", output, entry_count,
+               stored_total / (1024.0 * 1024.0), raw_total / (1024.0 * 1024.0));
+    } else {
+        fprintf(stderr, "Failed to write %s\n", output);
+    }
+    free(index);
+    return ok;
+}
+
+static int usage(const char* program) {
+    fprintf(stderr, "Usage: %s [-o output] [--lz4] path...\n", program);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    const char* output = "resources.lpak";
+    int first_input = argc;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (strcmp(argv[i], "--lz4") == 0) {
+            compress_entries = true;
+        } else if (argv[i][0] == '-') {
+            return usage(argv[0]);
+        } else {
+            first_input = i;
+            break;
+        }
+    }
+
+    if (first_input >= argc) return usage(argv[0]);
+
+    bool ok = true;
+    for (int i = first_input; i < argc; i++) ok = add_path(argv[i]) && ok;
+    ok = ok && write_pack(output);
+
+    for (uint32_t i = 0; i < entry_count; i++) {
+        free(entries[i].name);
+        free(entries[i].data);
+    }
+    free(entries);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,383 @@
+// Offline texture baker.
+// Decodes PNG/JPG/TGA/BMP images once and writes .ltex containers (see pipeline/texture_baked.h) with a
+// precomputed mip chain, raw or block-compressed, so the game only has to map and upload them.
+//
+// Usage: lwlaim_texbake [--format raw|bc1|bc3|auto] [--no-mips] [--flip] [-o output] input...
+//   --format   raw keeps RGB8/RGBA8 (default), bc1/bc3 compress, auto picks BC1 for opaque images and BC3 otherwise
+//   --no-mips  store the base level only (UI images that are never minified)
+//   --flip     flip rows first, for images the game loads flipped (assets_load_image(path, true, ...))
+//   -o         output path (single input only), by default the input with its extension replaced by .ltex
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <pipeline/texture_baked.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    BAKE_RAW,
+    BAKE_BC1,
+    BAKE_BC3,
+    BAKE_AUTO
+} BakeFormat;
+
+typedef struct {
+    BakeFormat format;
+    bool mips;
+    bool flip;
+} BakeOptions;
+
+// ----------------------------------------------------------------------------
+// Mip chain
+// ----------------------------------------------------------------------------
+
+// 2x2 box filter, odd edges repeat the last row/column
+static unsigned char* downsample(const unsigned char* src, int width, int height, int channels, int* out_width, int* out_height) {
+    int w = width > 1 ? width / 2 : 1;
+    int h = height > 1 ? height / 2 : 1;
+    unsigned char* dst = malloc((size_t)w * h * channels);
+    if (!dst) return NULL;
+
+    for (int y = 0; y < h; y++) {
+        int y0 = y * 2 < height ? y * 2 : height - 1;
+        int y1 = y * 2 + 1 < height ? y * 2 + 1 : height - 1;
+        for (int x = 0; x < w; x++) {
+            int x0 = x * 2 < width ? x * 2 : width - 1;
+            int x1 = x * 2 + 1 < width ? x * 2 + 1 : width - 1;
+            for (int c = 0; c < channels; c++) {
+                int sum = src[((size_t)y0 * width + x0) * channels + c] + src[((size_t)y0 * width + x1) * channels + c] +
+                          src[((size_t)y1 * width + x0) * channels + c] + src[((size_t)y1 * width + x1) * channels + c];
+                dst[((size_t)y * w + x) * channels + c] = (unsigned char)((sum + 2) / 4);
+            }
+        }
+    }
+
+    *out_width = w;
+    *out_height = h;
+    return dst;
+}
+
+// ----------------------------------------------------------------------------
+// Block compression (BC1 color, BC3 alpha)
+// ----------------------------------------------------------------------------
+
+static void fetch_block(const unsigned char* rgba, int width, int height, int bx, int by, unsigned char block[16][4]) {
+    for (int y = 0; y < 4; y++) {
+        int sy = by * 4 + y < height ? by * 4 + y : height - 1;
+        for (int x = 0; x < 4; x++) {
+            int sx = bx * 4 + x < width ? bx * 4 + x : width - 1;
+            memcpy(block[y * 4 + x], rgba + ((size_t)sy * width + sx) * 4, 4);
+        }
+    }
+}
+
+static uint16_t pack_565(const float color[3]) {
+    int r = (int)(color[0] * 31.0f / 255.0f + 0.5f);
+    int g = (int)(color[1] * 63.0f / 255.0f + 0.5f);
+    int b = (int)(color[2] * 31.0f / 255.0f + 0.5f);
+    r = r < 0 ? 0 : r > 31 ? 31 : r;
+    g = g < 0 ? 0 : g > 63 ? 63 : g;
+    b = b < 0 ? 0 : b > 31 ? 31 : b;
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+static void unpack_565(uint16_t packed, int color[3]) {
+    int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+// Endpoints on the principal axis of the block's colors, then the nearest of the four palette entries per texel
+static void encode_color_block(unsigned char block[16][4], unsigned char out[8]) {
+    float mean[3] = {0};
+    for (int i = 0; i < 16; i++) for (int c = 0; c < 3; c++) mean[c] += block[i][c] / 16.0f;
+
+    float cov[6] = {0}; // xx xy xz yy yz zz
+    for (int i = 0; i < 16; i++) {
+        float d[3] = { block[i][0] - mean[0], block[i][1] - mean[1], block[i][2] - mean[2] };
+        cov[0] += d[0] * d[0]; cov[1] += d[0] * d[1]; cov[2] += d[0] * d[2];
+        cov[3] += d[1] * d[1]; cov[4] += d[1] * d[2]; cov[5] += d[2] * d[2];
+    }
+
+    // Power iteration
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iteration = 0; iteration < 8; iteration++) {
+        float next[3] = {
+            cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+            cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+            cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2]
+        };
+        float length = sqrtf(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+        if (length < 1e-6f) break;
+        for (int c = 0; c < 3; c++) axis[c] = next[c] / length;
+    }
+
+    float min_projection = 1e30f, max_projection = -1e30f;
+    for (int i = 0; i < 16; i++) {
+        float projection = (block[i][0] - mean[0]) * axis[0] + (block[i][1] - mean[1]) * axis[1] + (block[i][2] - mean[2]) * axis[2];
+        if (projection < min_projection) min_projection = projection;
+        if (projection > max_projection) max_projection = projection;
+    }
+
+    float high[3], low[3];
+    for (int c = 0; c < 3; c++) {
+        high[c] = mean[c] + axis[c] * max_projection;
+        low[c] = mean[c] + axis[c] * min_projection;
+    }
+
+    uint16_t c0 = pack_565(high), c1 = pack_565(low);
+    if (c0 < c1) {
+        uint16_t swap = c0;
+        c0 = c1;
+        c1 = swap;
+    }
+
+    uint32_t indices = 0;
+    if (c0 != c1) {
+        int palette[4][3];
+        unpack_565(c0, palette[0]);
+        unpack_565(c1, palette[1]);
+        for (int c = 0; c < 3; c++) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        for (int i = 0; i < 16; i++) {
+            int best = 0, best_distance = 1 << 30;
+            for (int p = 0; p < 4; p++) {
+                int dr = block[i][0] - palette[p][0], dg = block[i][1] - palette[p][1], db = block[i][2] - palette[p][2];
+                int distance = dr * dr + dg * dg + db * db;
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best = p;
+                }
+            }
+            indices |= (uint32_t)best << (i * 2);
+        }
+    }
+
+    out[0] = (unsigned char)(c0 & 0xFF); out[1] = (unsigned char)(c0 >> 8);
+    out[2] = (unsigned char)(c1 & 0xFF); out[3] = (unsigned char)(c1 >> 8);
+    for (int i = 0; i < 4; i++) out[4 + i] = (unsigned char)(indices >> (i * 8));
+}
+
+// Eight-value alpha ramp between the block's extremes
+static void encode_alpha_block(unsigned char block[16][4], unsigned char out[8]) {
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; i++) {
+        if (block[i][3] > a0) a0 = block[i][3];
+        if (block[i][3] < a1) a1 = block[i][3];
+    }
+
+    uint64_t indices = 0;
+    if (a0 != a1) {
+        int ramp[8] = { a0, a1 };
+        for (int i = 1; i < 7; i++) ramp[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+
+        for (int i = 0; i < 16; i++) {
+            int best = 0, best_distance = 1 << 30;
+            for (int p = 0; p < 8; p++) {
+                int distance = abs(block[i][3] - ramp[p]);
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best = p;
+                }
+            }
+            indices |= (uint64_t)best << (i * 3);
+        }
+    }
+
+    out[0] = (unsigned char)a0;
+    out[1] = (unsigned char)a1;
+    for (int i = 0; i < 6; i++) out[2 + i] = (unsigned char)(indices >> (i * 8));
+}
+
+static unsigned char* compress_level(const unsigned char* rgba, int width, int height, uint32_t format, size_t* size) {
+    int blocks_x = (width + 3) / 4, blocks_y = (height + 3) / 4;
+    size_t block_bytes = format == TEXTURE_BAKED_BC1 ? 8 : 16;
+    unsigned char* out = malloc((size_t)blocks_x * blocks_y * block_bytes);
+    if (!out) return NULL;
+
+    unsigned char* cursor = out;
+    for (int by = 0; by < blocks_y; by++) {
+        for (int bx = 0; bx < blocks_x; bx++) {
+            unsigned char block[16][4];
+            fetch_block(rgba, width, height, bx, by, block);
+            if (format == TEXTURE_BAKED_BC3) {
+                encode_alpha_block(block, cursor);
+                cursor += 8;
+            }
+            encode_color_block(block, cursor);
+            cursor += 8;
+        }
+    }
+
+    *size = (size_t)(cursor - out);
+    return out;
+}
+
+// ----------------------------------------------------------------------------
+// Container
+// ----------------------------------------------------------------------------
+
+static bool has_alpha(const unsigned char* rgba, int width, int height) {
+    for (size_t i = 0; i < (size_t)width * height; i++) {
+        if (rgba[i * 4 + 3] != 255) return true;
+    }
+    return false;
+}
+
+static bool bake(const char* input, const char* output, const BakeOptions* options) {
+    stbi_set_flip_vertically_on_load(options->flip);
+
+    int width, height, source_channels;
+    if (!stbi_info(input, &width, &height, &source_channels)) {
+        fprintf(stderr, "%s: %s\n", input, stbi_failure_reason());
+        return false;
+    }
+
+    // Same expansion as the runtime loader: grey becomes RGBA, block compression always starts from RGBA
+    int channels = (source_channels == 3 && options->format == BAKE_RAW) ? 3 : 4;
+    unsigned char* pixels = stbi_load(input, &width, &height, &source_channels, channels);
+    if (!pixels) {
+        fprintf(stderr, "%s: %s\n", input, stbi_failure_reason());
+        return false;
+    }
+
+    uint32_t format = channels == 3 ? TEXTURE_BAKED_RGB8 : TEXTURE_BAKED_RGBA8;
+    if (options->format == BAKE_BC1) format = TEXTURE_BAKED_BC1;
+    if (options->format == BAKE_BC3) format = TEXTURE_BAKED_BC3;
+    if (options->format == BAKE_AUTO) format = has_alpha(pixels, width, height) ? TEXTURE_BAKED_BC3 : TEXTURE_BAKED_BC1;
+
+    uint32_t level_count = 1;
+    if (options->mips) {
+        level_count = texture_baked_full_level_count((uint32_t)width, (uint32_t)height);
+        if (level_count > TEXTURE_BAKED_MAX_LEVELS) level_count = TEXTURE_BAKED_MAX_LEVELS;
+    }
+
+    TextureBakedHeader header = {
+        .magic = TEXTURE_BAKED_MAGIC,
+        .version = TEXTURE_BAKED_VERSION,
+        .format = format,
+        .flags = options->flip ? TEXTURE_BAKED_FLIPPED : 0,
+        .width = (uint32_t)width,
+        .height = (uint32_t)height,
+        .level_count = level_count
+    };
+    TextureBakedLevel levels[TEXTURE_BAKED_MAX_LEVELS];
+    unsigned char* level_pixels[TEXTURE_BAKED_MAX_LEVELS] = { pixels };
+    unsigned char* level_data[TEXTURE_BAKED_MAX_LEVELS] = {0};
+
+    bool ok = true;
+    uint64_t offset = sizeof(header) + sizeof(TextureBakedLevel) * level_count;
+    int level_width = width, level_height = height;
+
+    for (uint32_t i = 0; i < level_count && ok; i++) {
+        // Each level is filtered from the previous one's pixels
+        if (i > 0) {
+            level_pixels[i] = downsample(level_pixels[i - 1], level_width, level_height, channels, &level_width, &level_height);
+            if (!level_pixels[i]) {
+                ok = false;
+                break;
+            }
+        }
+
+        size_t size = (size_t)level_width * level_height * channels;
+        level_data[i] = texture_baked_compressed(format) ? compress_level(level_pixels[i], level_width, level_height, format, &size) : level_pixels[i];
+        ok = level_data[i] != NULL;
+
+        offset = (offset + TEXTURE_BAKED_ALIGNMENT - 1) & ~(uint64_t)(TEXTURE_BAKED_ALIGNMENT - 1);
+        levels[i].offset = offset;
+        levels[i].size = size;
+        offset += size;
+    }
+
+    FILE* file = ok ? fopen(output, "wb") : NULL;
+    if (ok && !file) {
+        fprintf(stderr, "%s: could not open for writing\n", output);
+        ok = false;
+    }
+
+    if (ok) {
+        static const unsigned char padding[TEXTURE_BAKED_ALIGNMENT] = {0};
+        uint64_t written = sizeof(header) + sizeof(TextureBakedLevel) * level_count;
+        ok = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(levels, sizeof(TextureBakedLevel), level_count, file) == level_count;
+
+        for (uint32_t i = 0; i < level_count && ok; i++) {
+            size_t pad = (size_t)(levels[i].offset - written);
+            ok = (pad == 0 || fwrite(padding, 1, pad, file) == pad) && fwrite(level_data[i], 1, levels[i].size, file) == levels[i].size;
+            written = levels[i].offset + levels[i].size;
+        }
+
+        if (fclose(file) != 0) ok = false;
+        if (!ok) fprintf(stderr, "%s: write failed\n", output);
+    }
+
+    if (ok) {
+        static const char* format_names[] = { "rgb8", "rgba8", "bc1", "bc3", "bc7" };
+        printf("%s -> %s (%dx%d %s, %u levels, %llu bytes)\n", input, output, width, height, format_names[format], level_count,
+               (unsigned long long)offset);
+    }
+
+    for (uint32_t i = 0; i < level_count; i++) {
+        if (level_data[i] != level_pixels[i]) free(level_data[i]);
+        if (i > 0) free(level_pixels[i]);
+    }
+    stbi_image_free(pixels);
+    return ok;
+}
+
+static void baked_output_path(const char* input, char* dest, size_t dest_size) {
+    const char* slash = strrchr(input, '/');
+    const char* dot = strrchr(input, '.');
+    int stem = (dot && (!slash || dot > slash)) ? (int)(dot - input) : (int)strlen(input);
+    snprintf(dest, dest_size, "%.*s%s", stem, input, TEXTURE_BAKED_EXTENSION);
+}
+
+static int usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--format raw|bc1|bc3|auto] [--no-mips] [--flip] [-o output] input...\n", program);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    BakeOptions options = { BAKE_RAW, true, false };
+    const char* output = NULL;
+    int first_input = argc;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            if (strcmp(name, "raw") == 0) options.format = BAKE_RAW;
+            else if (strcmp(name, "bc1") == 0) options.format = BAKE_BC1;
+            else if (strcmp(name, "bc3") == 0) options.format = BAKE_BC3;
+            else if (strcmp(name, "auto") == 0) options.format = BAKE_AUTO;
+            else return usage(argv[0]);
+        } else if (strcmp(argv[i], "--no-mips") == 0) {
+            options.mips = false;
+        } else if (strcmp(argv[i], "--flip") == 0) {
+            options.flip = true;
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (argv[i][0] == '-') {
+            return usage(argv[0]);
+        } else {
+            first_input = i;
+            break;
+        }
+    }
+
+    if (first_input >= argc || (output && argc - first_input != 1)) return usage(argv[0]);
+
+    int failed = 0;
+    for (int i = first_input; i < argc; i++) {
+        char path[1024];
+        if (!output) baked_output_path(argv[i], path, sizeof(path));
+        if (!bake(argv[i], output ? output : path, &options)) failed++;
+    }
+    return failed ? 1 : 0;
+}